@@ -0,0 +1,837 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * avr_cycles.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		time the ATmega88A Timer0 and ADC ISRs too.
+ * revision: 10/17/2026	0.03	ndp		time TIMER2_COMPB (dev_led_bam) and the TWI interrupt latency.
+ * revision: 10/17/2026	0.04	ndp		stop with a message when simavr lacks a vector or the TWI.
+ *
+ * Cycle counts for the six Slave projects, running the real firmware in simavr with an I2C
+ * Master attached to the TWI (ATmega88A) or USI (ATtiny85).
+ *
+ *   avr_cycles [-n ROUNDS] [-k HZ] [-o FILE] NAME:ELF:LOOP:RECV:SEND ...
+ *   NAME		A1B1 A1B2 A1B3 A1C1 A2B1 A2B2
+ *   ELF		firmware built for the project MCU (see Makefile)
+ *   LOOP		flash byte address of the function the main loop calls once per pass
+ *   RECV		flash byte address of twiReceiveByte() / usiTwiReceiveByte()
+ *   SEND		flash byte address of twiTransmitByte() / usiTwiTransmitByte()
+ *   -n ROUNDS	messages per project (default 200)
+ *   -k HZ		I2C clock. Sets the time between bus events (default 100000)
+ *   -o FILE	write the JSON report to FILE instead of stdout
+ *
+ * Each round is the project's normal message: a write the main loop takes, then for the
+ * READY Slaves a poll for READY and the read of the reply, or for A1B2 and A2B2 a read.
+ *
+ * Results. A result a project can not give is null.
+ *   isr_cycles		per TWI status code (TWSR at entry) or per USI phase: count min avg max.
+ *					From the vector jump to the RETI. On the ATmega88A also t0_compa (1ms
+ *					system tic), t2_compb (dev_led_bam slot) and adc, when the project uses
+ *					them. They are not in the rx results.
+ *					twi_latency is the time from the TWI interrupt flag to its vector jump.
+ *					Its max less its min is what the other ISRs add to the TWI response.
+ *   rx_isr_cycles_per_byte		ISR cycles for each data byte written to the Slave.
+ *   rx_main_cycles_per_byte	cycles of the main loop passes that took a byte.
+ *   rx_cycles_per_byte			the two together.
+ *   loop_iters_per_msg			main loop passes from START until the Slave took the last byte.
+ *   ready_polls_per_msg		reads of READY = 0 before the reply was ready.
+ *   refill_loop_iters			main loop passes from a read to the refill of the TX buffer.
+ *
+ * simavr has no USI model, so the USI Start and Overflow interrupts, the USISR flags and the
+ * shift register are done here one byte (or ACK bit) at a time. SCL and SDA are driven on the
+ * port pins so the Start ISR sees a real START.
+ */ 
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "sim_irq.h"
+#include "sim_interrupts.h"
+#include "avr_twi.h"
+#include "avr_ioport.h"
+
+#define CYC_ROUNDS		200
+#define CYC_CLOCK		100000
+#define CYC_CPU_HZ		8000000
+#define CYC_ADRS		0x40			// SLAVE_ADRS of all of the projects.
+#define CYC_STRETCH_MAX	20000			// cycles an event waits for its ISR.
+#define CYC_TAKE_MAX	2000000			// cycles the main loop has to take a message.
+#define CYC_BOOT_MS		500				// time for A1C1 to finish its staged start up.
+#define CYC_POLL_MAX	200
+#define CYC_STATS_MAX	24
+#define CYC_BUF_MAX		32
+
+/* ATmega88A */
+#define M88_TIMER2_COMPB_VECT	8
+#define M88_TIMER0_COMPA_VECT	14
+#define M88_ADC_VECT	21
+#define M88_TWI_VECT	24
+#define M88_TWSR		0xB9
+
+/* ATtiny85. Data space addresses. */
+#define T85_USI_START_VECT	13
+#define T85_USI_OVF_VECT	14
+#define T85_USICR		0x2D
+#define T85_USISR		0x2E
+#define T85_USIDR		0x2F
+#define T85_SDA			0				// PB0
+#define T85_SCL			2				// PB2
+
+#define USISIF			7
+#define USIOIF			6
+#define USISIE			7
+#define USIOIE			6
+
+typedef enum { BUS_TWI, BUS_USI } CYC_BUS;
+
+typedef struct {
+	const char*	name;
+	const char*	mcu;					// simavr core
+	CYC_BUS		bus;
+	bool		ready;					// first read byte is READY (TWI_REPLY_STATUS)
+	bool		staged;					// busy until its devices are set up (INIT_STAGED)
+	uint8_t		wr[4];
+	uint8_t		wrLen;
+	uint8_t		rdLen;
+} CYC_PROJECT;
+
+static const CYC_PROJECT projects[] =
+{
+	{ "A1B1", "atmega88", BUS_TWI, false, false, { 0x01 }, 1, 0 },
+	{ "A1B2", "atmega88", BUS_TWI, false, false, { 0 }, 0, 1 },
+	{ "A1B3", "atmega88", BUS_TWI, true,  false, { 0x55 }, 1, 2 },
+	{ "A1C1", "atmega88", BUS_TWI, true,  true,  { 0xF0, 0x60, 0x07 }, 3, 3 },		// GPIO READ
+	{ "A2B1", "attiny85", BUS_USI, false, false, { 0x01 }, 1, 0 },
+	{ "A2B2", "attiny85", BUS_USI, false, false, { 0 }, 0, 1 },
+};
+
+#define PROJECT_COUNT	( sizeof(projects) / sizeof(projects[0]) )
+
+typedef struct {
+	char		name[16];
+	uint32_t	count;
+	uint64_t	sum;
+	uint32_t	min;
+	uint32_t	max;
+} CYC_STAT;
+
+typedef struct {
+	const CYC_PROJECT*	p;
+	uint32_t	rounds;
+	CYC_STAT	stats[CYC_STATS_MAX];
+	int			statCount;
+	double		rxIsr;						// < 0 is n/a for all of these.
+	double		rxMain;
+	double		loopIters;
+	double		readyPolls;
+	double		refillIters;
+	uint32_t	errors;
+} CYC_RESULT;
+
+/* *** Simulation state *** */
+static avr_t*			avr;
+static const CYC_PROJECT* proj;
+static CYC_RESULT*		res;
+static uint32_t			byteCycles;			// one byte and its ACK on the bus.
+
+static avr_flashaddr_t	loopAdrs;
+static avr_flashaddr_t	recvAdrs;
+static avr_flashaddr_t	sendAdrs;
+static uint32_t			loopHits;
+static uint32_t			recvHits;
+static uint32_t			sendHits;
+static uint64_t			loopCycle;			// cycle of the last loop pass start.
+static bool				tookByte;			// this loop pass called RECV.
+static uint64_t			mainCycles;			// cycles of passes that took a byte.
+
+static uint64_t			isrStart;
+static char				isrKey[16];
+static uint32_t			isrDone;
+static uint64_t			isrCycles;			// all watched ISRs.
+static const char*		usiPhase = "usi_start";
+static uint64_t			otherStart;			// the other ISRs. They do not nest.
+static uint64_t			twiRaised;			// cycle the TWI interrupt flag was set.
+static bool				twiPending;
+
+static avr_irq_t*		twiIn;
+static uint8_t			twiAck;
+static uint8_t			twiData;
+
+static avr_irq_t*		sdaPin;
+static avr_irq_t*		sclPin;
+
+static avr_int_vector_t	usiStart = {
+	.vector = T85_USI_START_VECT,
+	.enable = AVR_IO_REGBIT( T85_USICR, USISIE ),
+	.raised = AVR_IO_REGBIT( T85_USISR, USISIF ),
+};
+static avr_int_vector_t	usiOvf = {
+	.vector = T85_USI_OVF_VECT,
+	.enable = AVR_IO_REGBIT( T85_USICR, USIOIE ),
+	.raised = AVR_IO_REGBIT( T85_USISR, USIOIF ),
+};
+
+/* *** Statistics *** */
+static void stat_add( const char* name, uint32_t cycles )
+{
+	CYC_STAT* s;
+	int i;
+
+	for( i=0; i<res->statCount; ++i )
+	{
+		if( strcmp( res->stats[i].name, name ) == 0 )
+			break;
+	}
+	if( i == res->statCount )
+	{
+		if( i == CYC_STATS_MAX )
+			return;
+		s = &res->stats[res->statCount++];
+		snprintf( s->name, sizeof(s->name), "%s", name );
+		s->min = UINT32_MAX;
+	}
+	s = &res->stats[i];
+	++s->count;
+	s->sum += cycles;
+	if( cycles < s->min ) s->min = cycles;
+	if( cycles > s->max ) s->max = cycles;
+}
+
+/*
+ * Vector jump (1) and RETI (0) of a watched ISR.
+ */
+static void isr_running( avr_irq_t* irq, uint32_t value, void* param )
+{
+	(void)irq;
+	(void)param;
+
+	if( value )
+	{
+		isrStart = avr->cycle;
+		if( proj->bus == BUS_TWI && twiPending )
+		{
+			stat_add( "twi_latency", (uint32_t)(avr->cycle - twiRaised) );
+			twiPending = false;
+		}
+		if( proj->bus == BUS_TWI )
+			snprintf( isrKey, sizeof(isrKey), "twi_%02X", avr->data[M88_TWSR] & 0xF8 );
+		else
+			snprintf( isrKey, sizeof(isrKey), "%s", usiPhase );
+	}
+	else
+	{
+		stat_add( isrKey, (uint32_t)(avr->cycle - isrStart) );
+		isrCycles += avr->cycle - isrStart;
+		++isrDone;
+	}
+}
+
+/*
+ * TWI interrupt flag set (1) or cleared (0). Only the set is used.
+ */
+static void isr_pending( avr_irq_t* irq, uint32_t value, void* param )
+{
+	(void)irq;
+	(void)param;
+
+	if( value && !twiPending )
+	{
+		twiRaised = avr->cycle;
+		twiPending = true;
+	}
+}
+
+/*
+ * Vector jump (1) and RETI (0) of an ISR that is timed but not part of the rx results.
+ * param is its name.
+ */
+static void isr_other( avr_irq_t* irq, uint32_t value, void* param )
+{
+	(void)irq;
+
+	if( value )
+		otherStart = avr->cycle;
+	else
+		stat_add( (const char*)param, (uint32_t)(avr->cycle - otherStart) );
+}
+
+/*
+ * Run one instruction and count the main loop probes.
+ */
+static void step( void )
+{
+	int state = avr_run( avr );
+
+	if( state == cpu_Done || state == cpu_Crashed )
+	{
+		fprintf( stderr, "%s: simulation stopped (%d)\n", proj->name, state );
+		exit( 1 );
+	}
+
+	if( avr->pc == loopAdrs )
+	{
+		if( tookByte )
+		{
+			mainCycles += avr->cycle - loopCycle;
+			tookByte = false;
+		}
+		loopCycle = avr->cycle;
+		++loopHits;
+	}
+	else if( avr->pc == recvAdrs )
+	{
+		tookByte = true;
+		++recvHits;
+	}
+	else if( avr->pc == sendAdrs )
+	{
+		++sendHits;
+	}
+}
+
+static void run_until( uint64_t cycle )
+{
+	while( avr->cycle < cycle )
+		step();
+}
+
+/*
+ * Start a bus event, let its ISR run and use up the rest of the byte time.
+ * The Slave holds SCL low (clock stretch) until its ISR is done.
+ */
+static void bus_event( void (*start)( uint32_t ), uint32_t arg )
+{
+	uint64_t end = avr->cycle + byteCycles;
+	uint64_t limit = avr->cycle + CYC_STRETCH_MAX;
+	uint32_t done = isrDone;
+
+	start( arg );
+	while( isrDone == done && avr->cycle < limit )
+		step();
+	run_until( end );
+}
+
+/* *** TWI Master. simavr avr_twi messages. *** */
+static void twi_output( avr_irq_t* irq, uint32_t value, void* param )
+{
+	avr_twi_msg_irq_t msg;
+
+	(void)irq;
+	(void)param;
+	msg.u.v = value;
+	if( msg.u.twi.msg & TWI_COND_ACK )
+		twiAck = msg.u.twi.data;
+	if( msg.u.twi.msg & TWI_COND_READ )
+		twiData = msg.u.twi.data;
+}
+
+static void twi_raise( uint32_t msg )
+{
+	avr_raise_irq( twiIn, msg );
+}
+
+static bool twi_start( uint8_t sla )
+{
+	twiAck = 0;
+	bus_event( twi_raise, avr_twi_irq_msg( TWI_COND_START | TWI_COND_ADDR, sla, 0 ) );
+	return twiAck != 0;
+}
+
+static void twi_stop( uint8_t sla )
+{
+	bus_event( twi_raise, avr_twi_irq_msg( TWI_COND_STOP, sla, 0 ) );
+}
+
+static bool twi_write( const uint8_t* data, uint8_t len, uint64_t* dataIsr )
+{
+	uint8_t sla = CYC_ADRS << 1;
+	uint64_t before;
+	uint8_t i;
+
+	if( !twi_start( sla ) )
+	{
+		twi_stop( sla );
+		return false;
+	}
+	for( i=0; i<len; ++i )
+	{
+		before = isrCycles;
+		bus_event( twi_raise, avr_twi_irq_msg( TWI_COND_WRITE, sla, data[i] ) );
+		*dataIsr += isrCycles - before;
+	}
+	twi_stop( sla );
+	return true;
+}
+
+static bool twi_read( uint8_t* data, uint8_t len )
+{
+	uint8_t sla = (CYC_ADRS << 1) | 1;
+	uint8_t i;
+
+	if( !twi_start( sla ) )
+	{
+		twi_stop( sla );
+		return false;
+	}
+	for( i=0; i<len; ++i )
+	{
+		// The Master ACKs all but the last byte.
+		bus_event( twi_raise, avr_twi_irq_msg( TWI_COND_READ | ( (i + 1 < len) ? TWI_COND_ACK : 0 ), sla, 0 ) );
+		data[i] = twiData;
+	}
+	twi_stop( sla );
+	return true;
+}
+
+/* *** USI Master. The USI is done here. *** */
+
+/*
+ * USISR. A 1 written to a flag clears it. The counter bits are kept.
+ */
+static void usi_writeSr( avr_t* a, avr_io_addr_t addr, uint8_t v, void* param )
+{
+	(void)param;
+
+	a->data[addr] = ( a->data[addr] & 0xE0 & ~(v & 0xE0) ) | ( v & 0x1F );
+	if( v & (1<<USISIF) )
+		avr_clear_interrupt( a, &usiStart );
+	if( v & (1<<USIOIF) )
+		avr_clear_interrupt( a, &usiOvf );
+}
+
+static void usi_raise( uint32_t start )
+{
+	avr_raise_interrupt( avr, start ? &usiStart : &usiOvf );
+}
+
+static bool usi_listening( void )
+{
+	return ( avr->data[T85_USICR] & (1<<USIOIE) ) != 0;
+}
+
+/*
+ * Shift a byte (or an ACK bit) in and give the Overflow interrupt.
+ */
+static void usi_shift( const char* phase, uint8_t data )
+{
+	usiPhase = phase;
+	avr->data[T85_USIDR] = data;
+	bus_event( usi_raise, 0 );
+}
+
+static bool usi_start( uint8_t sla )
+{
+	// START: SDA falls while SCL is high, then SCL is held low.
+	avr_raise_irq( sdaPin, 0 );
+	avr_raise_irq( sclPin, 0 );
+	usiPhase = "usi_start";
+	bus_event( usi_raise, 1 );
+
+	usi_shift( "usi_adr", sla );
+	if( !usi_listening() )
+		return false;							// NACK. Back to waiting for a START.
+	usi_shift( "usi_adr_ack", 0 );
+	return true;
+}
+
+static void usi_stop( void )
+{
+	avr_raise_irq( sclPin, 1 );
+	avr_raise_irq( sdaPin, 1 );
+	run_until( avr->cycle + byteCycles / 9 );
+}
+
+static bool usi_write( const uint8_t* data, uint8_t len, uint64_t* dataIsr )
+{
+	uint64_t before;
+	uint8_t i;
+
+	if( !usi_start( CYC_ADRS << 1 ) )
+	{
+		usi_stop();
+		return false;
+	}
+	for( i=0; i<len; ++i )
+	{
+		before = isrCycles;
+		usi_shift( "usi_rx_data", data[i] );
+		usi_shift( "usi_rx_ack", 0 );
+		*dataIsr += isrCycles - before;
+	}
+	usi_stop();
+	return true;
+}
+
+static bool usi_read( uint8_t* data, uint8_t len )
+{
+	uint8_t i;
+
+	if( !usi_start( (CYC_ADRS << 1) | 1 ) )
+	{
+		usi_stop();
+		return false;
+	}
+	for( i=0; i<len; ++i )
+	{
+		if( !usi_listening() )
+		{
+			// The Slave let go of the bus. SDA floats high.
+			data[i] = 0xFF;
+			run_until( avr->cycle + byteCycles );
+			continue;
+		}
+		data[i] = avr->data[T85_USIDR];
+		usi_shift( "usi_tx_data", data[i] );
+		usi_shift( "usi_tx_ack", (i + 1 < len) ? 0x00 : 0xFF );	// Master NACKs the last byte.
+	}
+	usi_stop();
+	return true;
+}
+
+/* *** Master *** */
+static bool master_write( const uint8_t* data, uint8_t len, uint64_t* dataIsr )
+{
+	return ( proj->bus == BUS_TWI ) ? twi_write( data, len, dataIsr ) : usi_write( data, len, dataIsr );
+}
+
+static bool master_read( uint8_t* data, uint8_t len )
+{
+	return ( proj->bus == BUS_TWI ) ? twi_read( data, len ) : usi_read( data, len );
+}
+
+/*
+ * Run until the main loop has called RECV count more times.
+ */
+static bool wait_taken( uint32_t since, uint32_t count )
+{
+	uint64_t limit = avr->cycle + CYC_TAKE_MAX;
+
+	while( recvHits - since < count && avr->cycle < limit )
+		step();
+	return recvHits - since >= count;
+}
+
+/*
+ * A1C1 returns INIT_BUSY_BYTE past the READY byte until its devices are set up.
+ */
+static void wait_boot( void )
+{
+	uint8_t buf[2];
+	int ms;
+
+	for( ms=0; ms<CYC_BOOT_MS; ++ms )
+	{
+		if( master_read( buf, 2 ) && buf[1] != 0xBB )
+			return;
+		run_until( avr->cycle + CYC_CPU_HZ / 1000 );
+	}
+	fprintf( stderr, "%s: still starting after %d ms\n", proj->name, CYC_BOOT_MS );
+}
+
+static void run_rounds( void )
+{
+	uint8_t buf[CYC_BUF_MAX + 1];
+	uint64_t rxIsr = 0;
+	uint64_t iters = 0;
+	uint64_t polls = 0;
+	uint64_t refill = 0;
+	uint32_t rxBytes = 0;
+	uint32_t refills = 0;
+	uint32_t loopStart;
+	uint32_t recvStart;
+	uint32_t sendStart;
+	uint32_t r;
+	uint32_t i;
+
+	mainCycles = 0;
+	for( r=0; r<res->rounds; ++r )
+	{
+		if( proj->wrLen )
+		{
+			loopStart = loopHits;
+			recvStart = recvHits;
+			if( !master_write( proj->wr, proj->wrLen, &rxIsr ) || !wait_taken( recvStart, proj->wrLen ) )
+			{
+				++res->errors;
+				continue;
+			}
+			// finish the pass that took the last byte.
+			while( tookByte )
+				step();
+			iters += loopHits - loopStart;
+			rxBytes += proj->wrLen;
+		}
+
+		if( proj->rdLen && proj->ready )
+		{
+			for( i=0; i<CYC_POLL_MAX; ++i )
+			{
+				if( master_read( buf, 1 ) && buf[0] >= proj->rdLen )
+					break;
+				++polls;
+			}
+			if( i == CYC_POLL_MAX || !master_read( buf, proj->rdLen + 1 ) )
+				++res->errors;
+		}
+		else if( proj->rdLen )
+		{
+			if( !master_read( buf, proj->rdLen ) )
+			{
+				++res->errors;
+				continue;
+			}
+			loopStart = loopHits;
+			sendStart = sendHits;
+			while( sendHits == sendStart && loopHits - loopStart < CYC_TAKE_MAX / 100 )
+				step();
+			refill += loopHits - loopStart;
+			++refills;
+		}
+	}
+
+	res->rxIsr = rxBytes ? (double)rxIsr / rxBytes : -1;
+	res->rxMain = rxBytes ? (double)mainCycles / rxBytes : -1;
+	res->loopIters = proj->wrLen ? (double)iters / res->rounds : -1;
+	res->readyPolls = ( proj->rdLen && proj->ready ) ? (double)polls / res->rounds : -1;
+	res->refillIters = refills ? (double)refill / refills : -1;
+}
+
+/*
+ * Notify on one of a vector's IRQs (AVR_INT_IRQ_PENDING or AVR_INT_IRQ_RUNNING).
+ * false if this simavr core does not have the vector.
+ */
+static bool watch( uint8_t vector, uint8_t which, avr_irq_notify_t notify, void* param )
+{
+	avr_irq_t* irq = avr_get_interrupt_irq( avr, vector );
+
+	if( !irq )
+	{
+		fprintf( stderr, "%s: simavr %s has no vector %u\n", proj->name, proj->mcu, vector );
+		return false;
+	}
+	avr_irq_register_notify( irq + which, notify, param );
+	return true;
+}
+
+static void run_project( const CYC_PROJECT* p, const char* elf, CYC_RESULT* r )
+{
+	elf_firmware_t fw;
+	avr_irq_t* irq;
+
+	memset( &fw, 0, sizeof(fw) );
+	if( elf_read_firmware( elf, &fw ) != 0 )
+	{
+		fprintf( stderr, "%s: can not read %s\n", p->name, elf );
+		exit( 1 );
+	}
+
+	avr = avr_make_mcu_by_name( p->mcu );
+	if( !avr )
+	{
+		fprintf( stderr, "%s: simavr has no %s core\n", p->name, p->mcu );
+		exit( 1 );
+	}
+	avr_init( avr );
+	avr->frequency = CYC_CPU_HZ;
+	avr_load_firmware( avr, &fw );
+
+	proj = p;
+	res = r;
+	loopHits = recvHits = sendHits = 0;
+	isrDone = 0;
+	isrCycles = 0;
+	tookByte = false;
+	twiPending = false;
+
+	if( p->bus == BUS_TWI )
+	{
+		twiIn = avr_io_getirq( avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT );
+		irq = avr_io_getirq( avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT );
+		if( !twiIn || !irq || !watch( M88_TWI_VECT, AVR_INT_IRQ_RUNNING, isr_running, NULL ) )
+		{
+			fprintf( stderr, "%s: simavr %s has no TWI\n", p->name, p->mcu );
+			exit( 1 );
+		}
+		avr_irq_register_notify( irq, twi_output, NULL );
+		watch( M88_TWI_VECT, AVR_INT_IRQ_PENDING, isr_pending, NULL );
+		// The others are only timed. A missing one is left out of the report.
+		watch( M88_TIMER0_COMPA_VECT, AVR_INT_IRQ_RUNNING, isr_other, (void*)"t0_compa" );
+		watch( M88_TIMER2_COMPB_VECT, AVR_INT_IRQ_RUNNING, isr_other, (void*)"t2_compb" );
+		watch( M88_ADC_VECT, AVR_INT_IRQ_RUNNING, isr_other, (void*)"adc" );
+	}
+	else
+	{
+		avr_register_vector( avr, &usiStart );
+		avr_register_vector( avr, &usiOvf );
+		avr_register_io_write( avr, T85_USISR, usi_writeSr, NULL );
+		sdaPin = avr_io_getirq( avr, AVR_IOCTL_IOPORT_GETIRQ('B'), T85_SDA );
+		sclPin = avr_io_getirq( avr, AVR_IOCTL_IOPORT_GETIRQ('B'), T85_SCL );
+		avr_raise_irq( sdaPin, 1 );
+		avr_raise_irq( sclPin, 1 );
+		watch( T85_USI_START_VECT, AVR_INT_IRQ_RUNNING, isr_running, NULL );
+		watch( T85_USI_OVF_VECT, AVR_INT_IRQ_RUNNING, isr_running, NULL );
+	}
+
+	// Let main() set up the Slave.
+	run_until( CYC_CPU_HZ / 100 );
+	if( p->staged )
+		wait_boot();
+
+	// Start counts after set up.
+	r->statCount = 0;
+	run_rounds();
+
+	avr_terminate( avr );
+}
+
+/* *** Report *** */
+static void jsonNumber( FILE* f, const char* name, double value, bool last )
+{
+	if( value < 0 )
+		fprintf( f, "\"%s\": null%s", name, last ? "" : ", " );
+	else
+		fprintf( f, "\"%s\": %.1f%s", name, value, last ? "" : ", " );
+}
+
+static void report( FILE* f, const CYC_RESULT* r, int count, uint32_t clock )
+{
+	int i;
+	int s;
+
+	fprintf( stderr, "%-5s %-14s %8s %8s %8s %8s\n", "slave", "isr", "count", "min", "avg", "max" );
+	for( i=0; i<count; ++i )
+	{
+		for( s=0; s<r[i].statCount; ++s )
+		{
+			const CYC_STAT* st = &r[i].stats[s];
+			fprintf( stderr, "%-5s %-14s %8u %8u %8.1f %8u\n", r[i].p->name, st->name, st->count,
+					 st->min, (double)st->sum / st->count, st->max );
+		}
+		fprintf( stderr, "%-5s rx %.1f+%.1f cyc/byte  loop %.1f/msg  polls %.1f/msg  refill %.1f  errors %u\n",
+				 r[i].p->name, r[i].rxIsr, r[i].rxMain, r[i].loopIters, r[i].readyPolls, r[i].refillIters,
+				 r[i].errors );
+	}
+
+	fprintf( f, "{\n  \"cpu_hz\": %u,\n  \"clock_hz\": %u,\n  \"slaves\": [\n", CYC_CPU_HZ, clock );
+	for( i=0; i<count; ++i )
+	{
+		fprintf( f, "    { \"slave\": \"%s\", \"mcu\": \"%s\", \"rounds\": %u, \"errors\": %u,\n      \"isr_cycles\": {",
+				 r[i].p->name, r[i].p->mcu, r[i].rounds, r[i].errors );
+		for( s=0; s<r[i].statCount; ++s )
+		{
+			const CYC_STAT* st = &r[i].stats[s];
+			fprintf( f, "%s\n        \"%s\": { \"count\": %u, \"min\": %u, \"avg\": %.1f, \"max\": %u }",
+					 s ? "," : "", st->name, st->count, st->min, (double)st->sum / st->count, st->max );
+		}
+		fprintf( f, " },\n      " );
+		jsonNumber( f, "rx_isr_cycles_per_byte", r[i].rxIsr, false );
+		jsonNumber( f, "rx_main_cycles_per_byte", r[i].rxMain, false );
+		jsonNumber( f, "rx_cycles_per_byte", ( r[i].rxIsr < 0 ) ? -1 : r[i].rxIsr + r[i].rxMain, false );
+		fprintf( f, "\n      " );
+		jsonNumber( f, "loop_iters_per_msg", r[i].loopIters, false );
+		jsonNumber( f, "ready_polls_per_msg", r[i].readyPolls, false );
+		jsonNumber( f, "refill_loop_iters", r[i].refillIters, true );
+		fprintf( f, " }%s\n", ( i + 1 < count ) ? "," : "" );
+	}
+	fprintf( f, "  ]\n}\n" );
+}
+
+static void usage( void )
+{
+	fprintf( stderr, "usage: avr_cycles [-n ROUNDS] [-k HZ] [-o FILE] NAME:ELF:LOOP:RECV:SEND ...\n" );
+	exit( 2 );
+}
+
+int main( int argc, char** argv )
+{
+	static CYC_RESULT results[PROJECT_COUNT];
+	uint32_t rounds = CYC_ROUNDS;
+	uint32_t clock = CYC_CLOCK;
+	const char* out = 0;
+	FILE* f = stdout;
+	int count = 0;
+	int opt;
+	int a;
+	unsigned i;
+
+	while( (opt = getopt( argc, argv, "n:k:o:" )) != -1 )
+	{
+		switch( opt )
+		{
+			case 'n': rounds = strtoul( optarg, 0, 0 ); break;
+			case 'k': clock = strtoul( optarg, 0, 0 ); break;
+			case 'o': out = optarg; break;
+			default: usage();
+		}
+	}
+	if( optind >= argc || rounds == 0 || clock == 0 )
+		usage();
+
+	byteCycles = (uint32_t)( 9ULL * CYC_CPU_HZ / clock );
+
+	for( a=optind; a<argc && count<(int)PROJECT_COUNT; ++a )
+	{
+		char name[8];
+		char elf[256];
+		unsigned long loop, recv, send;
+
+		if( sscanf( argv[a], "%7[^:]:%255[^:]:%lx:%lx:%lx", name, elf, &loop, &recv, &send ) != 5 )
+			usage();
+		for( i=0; i<PROJECT_COUNT; ++i )
+		{
+			if( strcmp( projects[i].name, name ) == 0 )
+				break;
+		}
+		if( i == PROJECT_COUNT )
+		{
+			fprintf( stderr, "unknown Slave %s\n", name );
+			return 2;
+		}
+
+		loopAdrs = loop;
+		recvAdrs = recv;
+		sendAdrs = send;
+		results[count].p = &projects[i];
+		results[count].rounds = rounds;
+		run_project( &projects[i], elf, &results[count] );
+		++count;
+	}
+
+	if( out && (f = fopen( out, "w" )) == 0 )
+	{
+		perror( out );
+		return 1;
+	}
+	report( f, results, count, clock );
+	if( f != stdout )
+		fclose( f );
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# cycles_compare.py
+#
+# Created: 10/17/2026		0.01	ndp
+#  Author: Chip
+# revision: 10/17/2026	0.02	ndp		-i to compare only some ISRs.
+#
+# Compares an avr_cycles report against a baseline and lists the regressions.
+# Exit status is 1 if there are any.
+#
+#   python3 cycles_compare.py cycles_baseline.json cycles_report.json [-t CYCLES] [-i PREFIX ...]
+#
+# An ISR whose avg or max cycles, or a project whose rx cycles per byte, grow by more than
+# CYCLES (default 0) is a regression. So is any rise in errors. Every ISR is listed with its
+# change so a gain shows too. -i limits the ISRs to the names that start with PREFIX, e.g.
+# -i twi_ -i usi_ for the TWI_vect and USI results alone.
+
+import argparse
+import json
+import sys
+
+PER_BYTE = ('rx_isr_cycles_per_byte', 'rx_main_cycles_per_byte', 'rx_cycles_per_byte')
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {s['slave']: s for s in report['slaves']}
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument('baseline')
+    ap.add_argument('report')
+    ap.add_argument('-t', type=float, default=0.0, help='tolerance in cycles')
+    ap.add_argument('-i', action='append', default=[], metavar='PREFIX', help='only ISRs starting with PREFIX')
+    args = ap.parse_args()
+
+    base = load(args.baseline)
+    new = load(args.report)
+    bad = 0
+
+    print('%-5s %-24s %8s %8s %7s' % ('slave', 'isr', 'base', 'now', 'change'))
+    for slave in sorted(base):
+        if slave not in new:
+            print('%-5s missing' % slave)
+            bad += 1
+            continue
+        b = base[slave]
+        n = new[slave]
+        for isr in sorted(b['isr_cycles']):
+            if args.i and not isr.startswith(tuple(args.i)):
+                continue
+            if isr not in n['isr_cycles']:
+                print('%-5s %-24s missing' % (slave, isr))
+                bad += 1
+                continue
+            for name in ('avg', 'max'):
+                bv = b['isr_cycles'][isr][name]
+                nv = n['isr_cycles'][isr][name]
+                worse = nv - bv > args.t
+                print('%-5s %-24s %8.1f %8.1f %+7.1f%s' % (slave, isr + ' ' + name, bv, nv, nv - bv,
+                                                        '  REGRESSION' if worse else ''))
+                bad += worse
+        for name in PER_BYTE:
+            if b[name] is None or n[name] is None:
+                continue
+            worse = n[name] - b[name] > args.t
+            print('%-5s %-24s %8.1f %8.1f %+7.1f%s' % (slave, name, b[name], n[name], n[name] - b[name],
+                                                    '  REGRESSION' if worse else ''))
+            bad += worse
+        if n['errors'] > b['errors']:
+            print('%-5s errors %u -> %u  REGRESSION' % (slave, b['errors'], n['errors']))
+            bad += 1
+
+    print('%u regression%s' % (bad, '' if bad == 1 else 's'))
+    return 1 if bad else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
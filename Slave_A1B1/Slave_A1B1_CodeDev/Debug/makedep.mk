@@ -4,5 +4,5 @@
 
 Slave_A1B1.c
 
-twiSlave.c
+../../Slave_Driver/twiSlave.c
 
@@ -0,0 +1,39 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * twiSlave_cfg.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * twiSlave options for Slave_A1B1. See ../../Slave_Driver/twiSlave.h. Write only, no READY status.
+ */ 
+
+
+#ifndef TWISLAVE_CFG_H_
+#define TWISLAVE_CFG_H_
+
+#define TWI_GENERAL_CALL	0
+#define TWI_REPLY_STATUS	0
+
+#endif /* TWISLAVE_CFG_H_ */
@@ -4,5 +4,5 @@
 
 Slave_A1B2.c
 
-twiSlave.c
+../../Slave_Driver/twiSlave.c
 
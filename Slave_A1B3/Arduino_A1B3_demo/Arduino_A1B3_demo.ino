@@ -28,11 +28,16 @@
  * This demo code will read data from the Slave.
  * If a 0x55 command is sent, the count is read.
  * Any other command should return a 0.
+ *
+ * The Slave sends a READY byte first in each read. It is the number of reply bytes that
+ * follow or 0 if the reply is not loaded yet. Reading again right away replaces a fixed
+ * delay, so the reply is read as soon as it is valid.
  */
 
 #include <Wire.h>
 
 #define  SLAVE_ADRS  0x40    // MUST match AVR chip I2C address
+#define  READY_TRIES 20      // reads before giving up on a reply.
 
 int slave = SLAVE_ADRS;      // has to be an int or a warning pops up.
 int cmdLen;                  // number of bytes to send after the I2C SDA_W code.
@@ -49,6 +54,8 @@ void setup()
 void loop()
 {
   int data_len;
+  uint8_t ready;
+  uint8_t tries;
 
   // Send Command to Slave.
   outBuff[0] = (count % 4) + 0x55;    // Send a 0x55 command ever 4th time.
@@ -63,13 +70,28 @@ void loop()
   Wire.write(outBuff, cmdLen);        // send out data.
   Wire.endTransmission();             // complete transmission.
 
-  delay(1);                           // need to give Slave time to fill output FIFO if needed.
-
   // Issues a SLA_R request and triggers N reads before NACKing Slave.
-  data_len = 2;
-  Wire.requestFrom(slave, data_len);  // request N bytes from (int)slave
+  // READY + 2 bytes. Read again while READY is 0.
+  data_len = 3;
+  tries = 0;
+  do
+  {
+    Wire.requestFrom(slave, data_len);  // request N bytes from (int)slave
+    ready = Wire.available() ? Wire.read() : 0;
+    if( ready == 0 )
+    {
+      while(Wire.available())           // drop the filler bytes.
+        Wire.read();
+    }
+  } while( (ready == 0) && (++tries < READY_TRIES) );
+
+  if( ready == 0 )
+  {
+    Serial.println("no reply");
+    delay(1000);
+    return;
+  }
 
-  while(!Wire.available());           // wait for first data byte.
   unsigned char d = Wire.read();      // receive a byte as character.
   Serial.print(d, HEX);
   Serial.print(" ");
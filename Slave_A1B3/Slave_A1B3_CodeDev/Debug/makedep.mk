@@ -4,5 +4,5 @@
 
 Slave_A1B3.c
 
-twiSlave.c
+../../Slave_Driver/twiSlave.c
 
@@ -25,6 +25,7 @@
  *
  * Created: 1/31/2016 8:11:07 PM
  *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		mark each reply READY.
  *
  * Demo code for Slave_A1B3 project.
  * Target: ATmega88A (by sure to set Project > Properties > Device to this AVR chip)
@@ -35,6 +36,7 @@
  * The Commands from the Master are either:
  * SDA_W 55				- Prepare data to be read
  * SDA_R Data0 Data1	- Return 55 COUNT
+ * With TWI_REPLY_STATUS the read is SDA_R READY 55 COUNT. READY is 0 until the reply is loaded.
  * NOTE: If a 0x55 is not the command byte, then 0 is returned instead of COUNT.
  */ 
 
@@ -75,6 +77,7 @@ int main(void)
 				twiTransmitByte( data );	// stuff command into TxBuf[]
 				twiTransmitByte( 0 );		// stuff 0 into TxBuf[]
 			}
+			twiTransmitReady();				// the Master can read it now.
 			// NOTE: The Master is expected to read both bytes before sending another command.
 			
 			++count;						// inc to track how many commands have been received.
@@ -26,107 +26,50 @@
 
 /*
  * This demo code will blink LED-1 then Glow LED-2.
+ * LED-1 is blinked by the Slave itself after one BLINK command.
+ *
+ * Uses the SlaveMaster library in ../SlaveMaster. Copy or link it into the Arduino libraries folder.
  */
 
 #include <Wire.h>
+#include <WireBus.h>
+#include <SlaveMaster.h>
 
-/* *** LOCAL PROTOTYPES *** */
-uint8_t makeHeader( uint8_t len );
+WireBus bus;
+SlaveMaster slave( bus );    // SLAVE_ADRS. MUST match AVR chip I2C address.
 
-#define  SLAVE_ADRS  0x40    // MUST match AVR chip I2C address
-
-// Single LED control
-#define   DEV_LED_ID    0x20
-#define   DEV_LED_OFF   1
-#define   DEV_LED_ON    2
-#define   DEV_LED_LEN   3
-
-// Single LED PWM glow
-#define   DEV_LED_PWM_ID    0x30
-
-#define   DEV_LED_PWM_OFF   1
-#define   DEV_LED_PWM_ON    2
-#define   DEV_LED_PWM_LEN   3
-
-#define   DEV_LED_PWM_RATE      3
-#define   DEV_LED_PWM_RATE_LEN  4
-
-
-int slave = SLAVE_ADRS;      // has to be an int or a warning pops up.
-int cmdLen;                  // number of bytes to send after the I2C SDA_W code.
-
-uint8_t outBuff[4];
+uint8_t rate = 0x02;
 uint8_t count = 0;
 
 void setup()
 {
-  Wire.begin();              // enable i2c bus support
+  bus.begin();               // enable i2c bus support
 }
 
 void loop()
 {
-  int data_len;
-
   if( count == 0 )
   {
-    // Turn on LED-2 Glow
-    outBuff[0] = makeHeader( DEV_LED_PWM_LEN-3 );
-    outBuff[1] = DEV_LED_PWM_ID;
-    outBuff[2] = DEV_LED_PWM_ON;
-    cmdLen = DEV_LED_PWM_LEN;
-
-    Wire.beginTransmission(slave);      // identify the Slave to transmit to.
-    Wire.write(outBuff, cmdLen);        // send out data.
-    Wire.endTransmission();             // complete transmission.
+    // Turn on LED-2 Glow and blink LED-1 1 sec ON, 1 sec OFF in one transaction.
+    slave.beginBatch();
+    slave.pwmOn();
+    slave.ledBlink( 100, 100 );        // 10ms tics. The Slave keeps the time.
+    slave.endBatch();
   }
 
   // Send Command to Slave.
-  if( count % 12 < 11 )
-  {
-    // Toggle LED-1 off/on
-    outBuff[0] = makeHeader( DEV_LED_LEN-3 );
-    outBuff[1] = DEV_LED_ID;
-    if( count % 2 == 0 ) {
-      outBuff[2] = DEV_LED_OFF;
-    } else {
-      outBuff[2] = DEV_LED_ON;
-    }
-    cmdLen = DEV_LED_LEN;
-  }
-  else
+  if( count % 12 == 11 )
   {
     // LED-2 Glow Rate
-    outBuff[0] = makeHeader( DEV_LED_PWM_RATE_LEN-3 );
-    outBuff[1] = DEV_LED_PWM_ID;
-    outBuff[2] = DEV_LED_PWM_RATE;
-
-    if( outBuff[3] == 0x02 )
-      outBuff[3] = 0x10;
+    if( rate == 0x02 )
+      rate = 0x10;
     else
-      outBuff[3] = 0x02;
+      rate = 0x02;
 
-    cmdLen = DEV_LED_PWM_RATE_LEN;
+    slave.pwmRate( rate );
   }
 
   ++count;
 
-  Wire.beginTransmission(slave);      // identify the Slave to transmit to. Have to do this each time.
-  Wire.write(outBuff, cmdLen);        // send out data.
-  Wire.endTransmission();             // complete transmission.
-
   delay(1000);                       // wait for 1 second.
 }
-
-/*
- * This is a simple utility to build the first byte of the
- * header by generating the one comp of the lower 4 bits.
- */
-uint8_t makeHeader( uint8_t len )
-{
-  uint8_t temp;
- 
-  temp = ((~len) << 4) & 0xF0;    // shift and mask
-  temp = temp | (len & 0x0F);
-  return (temp);
-}
-
@@ -0,0 +1,77 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Boot_A1C1.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Target: ATmega88A
+ *
+ * This is the main() file for the I2C bootloader of the Slave A1C1 example.
+ *
+ * Fuses: BOOTSZ = 00 (1024 words at 0x1800), BOOTRST programmed.
+ * Linker: -Wl,--section-start=.text=0x1800
+ *
+ * After RESET the application is started unless it asked for the bootloader (CMD_INIT_BOOT sets
+ * BOOT_EE_REQUEST) or it fails its check. The bootloader then runs the I2C Slave at the address the
+ * application left in BOOT_EE_ADRS, with the interrupt vectors moved to the boot section.
+ */ 
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include <avr/wdt.h>
+
+#include "boot_info.h"
+#include "bootloader.h"
+#include "boot_flash.h"
+#include "twiSlave.h"
+
+int main(void)
+{
+	MCUSR = 0;
+	wdt_disable();					// the application uses a watchdog RESET to get here.
+
+	if( (eeprom_read_byte( (uint8_t*)BOOT_EE_REQUEST ) != BOOT_REQUEST) && bl_appValid() )
+	{
+		bf_runApp();
+	}
+
+	MCUCR = (1<<IVCE);
+	MCUCR = (1<<IVSEL);				// vectors at BOOT_START.
+
+	twiSlaveInit( bl_getAddress() );
+	bl_init();
+
+	sei();
+
+	twiSlaveEnable();
+
+	while(1)
+	{
+		bl_service();
+
+		bl_access();
+	}
+}
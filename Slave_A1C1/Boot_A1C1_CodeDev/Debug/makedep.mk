@@ -0,0 +1,12 @@
+################################################################################
+# Automatically-generated file. Do not edit or delete the file
+################################################################################
+
+boot_flash.c
+
+Boot_A1C1.c
+
+bootloader.c
+
+../../Slave_Driver/twiSlave.c
+
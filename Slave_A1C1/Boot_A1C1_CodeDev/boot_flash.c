@@ -0,0 +1,102 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * boot_flash.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Target: ATmega88A
+ *
+ * The page buffer is filled before the erase (Alternative 1 in the data sheet) so the erase and
+ * the write can each run while the bootloader keeps receiving. The erase and write only work on
+ * the RWW section, so the CPU is not stopped.
+ * The SPMCSR write and SPM have to be within four cycles, so each one is done with interrupts OFF.
+ */ 
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/boot.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+
+#include "boot_flash.h"
+
+void bf_fillErase( uint16_t adrs, const uint8_t* data )
+{
+	uint8_t i;
+	uint16_t word;
+
+	for( i=0; i<SPM_PAGESIZE; i+=2 )
+	{
+		word = data[i] | (data[i+1] << 8);
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			boot_page_fill( adrs + i, word );
+		}
+	}
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		boot_page_erase( adrs );
+	}
+}
+
+void bf_write( uint16_t adrs )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		boot_page_write( adrs );
+	}
+}
+
+bool bf_busy()
+{
+	return boot_spm_busy();
+}
+
+void bf_rwwEnable()
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		boot_rww_enable();
+	}
+}
+
+uint8_t bf_readByte( uint16_t adrs )
+{
+	return pgm_read_byte( adrs );
+}
+
+/*
+ * Put the TWI and the interrupt vectors back the way they are after RESET and jump to 0x0000.
+ */
+void bf_runApp()
+{
+	cli();
+	TWCR = 0;
+	MCUCR = (1<<IVCE);
+	MCUCR = 0;						// vectors at 0x0000.
+
+	((void (*)(void))0)();
+}
@@ -0,0 +1,48 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * boot_flash.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		include stdint.h for the host build.
+ *
+ * Self programming (SPM) and start up functions used by the bootloader.
+ * A host build can supply its own boot_flash.c to test bootloader.c against a simulated flash.
+ */ 
+
+
+#ifndef BOOT_FLASH_H_
+#define BOOT_FLASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void	bf_fillErase( uint16_t adrs, const uint8_t* data );	// fill the page buffer then start the page erase.
+void	bf_write( uint16_t adrs );							// start the page write.
+bool	bf_busy();											// true while an erase or write is running.
+void	bf_rwwEnable();										// allow reads of the application section.
+uint8_t	bf_readByte( uint16_t adrs );
+void	bf_runApp();										// start the application. Does not return.
+
+#endif /* BOOT_FLASH_H_ */
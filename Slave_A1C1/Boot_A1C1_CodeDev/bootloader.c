@@ -0,0 +1,364 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * bootloader.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		mark each reply READY.
+ *
+ * I2C bootloader. Uses the same twiSlave FIFOs and LEN MOD CMD DATA framing as the application
+ * but only answers to MOD = BOOT_ID, so there is no need for the function tables.
+ * See boot_info.h for the commands.
+ *
+ * Page Pipeline
+ *   There are two page buffers. DATA fills one while the other is written to flash by
+ *   bl_service(), so receiving the next page overlaps the erase and write of the current one.
+ *   If the fill buffer is full before the write is done, no more messages are taken from the
+ *   input FIFO until it is. The Master should check STATUS READY before sending each page.
+ *
+ *   A page write is about 3.7ms erase + 3.7ms write. A page at 100kHz is 8 messages of 11 bytes,
+ *   about 9ms, so the writes keep up with the bus.
+ */ 
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <stdbool.h>
+
+#include "bootloader.h"
+#include "boot_flash.h"
+#include "boot_info.h"
+#include "i2c_address.h"
+#include "twiSlave.h"
+
+#if (SPM_PAGESIZE % BOOT_DATA_MAX) != 0
+#  error SPM_PAGESIZE must be a multiple of BOOT_DATA_MAX
+#endif
+
+#define BL_IDLE		0
+#define BL_ERASE	1
+#define BL_WRITE	2
+
+static uint8_t	bl_msgBuff[BOOT_MSG_BUFF_SIZE];
+static uint8_t	bl_msgIndex;
+static uint8_t	bl_msgSize;
+
+static uint8_t	bl_page[2][SPM_PAGESIZE];
+static uint8_t	bl_fillBuf;				// page buffer being filled by DATA.
+static uint8_t	bl_fillCount;
+static uint16_t	bl_fillAdrs;
+static uint16_t	bl_progAdrs;			// page being written from the other buffer.
+static uint8_t	bl_progState;
+static bool		bl_pending;				// other buffer has a page that is not written yet.
+static bool		bl_stalled;				// fill buffer is full and waiting for the other buffer.
+static uint8_t	bl_error;
+
+void bl_init()
+{
+	bl_msgIndex = 0;
+	bl_msgSize = 0;
+
+	bl_fillBuf = 0;
+	bl_fillCount = 0;
+	bl_fillAdrs = 0;
+	bl_progState = BL_IDLE;
+	bl_pending = false;
+	bl_stalled = false;
+	bl_error = 0;
+}
+
+/*
+ * I2C address from the application or SLAVE_ADRS if it did not leave a valid one.
+ */
+uint8_t bl_getAddress()
+{
+	uint8_t adrs = eeprom_read_byte( (uint8_t*)BOOT_EE_ADRS );
+
+	if( (adrs < 0x08) || (adrs > 0x77) )
+	{
+		adrs = SLAVE_ADRS;
+	}
+	return adrs;
+}
+
+/*
+ * CRC-16/XMODEM (poly 0x1021, init 0) of flash 0:LEN-1.
+ */
+uint16_t bl_crc( uint16_t len )
+{
+	uint16_t crc = 0;
+	uint16_t i;
+
+	for( i=0; i<len; ++i )
+	{
+		crc = (crc >> 8) | (crc << 8);
+		crc ^= bf_readByte( i );
+		crc ^= (crc & 0xFF) >> 4;
+		crc ^= crc << 12;
+		crc ^= (crc & 0xFF) << 5;
+	}
+	return crc;
+}
+
+/*
+ * true if there is an application and it matches the check values saved by RUN.
+ * An application loaded with ISP has no check values (LEN = 0xFFFF) and is run as is.
+ */
+bool bl_appValid()
+{
+	uint16_t len = eeprom_read_word( (uint16_t*)BOOT_EE_LEN );
+
+	if( (bf_readByte(0) == 0xFF) && (bf_readByte(1) == 0xFF) )
+	{
+		return false;					// erased.
+	}
+	if( len == 0xFFFF )
+	{
+		return true;
+	}
+	if( len > BOOT_START )
+	{
+		return false;
+	}
+	return ( bl_crc( len ) == eeprom_read_word( (uint16_t*)BOOT_EE_CRC ) );
+}
+
+/*
+ * Hand the full fill buffer to the writer or stall until it is free.
+ */
+static void bl_queue()
+{
+	if( bl_pending )
+	{
+		bl_stalled = true;
+		return;
+	}
+
+	bl_progAdrs = bl_fillAdrs;
+	bl_pending = true;
+	bl_fillBuf ^= 1;
+	bl_fillCount = 0;
+	bl_fillAdrs += SPM_PAGESIZE;
+	bl_stalled = false;
+}
+
+/*
+ * Run the page write state machine. Call often.
+ */
+void bl_service()
+{
+	switch( bl_progState )
+	{
+		case BL_IDLE:
+			if( bl_pending )
+			{
+				bf_fillErase( bl_progAdrs, bl_page[bl_fillBuf ^ 1] );
+				bl_progState = BL_ERASE;
+			}
+			break;
+
+		case BL_ERASE:
+			if( !bf_busy() )
+			{
+				bf_write( bl_progAdrs );
+				bl_progState = BL_WRITE;
+			}
+			break;
+
+		case BL_WRITE:
+			if( !bf_busy() )
+			{
+				bf_rwwEnable();
+				bl_progState = BL_IDLE;
+				bl_pending = false;
+				if( bl_stalled )
+				{
+					bl_queue();
+				}
+			}
+			break;
+	}
+}
+
+/*
+ * Finish all page writes. Needed before the application section is read.
+ */
+static void bl_flushWait()
+{
+	while( bl_pending || bl_stalled )
+	{
+		bl_service();
+	}
+}
+
+static void bl_command()
+{
+	uint8_t count = bl_msgSize - 3;
+	uint8_t* data = &bl_msgBuff[3];
+	uint16_t len;
+	uint16_t crc;
+	uint8_t i;
+
+	switch( bl_msgBuff[2] )
+	{
+		case CMD_BOOT_IDENT:
+			twiTransmitByte( BOOT_VERSION );
+			twiTransmitByte( SPM_PAGESIZE );
+			twiTransmitByte( (uint8_t)BOOT_START );
+			twiTransmitByte( BOOT_START >> 8 );
+			break;
+
+		case CMD_BOOT_ADDR:
+			len = data[0] | (data[1] << 8);
+			bl_error = 0;
+			if( (len & (SPM_PAGESIZE - 1)) || (len >= BOOT_START) )
+			{
+				bl_error |= BOOT_ERR_ADRS;
+			}
+			else
+			{
+				bl_fillAdrs = len;
+				bl_fillCount = 0;
+			}
+			break;
+
+		case CMD_BOOT_DATA:
+			if( (count == 0) || (bl_fillCount + count > SPM_PAGESIZE) )
+			{
+				bl_error |= BOOT_ERR_ALIGN;
+			}
+			else if( bl_fillAdrs >= BOOT_START )
+			{
+				bl_error |= BOOT_ERR_ADRS;
+			}
+			else
+			{
+				for( i=0; i<count; ++i )
+				{
+					bl_page[bl_fillBuf][bl_fillCount++] = data[i];
+				}
+				if( bl_fillCount == SPM_PAGESIZE )
+				{
+					bl_queue();
+				}
+			}
+			break;
+
+		case CMD_BOOT_FLUSH:
+			if( bl_fillCount != 0 )
+			{
+				while( bl_fillCount < SPM_PAGESIZE )
+				{
+					bl_page[bl_fillBuf][bl_fillCount++] = 0xFF;
+				}
+				bl_queue();
+			}
+			break;
+
+		case CMD_BOOT_STATUS:
+			i = 0;
+			if( !bl_stalled )
+				i |= BOOT_STATE_READY;
+			if( bl_progState != BL_IDLE )
+				i |= BOOT_STATE_BUSY;
+			if( bl_pending )
+				i |= BOOT_STATE_PENDING;
+			twiTransmitByte( i );
+			twiTransmitByte( bl_error );
+			twiTransmitByte( (uint8_t)bl_fillAdrs );
+			twiTransmitByte( bl_fillAdrs >> 8 );
+			break;
+
+		case CMD_BOOT_CRC:
+			bl_flushWait();
+			len = data[0] | (data[1] << 8);
+			if( len > BOOT_START )
+			{
+				len = BOOT_START;
+			}
+			crc = bl_crc( len );
+			twiTransmitByte( (uint8_t)crc );
+			twiTransmitByte( crc >> 8 );
+			break;
+
+		case CMD_BOOT_RUN:
+			bl_flushWait();
+			len = data[0] | (data[1] << 8);
+			crc = data[2] | (data[3] << 8);
+			if( (len > BOOT_START) || (bl_crc( len ) != crc) )
+			{
+				bl_error |= BOOT_ERR_CRC;
+				break;
+			}
+			eeprom_update_word( (uint16_t*)BOOT_EE_LEN, len );
+			eeprom_update_word( (uint16_t*)BOOT_EE_CRC, crc );
+			eeprom_update_byte( (uint8_t*)BOOT_EE_REQUEST, 0xFF );
+			eeprom_busy_wait();
+			bf_runApp();
+			break;
+
+		default:
+			bl_error |= BOOT_ERR_FRAME;
+			break;
+	}
+}
+
+/*
+ * Collect a LEN MOD CMD DATA message from the input FIFO and process it.
+ * Nothing is taken from the FIFO while the fill buffer is waiting to be written.
+ */
+void bl_access()
+{
+	uint8_t temp;
+
+	if( bl_stalled || !twiDataInReceiveBuffer() )
+	{
+		return;
+	}
+
+	bl_msgBuff[bl_msgIndex++] = twiReceiveByte();
+
+	// Valid message being received? ~LEN.7:4 == LEN.3:0
+	if( bl_msgIndex == 1 )
+	{
+		temp = (~bl_msgBuff[0] >> 4) & 0x0F;
+		bl_msgSize = bl_msgBuff[0] & 0x0F;
+		if( temp != bl_msgSize )
+		{
+			bl_error |= BOOT_ERR_FRAME;
+			bl_msgIndex = 0;			// ERROR..size check failed.
+			return;
+		}
+		bl_msgSize += 3;
+	}
+
+	if( bl_msgIndex == bl_msgSize )
+	{
+		if( bl_msgBuff[1] == BOOT_ID )
+		{
+			bl_command();
+			twiTransmitReady();
+		}
+		bl_msgIndex = 0;
+	}
+}
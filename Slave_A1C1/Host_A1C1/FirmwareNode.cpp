@@ -0,0 +1,359 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * FirmwareNode.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add reset() and setUid().
+ */ 
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "FirmwareNode.h"
+
+/* TWI registers (data space) and bits. Same as mock/avr/io.h */
+#define NODE_TWAR	0xBA
+#define NODE_TWDR	0xBB
+#define NODE_TWCR	0xBC
+#define NODE_TWEA	6
+#define NODE_TWSTO	4
+#define NODE_TWEN	2
+#define NODE_TWGCE	0
+
+/* TWI Slave status codes */
+#define TWS_SRX_ADR_ACK		0x60
+#define TWS_SRX_GEN_ACK		0x70
+#define TWS_SRX_DATA_ACK	0x80
+#define TWS_SRX_DATA_NACK	0x88
+#define TWS_SRX_GEN_DATA	0x90
+#define TWS_SRX_GEN_NACK	0x98
+#define TWS_SRX_STOP		0xA0
+#define TWS_STX_ADR_ACK		0xA8
+#define TWS_STX_DATA_ACK	0xB8
+#define TWS_STX_DATA_NACK	0xC0
+
+/*
+ * dlopen() loads a library once per path, so each node opens its own copy of the file.
+ */
+static void* openCopy( const char* lib )
+{
+	char path[] = "/tmp/a1c1_nodeXXXXXX";
+	char buf[4096];
+	void* handle = 0;
+	FILE* in;
+	FILE* out;
+	size_t n;
+	int fd;
+
+	fd = mkstemp( path );
+	if( fd < 0 )
+		return 0;
+	in = fopen( lib, "rb" );
+	out = fdopen( fd, "wb" );
+	if( in && out )
+	{
+		while( (n = fread( buf, 1, sizeof(buf), in )) > 0 )
+			fwrite( buf, 1, n, out );
+	}
+	if( in )
+		fclose( in );
+	if( out )
+		fclose( out );
+	else
+		close( fd );
+
+	handle = dlopen( path, RTLD_NOW | RTLD_LOCAL );
+	if( !handle )
+		fprintf( stderr, "FirmwareNode: %s\n", dlerror() );
+	unlink( path );								// stays mapped.
+	return handle;
+}
+
+FirmwareNode::FirmwareNode( const char* lib, uint8_t adrs, uint32_t loopNs, uint32_t isrNs )
+	: _lib(0), _adrs(adrs), _loopNs(loopNs), _isrNs(isrNs), _nextLoop(0), _nextTick(1000000),
+	  _state(ST_IDLE), _prevScl(true), _sdaOut(true), _hold(false), _general(false), _shift(0),
+	  _bits(0), _ack(false), _twint(false), _status(0), _isrAt(0), _collisions(0), _events(0)
+{
+	_lib = openCopy( lib );
+	if( !_lib )
+		return;
+
+	_boot = (void (*)( uint8_t ))dlsym( _lib, "node_boot" );
+	_loop = (void (*)( void ))dlsym( _lib, "node_loop" );
+	_tick = (void (*)( void ))dlsym( _lib, "node_tick" );
+	_twi = (void (*)( uint8_t, uint8_t ))dlsym( _lib, "node_twi" );
+	_io = (uint8_t (*)( uint8_t ))dlsym( _lib, "node_io" );
+	_setIo = (void (*)( uint8_t, uint8_t ))dlsym( _lib, "node_setIo" );
+	_setUid = (void (*)( const uint8_t* ))dlsym( _lib, "node_setUid" );
+	if( !_boot || !_loop || !_tick || !_twi || !_io || !_setIo || !_setUid )
+	{
+		fprintf( stderr, "FirmwareNode: %s is not an a1c1_node library\n", lib );
+		dlclose( _lib );
+		_lib = 0;
+		return;
+	}
+
+	_boot( adrs );
+	_nextLoop = ( adrs * 7919u ) % _loopNs;	// nodes do not all run their loop on the same tick.
+}
+
+/*
+ * RESET the firmware and the TWI hardware. Call it while the bus is idle.
+ */
+void FirmwareNode::reset()
+{
+	_boot( 0 );
+	_state = ST_IDLE;
+	_sdaOut = true;
+	_hold = false;
+	_general = false;
+	_bits = 0;
+	_twint = false;
+}
+
+FirmwareNode::~FirmwareNode()
+{
+	if( _lib )
+		dlclose( _lib );
+}
+
+bool FirmwareNode::twea() const
+{
+	uint8_t twcr = _io( NODE_TWCR );
+
+	return ( twcr & (1<<NODE_TWEN) ) && ( twcr & (1<<NODE_TWEA) );
+}
+
+/*
+ * TWI event. The address and data events hold SCL low until the ISR is done.
+ */
+void FirmwareNode::setTwint( uint64_t ns, uint8_t status, bool hold )
+{
+	_twint = true;
+	_status = status;
+	_isrAt = ns + _isrNs;
+	_hold = hold;
+	++_events;
+}
+
+void FirmwareNode::runIsr()
+{
+	_twi( _status, ( _state == ST_RX ) ? _shift : _io( NODE_TWDR ) );
+	_twint = false;
+	_hold = false;
+
+	if( _io( NODE_TWCR ) & (1<<NODE_TWSTO) )
+	{
+		_state = ST_IGNORE;						// bus error recovery. Wait for a START.
+		_sdaOut = true;
+		return;
+	}
+
+	switch( _status )
+	{
+		case TWS_SRX_ADR_ACK:
+		case TWS_SRX_GEN_ACK:
+		case TWS_SRX_DATA_ACK:
+		case TWS_SRX_GEN_DATA:
+			_state = ST_RX;
+			_shift = 0;
+			_bits = 0;
+			break;
+
+		case TWS_STX_ADR_ACK:
+		case TWS_STX_DATA_ACK:
+			// SCL is low. Put out the first bit of TWDR now.
+			_state = ST_TX;
+			_shift = _io( NODE_TWDR );
+			_sdaOut = ( _shift & 0x80 ) != 0;
+			_bits = 1;
+			break;
+
+		default:
+			break;
+	}
+}
+
+void FirmwareNode::step( uint64_t ns, bool sda, bool scl, WireEvent ev )
+{
+	uint8_t twar;
+	bool match;
+
+	if( !_lib )
+		return;
+
+	if( _twint && ns >= _isrAt )
+		runIsr();
+
+	if( ev == WIRE_START || ev == WIRE_STOP )
+	{
+		// A STOP or repeated START ends a write to this node.
+		if( ( _state == ST_RX || _state == ST_RX_ACK ) && !_twint )
+			setTwint( ns, TWS_SRX_STOP, false );
+		_state = ( ev == WIRE_START ) ? ST_ADDR : ST_IDLE;
+		_shift = 0;
+		_bits = 0;
+		_sdaOut = true;
+		_general = false;
+	}
+	else if( scl && !_prevScl )
+	{
+		// Rising edge. Sample SDA.
+		switch( _state )
+		{
+			case ST_ADDR:
+				_shift = ( _shift << 1 ) | sda;
+				if( ++_bits == 8 )
+				{
+					twar = _io( NODE_TWAR );
+					_general = ( _shift == 0 ) && ( twar & (1<<NODE_TWGCE) );
+					match = ( (_shift >> 1) == (twar >> 1) ) || _general;
+					_ack = match && twea();
+					if( !_ack )
+						_state = ST_IGNORE;
+				}
+				break;
+
+			case ST_RX:
+				_shift = ( _shift << 1 ) | sda;
+				if( ++_bits == 8 )
+					_ack = twea();
+				break;
+
+			case ST_TX:
+				if( _sdaOut && !sda )
+					++_collisions;				// another Slave is driving this bit low.
+				break;
+
+			case ST_TX_ACK:
+				_ack = !sda;
+				break;
+
+			default:
+				break;
+		}
+	}
+	else if( !scl && _prevScl )
+	{
+		// Falling edge. Change SDA.
+		switch( _state )
+		{
+			case ST_ADDR:
+				if( _bits == 8 )
+				{
+					_sdaOut = false;			// ACK
+					_state = ST_ADDR_ACK;
+				}
+				break;
+
+			case ST_ADDR_ACK:
+				_sdaOut = true;
+				if( _shift & 0x01 )
+				{
+					_state = ST_TX;
+					setTwint( ns, TWS_STX_ADR_ACK, true );
+				}
+				else
+				{
+					_state = ST_RX;
+					setTwint( ns, _general ? TWS_SRX_GEN_ACK : TWS_SRX_ADR_ACK, true );
+				}
+				break;
+
+			case ST_RX:
+				if( _bits == 8 )
+				{
+					_sdaOut = !_ack;
+					_state = ST_RX_ACK;
+				}
+				break;
+
+			case ST_RX_ACK:
+				_sdaOut = true;
+				_state = ST_RX;
+				if( _ack )
+				{
+					setTwint( ns, _general ? TWS_SRX_GEN_DATA : TWS_SRX_DATA_ACK, true );
+				}
+				else
+				{
+					setTwint( ns, _general ? TWS_SRX_GEN_NACK : TWS_SRX_DATA_NACK, false );
+					_state = ST_IGNORE;
+				}
+				break;
+
+			case ST_TX:
+				if( _twint )
+					break;						// waiting for the ISR to load TWDR.
+				if( _bits < 8 )
+				{
+					_shift <<= 1;
+					_sdaOut = ( _shift & 0x80 ) != 0;
+					++_bits;
+				}
+				else
+				{
+					_sdaOut = true;				// let go for the Master's ACK.
+					_state = ST_TX_ACK;
+				}
+				break;
+
+			case ST_TX_ACK:
+				if( _ack )
+				{
+					_state = ST_TX;
+					setTwint( ns, TWS_STX_DATA_ACK, true );
+				}
+				else
+				{
+					_state = ST_IGNORE;
+					setTwint( ns, TWS_STX_DATA_NACK, false );
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+	_prevScl = scl;
+
+	// Main loop and Timer0. Not while an ISR is waiting to run.
+	if( !_twint )
+	{
+		while( ns >= _nextTick )
+		{
+			_tick();
+			_nextTick += 1000000;
+		}
+		if( ns >= _nextLoop )
+		{
+			_loop();
+			_nextLoop += _loopNs;
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * FirmwareNode.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * A Slave_A1C1 node on a WireBus. It runs its own copy of the host built firmware (the
+ * a1c1_node library) and has a model of the ATmega88A TWI Slave hardware between the firmware
+ * and the lines:
+ *   - START, STOP and the address are seen on the lines. TWAR and TWGCE pick the address and
+ *     general call, TWEA in TWCR says if the address and data are ACK'd.
+ *   - Each TWI event sets TWINT with its status code. For the address and data events SCL is
+ *     held low until the ISR is done, ISR_NS after the event. The ISR is TWI_vect in the
+ *     firmware, and what it writes to TWCR and TWDR sets the next step.
+ *   - The main loop runs every LOOP_NS and Timer0 every 1ms of bus time.
+ * A node that lets SDA go high for a data bit it sends while the line stays low counts a
+ * collision bit. The TWI hardware does not see this, so the node goes on as a real one would.
+ * Two nodes at one address count one on each bit where their replies differ.
+ * reset() is a RESET of the node. Its EEPROM is kept, so an address it was given is used again.
+ *
+ * revision: 10/17/2026	0.02	ndp		add reset() and setUid().
+ */ 
+
+
+#ifndef FIRMWARENODE_H_
+#define FIRMWARENODE_H_
+
+#include <stdint.h>
+
+#include "WireBus.h"
+
+#define NODE_LOOP_NS	20000
+#define NODE_ISR_NS		4000
+
+class FirmwareNode : public WireDevice
+{
+public:
+	FirmwareNode( const char* lib, uint8_t adrs, uint32_t loopNs = NODE_LOOP_NS, uint32_t isrNs = NODE_ISR_NS );
+	virtual ~FirmwareNode();
+
+	bool		ok() const { return _lib != 0; }
+	uint8_t		adrs() const { return _adrs; }			// as made. See TWAR for the one in use.
+
+	void		reset();
+	void		setUid( const uint8_t* uid ) { _setUid( uid ); }	// used from the next reset().
+
+	virtual void	step( uint64_t ns, bool sda, bool scl, WireEvent ev );
+	virtual bool	sdaOut() const { return _sdaOut; }
+	virtual bool	sclOut() const { return !_hold; }
+
+	uint8_t		io( uint8_t adrs ) const { return _io( adrs ); }
+	void		setIo( uint8_t adrs, uint8_t value ) { _setIo( adrs, value ); }
+
+	uint32_t	collisions() const { return _collisions; }
+	uint32_t	events() const { return _events; }			// TWI interrupts.
+
+private:
+	enum State { ST_IDLE, ST_ADDR, ST_ADDR_ACK, ST_RX, ST_RX_ACK, ST_TX, ST_TX_ACK, ST_IGNORE };
+
+	void	setTwint( uint64_t ns, uint8_t status, bool hold );
+	void	runIsr();
+	bool	twea() const;
+
+	void*		_lib;
+	void		(*_boot)( uint8_t );
+	void		(*_loop)( void );
+	void		(*_tick)( void );
+	void		(*_twi)( uint8_t, uint8_t );
+	uint8_t		(*_io)( uint8_t );
+	void		(*_setIo)( uint8_t, uint8_t );
+	void		(*_setUid)( const uint8_t* );
+
+	uint8_t		_adrs;
+	uint32_t	_loopNs;
+	uint32_t	_isrNs;
+	uint64_t	_nextLoop;
+	uint64_t	_nextTick;
+
+	State		_state;
+	bool		_prevScl;
+	bool		_sdaOut;
+	bool		_hold;
+	bool		_general;					// addressed by a general call.
+	uint8_t		_shift;
+	uint8_t		_bits;
+	bool		_ack;						// ACK to send, or ACK the Master sent.
+
+	bool		_twint;
+	uint8_t		_status;
+	uint64_t	_isrAt;
+
+	uint32_t	_collisions;
+	uint32_t	_events;
+};
+
+#endif /* FIRMWARENODE_H_ */
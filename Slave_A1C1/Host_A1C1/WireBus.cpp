@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WireBus.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#include <stddef.h>
+
+#include "WireBus.h"
+
+WireBus::WireBus( uint32_t tickNs )
+	: _tickNs(tickNs), _now(0), _sda(true), _scl(true), _event(WIRE_NONE),
+	  _busy(false), _busyNs(0), _starts(0)
+{
+}
+
+void WireBus::step()
+{
+	bool sda = true;
+	bool scl = true;
+	size_t i;
+
+	for( i=0; i<_devices.size(); ++i )
+	{
+		_devices[i]->step( _now, _sda, _scl, _event );
+	}
+	for( i=0; i<_devices.size(); ++i )
+	{
+		sda = sda && _devices[i]->sdaOut();
+		scl = scl && _devices[i]->sclOut();
+	}
+
+	// START and STOP are SDA changes while SCL stays high.
+	_event = WIRE_NONE;
+	if( _scl && scl && ( _sda != sda ) )
+	{
+		_event = sda ? WIRE_STOP : WIRE_START;
+	}
+	if( _event == WIRE_START )
+	{
+		_busy = true;
+		++_starts;
+	}
+	else if( _event == WIRE_STOP )
+	{
+		_busy = false;
+	}
+	if( _busy )
+	{
+		_busyNs += _tickNs;
+	}
+
+	_sda = sda;
+	_scl = scl;
+	_now += _tickNs;
+}
+
+void WireBus::run( uint64_t ns )
+{
+	uint64_t end = _now + ns;
+
+	while( _now < end )
+	{
+		step();
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WireBus.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Bit level I2C bus with wired-AND SDA and SCL. Every device has an open drain output on each
+ * line: false pulls the line low, true lets it go. A line is high only when no device pulls
+ * it low, so clock stretching, arbitration and two Slaves driving at once all come out of the
+ * lines the same way as on a real bus.
+ *
+ * Time is virtual and moves in fixed ticks. Each tick every device (in the order attached)
+ * sees the line levels and the START or STOP seen since the last tick, then sets its outputs.
+ * The run is the same every time for the same devices.
+ */ 
+
+
+#ifndef WIREBUS_H_
+#define WIREBUS_H_
+
+#include <stdint.h>
+#include <vector>
+
+#define WIRE_TICK_NS	100
+
+enum WireEvent { WIRE_NONE, WIRE_START, WIRE_STOP };
+
+class WireDevice
+{
+public:
+	virtual ~WireDevice() {}
+
+	virtual void	step( uint64_t ns, bool sda, bool scl, WireEvent ev ) = 0;
+	virtual bool	sdaOut() const = 0;
+	virtual bool	sclOut() const = 0;
+};
+
+class WireBus
+{
+public:
+	explicit WireBus( uint32_t tickNs = WIRE_TICK_NS );
+
+	void		attach( WireDevice* dev ) { _devices.push_back( dev ); }
+
+	void		step();
+	void		run( uint64_t ns );
+
+	uint64_t	now() const { return _now; }
+	uint32_t	tickNs() const { return _tickNs; }
+	bool		sda() const { return _sda; }
+	bool		scl() const { return _scl; }
+	bool		busy() const { return _busy; }
+
+	uint64_t	busyNs() const { return _busyNs; }		// time between START and STOP.
+	uint32_t	starts() const { return _starts; }
+
+private:
+	std::vector<WireDevice*> _devices;
+	uint32_t	_tickNs;
+	uint64_t	_now;
+	bool		_sda;
+	bool		_scl;
+	WireEvent	_event;
+	bool		_busy;
+	uint64_t	_busyNs;
+	uint32_t	_starts;
+};
+
+#endif /* WIREBUS_H_ */
@@ -0,0 +1,335 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WireMaster.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add WQ_RAW reads.
+ */ 
+
+#include <string.h>
+
+#include "WireMaster.h"
+
+WireMaster::WireMaster( uint32_t clockHz )
+	: _active(false), _started(false), _stage(STAGE_WRITE), _halfNs(500000000u / clockHz),
+	  _phase(PH_IDLE), _until(0), _sdaOut(true), _sclOut(true), _busBusy(false), _freeAt(0),
+	  _read(false), _len(0), _byte(0), _bit(0), _shift(0), _driving(false), _ack(false),
+	  _xferOk(false), _arbLost(0), _nacks(0)
+{
+	memset( &_cur, 0, sizeof(_cur) );
+}
+
+/*
+ * Set up the next transfer. It starts when the bus is free.
+ */
+void WireMaster::transfer( bool read, const uint8_t* data, uint8_t len )
+{
+	_read = read;
+	_len = len;
+	if( !read && len )
+		memcpy( _buf, data, len );
+}
+
+void WireMaster::finish( uint64_t ns, bool ok )
+{
+	_cur.ok = ok;
+	_cur.endNs = ns;
+	_done.push_back( _cur );
+	_active = false;
+}
+
+/*
+ * Next step of the query after a STOP.
+ */
+void WireMaster::transferDone( uint64_t ns )
+{
+	switch( _stage )
+	{
+		case STAGE_WRITE:
+			if( !_xferOk )
+			{
+				++_nacks;
+				finish( ns, false );
+			}
+			else if( _cur.replyLen == 0 )
+			{
+				finish( ns, true );
+			}
+			else
+			{
+				_stage = STAGE_POLL;
+				transfer( true, 0, 1 );
+			}
+			break;
+
+		case STAGE_POLL:
+			if( _xferOk && _buf[0] >= _cur.replyLen )
+			{
+				_stage = STAGE_READ;
+				transfer( true, 0, _cur.replyLen + 1 );
+			}
+			else if( ++_cur.polls >= WQ_POLL_MAX )
+			{
+				finish( ns, false );
+			}
+			else
+			{
+				transfer( true, 0, 1 );
+			}
+			break;
+
+		case STAGE_READ:
+			if( _cur.flags & WQ_RAW )
+			{
+				if( _xferOk )
+					memcpy( _cur.reply, _buf, _cur.replyLen );
+				else
+					++_nacks;
+				finish( ns, _xferOk );
+			}
+			else if( _xferOk && _buf[0] >= _cur.replyLen )
+			{
+				memcpy( _cur.reply, &_buf[1], _cur.replyLen );
+				finish( ns, true );
+			}
+			else
+			{
+				finish( ns, false );
+			}
+			break;
+	}
+}
+
+/*
+ * The Master drives the address and write data bits and the ACK of read data.
+ */
+bool WireMaster::drives() const
+{
+	if( _byte == 0 || !_read )
+		return _bit < 8;
+	return _bit == 8;
+}
+
+bool WireMaster::bitValue() const
+{
+	uint8_t data;
+
+	if( _bit == 8 )
+		return _byte == _len;					// NACK the last read byte.
+
+	data = ( _byte == 0 ) ? (uint8_t)( (_cur.adrs << 1) | _read ) : _buf[_byte - 1];
+	return ( data >> (7 - _bit) ) & 1;
+}
+
+void WireMaster::stop( uint64_t ns )
+{
+	_phase = PH_STOP_LOW;
+	_until = ns + _halfNs / 2;
+}
+
+/*
+ * SCL just went low at the end of a bit.
+ */
+void WireMaster::nextBit( uint64_t ns )
+{
+	bool send = ( _byte == 0 ) || !_read;
+
+	if( _bit == 8 )
+	{
+		if( send && !_ack )
+		{
+			_xferOk = false;					// NACK
+			stop( ns );
+			return;
+		}
+		if( _byte == _len )
+		{
+			_xferOk = true;
+			stop( ns );
+			return;
+		}
+		++_byte;
+		_bit = 0;
+		_shift = 0;
+	}
+	else
+	{
+		if( !send && _bit == 7 )
+			_buf[_byte - 1] = _shift;
+		++_bit;
+	}
+	_phase = PH_LOW;
+	_until = ns + _halfNs / 2;
+}
+
+void WireMaster::step( uint64_t ns, bool sda, bool scl, WireEvent ev )
+{
+	if( ev == WIRE_START )
+	{
+		_busBusy = true;
+	}
+	else if( ev == WIRE_STOP )
+	{
+		_busBusy = false;
+		_freeAt = ns + _halfNs;					// bus free time before the next START.
+	}
+
+	switch( _phase )
+	{
+		case PH_IDLE:
+			if( !_active )
+			{
+				if( _queue.empty() )
+					break;
+				_cur = _queue.front();
+				_queue.pop_front();
+				_cur.ok = false;
+				_cur.polls = 0;
+				_active = true;
+				_started = false;
+				if( _cur.flags & WQ_RAW )
+				{
+					_stage = STAGE_READ;
+					transfer( true, 0, _cur.replyLen );
+				}
+				else
+				{
+					_stage = STAGE_WRITE;
+					transfer( false, _cur.msg, _cur.len );
+				}
+			}
+			if( _busBusy || ns < _freeAt )
+				break;
+			if( !_started )
+			{
+				_cur.startNs = ns;
+				_started = true;
+			}
+			_sdaOut = false;					// START
+			_byte = 0;
+			_bit = 0;
+			_shift = 0;
+			_phase = PH_START;
+			_until = ns + _halfNs;
+			break;
+
+		case PH_START:
+			if( ns >= _until )
+			{
+				_sclOut = false;
+				_phase = PH_LOW;
+				_until = ns + _halfNs / 2;
+			}
+			break;
+
+		case PH_LOW:
+			if( ns >= _until )
+			{
+				_driving = drives();
+				_sdaOut = _driving ? bitValue() : true;
+				_phase = PH_SETUP;
+				_until = ns + _halfNs / 2;
+			}
+			break;
+
+		case PH_SETUP:
+			if( ns >= _until )
+			{
+				_sclOut = true;
+				_phase = PH_RISE;
+			}
+			break;
+
+		case PH_RISE:
+			if( !scl )
+				break;							// a Slave is stretching or another Master is slower.
+			if( _driving && _sdaOut && !sda )
+			{
+				// Lost arbitration. Let go and try again after the STOP.
+				_sdaOut = true;
+				_sclOut = true;
+				_phase = PH_LOST;
+				++_arbLost;
+				break;
+			}
+			if( !_driving )
+			{
+				if( _bit == 8 )
+					_ack = !sda;
+				else
+					_shift = ( _shift << 1 ) | sda;
+			}
+			_phase = PH_HIGH;
+			_until = ns + _halfNs;
+			break;
+
+		case PH_HIGH:
+			if( scl && ns < _until )
+				break;							// SCL low early is another Master. Clock sync.
+			_sclOut = false;
+			nextBit( ns );
+			break;
+
+		case PH_STOP_LOW:
+			if( ns >= _until )
+			{
+				_sdaOut = false;
+				_phase = PH_STOP_SETUP;
+				_until = ns + _halfNs / 2;
+			}
+			break;
+
+		case PH_STOP_SETUP:
+			if( ns >= _until )
+			{
+				_sclOut = true;
+				_phase = PH_STOP_RISE;
+			}
+			break;
+
+		case PH_STOP_RISE:
+			if( scl )
+			{
+				_phase = PH_STOP_HIGH;
+				_until = ns + _halfNs;
+			}
+			break;
+
+		case PH_STOP_HIGH:
+			if( ns >= _until )
+			{
+				_sdaOut = true;					// STOP
+				_phase = PH_IDLE;
+				transferDone( ns );
+			}
+			break;
+
+		case PH_LOST:
+			if( !_busBusy )
+				_phase = PH_IDLE;
+			break;
+	}
+}
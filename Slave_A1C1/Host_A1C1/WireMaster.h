@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WireMaster.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Bit level I2C Master on a WireBus. It makes its own clock, waits while a Slave stretches
+ * SCL, syncs its clock with other Masters and drops out when it loses arbitration. A lost
+ * transfer is tried again after the STOP.
+ *
+ * Work is a list of queries in the A1C1 format: write LEN MOD CMD DATA, then for a reply poll
+ * READY with one byte reads until the reply is there and read it. A query with no reply is a
+ * write only, e.g. a general call to address 0. A WQ_RAW query has no write and no READY, it
+ * reads replyLen bytes once. WireMasterBus uses these for plain reads.
+ *
+ * revision: 10/17/2026	0.02	ndp		add WQ_RAW reads.
+ * revision: 10/17/2026	0.03	ndp		WQ_MSG_MAX is the Slave input FIFO so a SlaveMaster batch fits.
+ */ 
+
+
+#ifndef WIREMASTER_H_
+#define WIREMASTER_H_
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+#include "WireBus.h"
+
+#define WQ_MSG_MAX		31				// Slave input FIFO. A batch of messages, same as SM_BATCH_MAX.
+#define WQ_REPLY_MAX	31
+#define WQ_POLL_MAX		100
+
+#define WQ_RAW			0x01			// WireQuery flags
+
+struct WireQuery
+{
+	uint8_t		adrs;
+	uint8_t		msg[WQ_MSG_MAX];
+	uint8_t		len;
+	uint8_t		replyLen;				// 0 = write only.
+	uint8_t		flags;
+
+	bool		ok;
+	uint8_t		reply[WQ_REPLY_MAX];
+	uint8_t		polls;					// READY reads that were not ready yet.
+	uint64_t	startNs;				// first START
+	uint64_t	endNs;					// last STOP
+};
+
+class WireMaster : public WireDevice
+{
+public:
+	explicit WireMaster( uint32_t clockHz = 100000 );
+
+	void		queue( const WireQuery& q ) { _queue.push_back( q ); }
+	bool		idle() const { return !_active && _queue.empty(); }
+	const std::vector<WireQuery>& done() const { return _done; }
+
+	virtual void	step( uint64_t ns, bool sda, bool scl, WireEvent ev );
+	virtual bool	sdaOut() const { return _sdaOut; }
+	virtual bool	sclOut() const { return _sclOut; }
+
+	uint32_t	arbitrationLost() const { return _arbLost; }
+	uint32_t	nacks() const { return _nacks; }
+
+private:
+	enum Phase { PH_IDLE, PH_START, PH_LOW, PH_SETUP, PH_RISE, PH_HIGH,
+				 PH_STOP_LOW, PH_STOP_SETUP, PH_STOP_RISE, PH_STOP_HIGH, PH_LOST };
+	enum Stage { STAGE_WRITE, STAGE_POLL, STAGE_READ };
+
+	void	transfer( bool read, const uint8_t* data, uint8_t len );
+	void	transferDone( uint64_t ns );
+	void	finish( uint64_t ns, bool ok );
+	bool	drives() const;
+	bool	bitValue() const;
+	void	nextBit( uint64_t ns );
+	void	stop( uint64_t ns );
+
+	std::deque<WireQuery>	_queue;
+	std::vector<WireQuery>	_done;
+	WireQuery	_cur;
+	bool		_active;
+	bool		_started;
+	Stage		_stage;
+
+	uint32_t	_halfNs;
+	Phase		_phase;
+	uint64_t	_until;
+	bool		_sdaOut;
+	bool		_sclOut;
+	bool		_busBusy;
+	uint64_t	_freeAt;
+
+	bool		_read;
+	uint8_t		_buf[WQ_REPLY_MAX + 1];
+	uint8_t		_len;
+	uint8_t		_byte;					// 0 is the address.
+	uint8_t		_bit;					// 8 is the ACK bit.
+	uint8_t		_shift;
+	bool		_driving;
+	bool		_ack;
+	bool		_xferOk;
+
+	uint32_t	_arbLost;
+	uint32_t	_nacks;
+};
+
+#endif /* WIREMASTER_H_ */
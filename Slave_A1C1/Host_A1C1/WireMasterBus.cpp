@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WireMasterBus.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#include <string.h>
+
+#include "WireMasterBus.h"
+
+/*
+ * Run Q. Returns false if it failed or did not finish in WMB_RUN_MAX_NS.
+ */
+bool WireMasterBus::run( const WireQuery& q, uint8_t* reply )
+{
+	uint64_t end = _bus.now() + WMB_RUN_MAX_NS;
+	size_t count = _master.done().size();
+
+	_master.queue( q );
+	while( !_master.idle() && (_bus.now() < end) )
+	{
+		_bus.step();
+	}
+	if( (_master.done().size() == count) || !_master.done().back().ok )
+	{
+		return false;
+	}
+	if( reply )
+	{
+		memcpy( reply, _master.done().back().reply, q.replyLen );
+	}
+	return true;
+}
+
+/*
+ * WireMaster does not say which byte was NACK'd, so every failure is an address NACK.
+ */
+uint8_t WireMasterBus::write( uint8_t adrs, const uint8_t* data, uint8_t len )
+{
+	WireQuery q;
+
+	if( len > WQ_MSG_MAX )
+	{
+		return SB_ERR_LENGTH;
+	}
+	memset( &q, 0, sizeof(q) );
+	q.adrs = adrs;
+	memcpy( q.msg, data, len );
+	q.len = len;
+	return run( q, 0 ) ? SB_OK : SB_ERR_ADRS_NACK;
+}
+
+uint8_t WireMasterBus::read( uint8_t adrs, uint8_t* data, uint8_t len )
+{
+	WireQuery q;
+
+	if( len > WQ_REPLY_MAX )
+	{
+		len = WQ_REPLY_MAX;
+	}
+	memset( &q, 0, sizeof(q) );
+	q.adrs = adrs;
+	q.replyLen = len;
+	q.flags = WQ_RAW;
+	return run( q, data ) ? len : 0;
+}
+
+void WireMasterBus::delayMs( uint16_t ms )
+{
+	_bus.run( (uint64_t)ms * 1000000 );
+}
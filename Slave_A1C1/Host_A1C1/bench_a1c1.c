@@ -0,0 +1,186 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * bench_a1c1.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Host benchmark of the A1C1 firmware code paths. Times are host ns, so they are only good for
+ * comparing one build of the firmware with another on the same machine, not for AVR cycles.
+ *
+ *   bench_a1c1				run all tests
+ *   -n OPS		rounds per test (default 100000)
+ *   -o FILE	write the JSON report to FILE instead of stdout
+ *
+ * Tests
+ *   twi_rx_byte_ns		TWI_vect for one received data byte and twiReceiveByte().
+ *   msg_write_ns		a six byte GPIO SET from SLA+W to the command being run by access_all().
+ *   msg_rtt_ns			a GPIO READ written, polled for READY and read back with ht_command().
+ *   dispatch_ns		access_dispatch() of a GPIO SET. Module and command look up and the call.
+ *   service_ns			one service_all() pass with no tics set.
+ *
+ * A table goes to stderr for reading.
+ */ 
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <avr/io.h>
+
+#include "host_twi.h"
+#include "service.h"
+#include "access.h"
+#include "twiSlave.h"
+#include "dev_gpio.h"
+
+typedef struct {
+	const char*	name;
+	void		(*run)( void );
+	double		ns;
+} BENCH_TEST;
+
+static const uint8_t gpioSet[ACCESS_MSG_BUFF_SIZE] = { 0xC3, DEV_GPIO_ID, CMD_GPIO_SET, 0x00, 0x00, 0x02 };
+static const uint8_t gpioRead[] = { 0xF0, DEV_GPIO_ID, CMD_GPIO_READ };
+
+static void bench_twiRxByte( void )
+{
+	TWSR = 0x80;
+	TWDR = 0x5A;
+	TWI_vect();
+	(void)twiReceiveByte();
+}
+
+static void bench_msgWrite( void )
+{
+	ht_write( gpioSet, 6 );
+	ht_loop( 6 );
+}
+
+static void bench_msgRtt( void )
+{
+	uint8_t reply[3];
+
+	ht_command( gpioRead, sizeof(gpioRead), reply, sizeof(reply) );
+}
+
+static void bench_dispatch( void )
+{
+	access_dispatch( gpioSet );
+}
+
+static void bench_service( void )
+{
+	GPIOR0 = 0;
+	service_all();
+}
+
+static BENCH_TEST tests[] =
+{
+	{ "twi_rx_byte_ns", bench_twiRxByte, 0 },
+	{ "msg_write_ns", bench_msgWrite, 0 },
+	{ "msg_rtt_ns", bench_msgRtt, 0 },
+	{ "dispatch_ns", bench_dispatch, 0 },
+	{ "service_ns", bench_service, 0 },
+};
+
+#define BENCH_TESTS	( sizeof(tests) / sizeof(tests[0]) )
+
+static double bench_now( void )
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main( int argc, char** argv )
+{
+	long ops = 100000;
+	const char* out = 0;
+	FILE* f = stdout;
+	unsigned t;
+	long i;
+	double start;
+	int opt;
+
+	while( (opt = getopt( argc, argv, "n:o:" )) != -1 )
+	{
+		switch( opt )
+		{
+			case 'n':
+				ops = strtol( optarg, 0, 0 );
+				break;
+			case 'o':
+				out = optarg;
+				break;
+			default:
+				fprintf( stderr, "usage: %s [-n OPS] [-o FILE]\n", argv[0] );
+				return 2;
+		}
+	}
+	if( ops <= 0 )
+	{
+		ops = 1;
+	}
+
+	avr_eeErase();
+	ht_boot();
+
+	fprintf( stderr, "%-16s %10s\n", "test", "ns/op" );
+	for( t=0; t<BENCH_TESTS; ++t )
+	{
+		for( i=0; i<ops/10; ++i )
+		{
+			tests[t].run();					// warm up.
+		}
+		start = bench_now();
+		for( i=0; i<ops; ++i )
+		{
+			tests[t].run();
+		}
+		tests[t].ns = ( bench_now() - start ) / ops;
+		fprintf( stderr, "%-16s %10.1f\n", tests[t].name, tests[t].ns );
+	}
+
+	if( out && (f = fopen( out, "w" )) == 0 )
+	{
+		perror( out );
+		return 1;
+	}
+	fprintf( f, "{\n  \"ops\": %ld,\n  \"results\": {\n", ops );
+	for( t=0; t<BENCH_TESTS; ++t )
+	{
+		fprintf( f, "    \"%s\": %.1f%s\n", tests[t].name, tests[t].ns, ( t + 1 < BENCH_TESTS ) ? "," : "" );
+	}
+	fprintf( f, "  }\n}\n" );
+	if( f != stdout )
+	{
+		fclose( f );
+	}
+
+	return 0;
+}
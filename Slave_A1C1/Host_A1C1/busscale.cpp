@@ -0,0 +1,284 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * busscale.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Bus scaling test. 1 to N host built A1C1 nodes on one simulated I2C bus with one or more
+ * Masters sending GPIO READ queries round robin. Time is virtual, so runs are repeatable and
+ * show what the bus does as nodes are added, not how fast this machine is.
+ *
+ *   busscale				run 1 2 4 8 16 30 nodes
+ *   -k HZ		SCL clock (default 100000)
+ *   -l US		node main loop time (default 20)
+ *   -i US		node TWI ISR time, SCL is held for it (default 4)
+ *   -m N		Masters (default 1)
+ *   -n N		queries per node (default 20)
+ *   -N N		most nodes (default 30)
+ *   -o FILE	write the JSON report to FILE instead of stdout
+ *
+ * For each node count: bus busy time over run time, queries per second, per node query
+ * latency (START of the write to STOP of the reply read) average and worst, round time (how
+ * often each node is read), arbitration losses, SDA collisions and failed queries. A table goes to stderr for reading.
+ */ 
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "WireBus.h"
+#include "WireMaster.h"
+#include "FirmwareNode.h"
+#include "dev_gpio.h"
+
+#define SCALE_BASE_ADRS		0x10
+#define SCALE_RUN_MAX_NS	60000000000ull	// one virtual minute.
+
+struct ScaleResult
+{
+	int			nodes;
+	double		util;
+	double		qps;
+	double		latAvgUs;
+	double		latMaxUs;
+	double		roundUs;
+	uint32_t	arbLost;
+	uint32_t	collisions;
+	uint32_t	errors;
+	double		simMs;
+};
+
+static bool scale_run( int nodes, int masters, int queries, uint32_t clockHz, uint32_t loopNs,
+					   uint32_t isrNs, ScaleResult& r )
+{
+	WireBus bus;
+	std::vector<FirmwareNode*> node;
+	std::vector<WireMaster*> master;
+	std::vector<double> latSum( nodes, 0 );
+	std::vector<uint32_t> latCount( nodes, 0 );
+	WireQuery q;
+	uint64_t startNs;
+	uint64_t busyStart;
+	uint64_t lat;
+	bool idle;
+	bool ok = true;
+	int i;
+	int m;
+
+	for( i=0; i<nodes; ++i )
+	{
+		node.push_back( new FirmwareNode( A1C1_NODE_LIB, SCALE_BASE_ADRS + i, loopNs, isrNs ) );
+		ok = ok && node.back()->ok();
+		node.back()->setIo( 0x23, i );			// PINB
+		bus.attach( node.back() );
+	}
+	for( m=0; m<masters; ++m )
+	{
+		master.push_back( new WireMaster( clockHz ) );
+		bus.attach( master.back() );
+	}
+
+	memset( &q, 0, sizeof(q) );
+	q.msg[0] = 0xF0;
+	q.msg[1] = DEV_GPIO_ID;
+	q.msg[2] = CMD_GPIO_READ;
+	q.len = 3;
+	q.replyLen = 3;
+
+	// One query to each node first, so start up is not part of the numbers.
+	for( i=0; i<nodes; ++i )
+	{
+		q.adrs = SCALE_BASE_ADRS + i;
+		master[i % masters]->queue( q );
+	}
+	do
+	{
+		bus.step();
+		idle = true;
+		for( m=0; m<masters; ++m )
+			idle = idle && master[m]->idle();
+	} while( !idle && bus.now() < SCALE_RUN_MAX_NS );
+
+	startNs = bus.now();
+	busyStart = bus.busyNs();
+	// Counts from start up are taken off at the end.
+	r.arbLost = 0;
+	for( m=0; m<masters; ++m )
+		r.arbLost -= master[m]->arbitrationLost();
+	r.collisions = 0;
+	for( i=0; i<nodes; ++i )
+		r.collisions -= node[i]->collisions();
+
+	// Each Master works through its own share of the nodes round robin.
+	for( int n=0; n<queries; ++n )
+	{
+		for( i=0; i<nodes; ++i )
+		{
+			q.adrs = SCALE_BASE_ADRS + i;
+			master[i % masters]->queue( q );
+		}
+	}
+	do
+	{
+		bus.step();
+		idle = true;
+		for( m=0; m<masters; ++m )
+			idle = idle && master[m]->idle();
+	} while( !idle && bus.now() < SCALE_RUN_MAX_NS );
+
+	r.nodes = nodes;
+	r.simMs = ( bus.now() - startNs ) / 1e6;
+	r.util = (double)( bus.busyNs() - busyStart ) / ( bus.now() - startNs );
+	r.errors = idle ? 0 : 1;
+	r.latMaxUs = 0;
+	for( m=0; m<masters; ++m )
+	{
+		r.arbLost += master[m]->arbitrationLost();
+		for( size_t d=0; d<master[m]->done().size(); ++d )
+		{
+			const WireQuery& w = master[m]->done()[d];
+
+			if( w.startNs < startNs )
+				continue;
+			if( !w.ok || w.reply[0] != w.adrs - SCALE_BASE_ADRS )
+			{
+				++r.errors;
+				continue;
+			}
+			lat = w.endNs - w.startNs;
+			latSum[w.adrs - SCALE_BASE_ADRS] += lat;
+			++latCount[w.adrs - SCALE_BASE_ADRS];
+			if( lat / 1e3 > r.latMaxUs )
+				r.latMaxUs = lat / 1e3;
+		}
+	}
+	r.latAvgUs = 0;
+	for( i=0; i<nodes; ++i )
+	{
+		if( latCount[i] )
+			r.latAvgUs += latSum[i] / latCount[i] / 1e3;
+		r.collisions += node[i]->collisions();
+	}
+	r.latAvgUs /= nodes;
+	r.qps = (double)nodes * queries / ( r.simMs / 1e3 );
+	r.roundUs = r.simMs * 1e3 / queries;
+
+	for( i=0; i<nodes; ++i )
+		delete node[i];
+	for( m=0; m<masters; ++m )
+		delete master[m];
+	return ok;
+}
+
+int main( int argc, char** argv )
+{
+	static const int counts[] = { 1, 2, 4, 8, 16, 30 };
+	std::vector<ScaleResult> results;
+	uint32_t clockHz = 100000;
+	uint32_t loopNs = NODE_LOOP_NS;
+	uint32_t isrNs = NODE_ISR_NS;
+	int masters = 1;
+	int queries = 20;
+	int maxNodes = 30;
+	const char* out = 0;
+	FILE* f = stdout;
+	ScaleResult r;
+	size_t t;
+	int opt;
+
+	while( (opt = getopt( argc, argv, "k:l:i:m:n:N:o:" )) != -1 )
+	{
+		switch( opt )
+		{
+			case 'k':
+				clockHz = strtoul( optarg, 0, 0 );
+				break;
+			case 'l':
+				loopNs = strtoul( optarg, 0, 0 ) * 1000;
+				break;
+			case 'i':
+				isrNs = strtoul( optarg, 0, 0 ) * 1000;
+				break;
+			case 'm':
+				masters = atoi( optarg );
+				break;
+			case 'n':
+				queries = atoi( optarg );
+				break;
+			case 'N':
+				maxNodes = atoi( optarg );
+				break;
+			case 'o':
+				out = optarg;
+				break;
+			default:
+				fprintf( stderr, "usage: %s [-k HZ] [-l US] [-i US] [-m N] [-n N] [-N N] [-o FILE]\n", argv[0] );
+				return 2;
+		}
+	}
+	if( clockHz < 1000 || clockHz > 1000000 || loopNs == 0 || masters < 1 || queries < 1 ||
+		maxNodes < 1 || maxNodes > 112 )
+	{
+		fprintf( stderr, "busscale: bad option value\n" );
+		return 2;
+	}
+
+	fprintf( stderr, "%6s %6s %9s %10s %10s %10s %8s %10s %7s\n", "nodes", "util", "query/s",
+			 "lat_avg_us", "lat_max_us", "round_us", "arb_lost", "collisions", "errors" );
+	for( t=0; t<sizeof(counts)/sizeof(counts[0]) && counts[t] <= maxNodes; ++t )
+	{
+		if( !scale_run( counts[t], masters, queries, clockHz, loopNs, isrNs, r ) )
+		{
+			fprintf( stderr, "busscale: could not load %s\n", A1C1_NODE_LIB );
+			return 1;
+		}
+		fprintf( stderr, "%6d %6.3f %9.1f %10.1f %10.1f %10.1f %8u %10u %7u\n", r.nodes, r.util, r.qps,
+				 r.latAvgUs, r.latMaxUs, r.roundUs, r.arbLost, r.collisions, r.errors );
+		results.push_back( r );
+	}
+
+	if( out && (f = fopen( out, "w" )) == 0 )
+	{
+		perror( out );
+		return 1;
+	}
+	fprintf( f, "{\n  \"clock_hz\": %u,\n  \"loop_us\": %.1f,\n  \"isr_us\": %.1f,\n  \"masters\": %d,\n"
+			 "  \"queries_per_node\": %d,\n  \"results\": [\n", clockHz, loopNs / 1e3, isrNs / 1e3, masters, queries );
+	for( t=0; t<results.size(); ++t )
+	{
+		fprintf( f, "    { \"nodes\": %d, \"bus_util\": %.4f, \"queries_per_s\": %.1f, \"latency_avg_us\": %.1f, "
+				 "\"latency_max_us\": %.1f, \"round_us\": %.1f, \"arbitration_lost\": %u, \"collisions\": %u, \"errors\": %u, "
+				 "\"sim_ms\": %.3f }%s\n", results[t].nodes, results[t].util, results[t].qps, results[t].latAvgUs,
+				 results[t].latMaxUs, results[t].roundUs, results[t].arbLost, results[t].collisions, results[t].errors,
+				 results[t].simMs, ( t + 1 < results.size() ) ? "," : "" );
+	}
+	fprintf( f, "  ]\n}\n" );
+	if( f != stdout )
+		fclose( f );
+
+	return 0;
+}
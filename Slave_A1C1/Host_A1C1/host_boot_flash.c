@@ -0,0 +1,143 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * host_boot_flash.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#include <string.h>
+
+#include "boot_flash.h"
+#include "boot_info.h"
+#include "host_boot_flash.h"
+
+#define HBF_NO_PAGE		0xFFFF
+
+uint8_t		hbf_flash[FLASHEND + 1];
+uint16_t	hbf_errors;
+uint16_t	hbf_erases;
+uint16_t	hbf_writes;
+bool		hbf_appStarted;
+
+static uint8_t	hbf_buffer[SPM_PAGESIZE];
+static uint16_t	hbf_erased;				// page erased and not written yet.
+static uint8_t	hbf_busy;				// bf_busy() calls left.
+static bool		hbf_rwwLocked;
+
+void hbf_reset( void )
+{
+	memset( hbf_flash, 0xFF, sizeof(hbf_flash) );
+	memset( hbf_buffer, 0xFF, sizeof(hbf_buffer) );
+	hbf_errors = 0;
+	hbf_erases = 0;
+	hbf_writes = 0;
+	hbf_appStarted = false;
+	hbf_erased = HBF_NO_PAGE;
+	hbf_busy = 0;
+	hbf_rwwLocked = false;
+}
+
+/*
+ * Check an erase or write can start at ADRS.
+ */
+static bool hbf_start( uint16_t adrs )
+{
+	if( (hbf_busy != 0) || (adrs & (SPM_PAGESIZE - 1)) || (adrs >= BOOT_START) )
+	{
+		++hbf_errors;
+		return false;
+	}
+	hbf_busy = HBF_BUSY_POLLS;
+	hbf_rwwLocked = true;
+	return true;
+}
+
+void bf_fillErase( uint16_t adrs, const uint8_t* data )
+{
+	memcpy( hbf_buffer, data, SPM_PAGESIZE );
+	if( hbf_start( adrs ) )
+	{
+		memset( &hbf_flash[adrs], 0xFF, SPM_PAGESIZE );
+		hbf_erased = adrs;
+		++hbf_erases;
+	}
+}
+
+/*
+ * Flash bits can only be programmed to 0, so a page that was not erased keeps its old 0 bits.
+ */
+void bf_write( uint16_t adrs )
+{
+	uint8_t i;
+
+	if( adrs != hbf_erased )
+	{
+		++hbf_errors;
+	}
+	if( hbf_start( adrs ) )
+	{
+		for( i=0; i<SPM_PAGESIZE; ++i )
+		{
+			hbf_flash[adrs + i] &= hbf_buffer[i];
+		}
+		memset( hbf_buffer, 0xFF, sizeof(hbf_buffer) );		// SPM clears the buffer.
+		hbf_erased = HBF_NO_PAGE;
+		++hbf_writes;
+	}
+}
+
+bool bf_busy()
+{
+	if( hbf_busy != 0 )
+	{
+		--hbf_busy;
+	}
+	return hbf_busy != 0;
+}
+
+void bf_rwwEnable()
+{
+	if( hbf_busy != 0 )
+	{
+		++hbf_errors;
+		return;
+	}
+	hbf_rwwLocked = false;
+}
+
+uint8_t bf_readByte( uint16_t adrs )
+{
+	if( hbf_rwwLocked && (adrs < BOOT_START) )
+	{
+		++hbf_errors;
+		return 0xFF;
+	}
+	return hbf_flash[adrs];
+}
+
+void bf_runApp()
+{
+	hbf_appStarted = true;
+}
@@ -0,0 +1,57 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * host_boot_flash.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Host stand-in for Boot_A1C1 boot_flash.c. The flash is hbf_flash[] in RAM with the SPM page
+ * buffer, a busy time for each erase and write, and the RWW section locked from the erase until
+ * bf_rwwEnable(). Misuse that the AVR would not catch is counted in hbf_errors:
+ *   an erase or write started while busy, a write to a page that was not just erased,
+ *   an address that is not page aligned or is in the boot section, a read of the RWW section
+ *   while it is locked.
+ * bf_runApp() sets hbf_appStarted and returns.
+ */ 
+
+
+#ifndef HOST_BOOT_FLASH_H_
+#define HOST_BOOT_FLASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#define HBF_BUSY_POLLS		20			// bf_busy() calls an erase or a write takes.
+
+extern uint8_t	hbf_flash[FLASHEND + 1];
+extern uint16_t	hbf_errors;
+extern uint16_t	hbf_erases;
+extern uint16_t	hbf_writes;
+extern bool		hbf_appStarted;
+
+void	hbf_reset( void );				// flash all 0xFF, counts 0.
+
+#endif /* HOST_BOOT_FLASH_H_ */
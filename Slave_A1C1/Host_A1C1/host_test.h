@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * host_test.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Checks for the host unit tests. Each test program runs its cases with HT_RUN() and returns
+ * ht_result() from main() for ctest.
+ */ 
+
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+
+static int ht_fails;
+
+#define HT_CHECK(cond)																\
+	do {																			\
+		if( !(cond) ) {																\
+			printf( "%s:%d: FAIL %s\n", __FILE__, __LINE__, #cond );				\
+			++ht_fails;																\
+		}																			\
+	} while( 0 )
+
+#define HT_EQ(actual, expect)														\
+	do {																			\
+		long ht_a = (long)(actual);													\
+		long ht_e = (long)(expect);													\
+		if( ht_a != ht_e ) {														\
+			printf( "%s:%d: FAIL %s = 0x%lX, expected 0x%lX\n",						\
+					__FILE__, __LINE__, #actual, ht_a, ht_e );						\
+			++ht_fails;																\
+		}																			\
+	} while( 0 )
+
+#define HT_RUN(test)																\
+	do {																			\
+		int ht_before = ht_fails;													\
+		test();																		\
+		printf( "%-32s %s\n", #test, ( ht_fails == ht_before ) ? "ok" : "FAILED" );	\
+	} while( 0 )
+
+static inline int ht_result( void )
+{
+	return ( ht_fails == 0 ) ? 0 : 1;
+}
+
+#endif /* HOST_TEST_H_ */
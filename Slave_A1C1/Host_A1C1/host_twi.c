@@ -0,0 +1,182 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * host_twi.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "host_twi.h"
+#include "initialize.h"
+#include "service.h"
+#include "access.h"
+#include "twiSlave.h"
+
+/* TWI status codes. Same values as twiSlave.c */
+#define HT_SRX_ADR_ACK			0x60
+#define HT_SRX_ADR_DATA_ACK		0x80
+#define HT_SRX_STOP_RESTART		0xA0
+#define HT_STX_ADR_ACK			0xA8
+#define HT_STX_DATA_ACK			0xB8
+#define HT_STX_DATA_NACK		0xC0
+
+#define HT_SLAVE_ON		((1<<TWEN)|(1<<TWIE)|(1<<TWEA))
+
+/*
+ * Give the Slave one TWI event.
+ */
+static void ht_event( uint8_t status )
+{
+	TWSR = status;
+	TWCR &= ~(1<<TWINT);
+	TWI_vect();
+}
+
+/*
+ * The Slave only ACKs its address when it is enabled with TWEA set.
+ */
+static bool ht_listening( void )
+{
+	return ( TWCR & HT_SLAVE_ON ) == HT_SLAVE_ON;
+}
+
+void ht_boot( void )
+{
+	avr_reset();
+	twiClearOutput();
+	while( twiDataInReceiveBuffer() )
+	{
+		(void)twiReceiveByte();
+	}
+
+	init_all();
+	while( !init_ready() )
+	{
+		service_all();
+	}
+}
+
+void ht_loop( uint16_t passes )
+{
+	while( passes-- )
+	{
+		service_all();
+		access_all();
+	}
+}
+
+void ht_tick( uint16_t ms )
+{
+	while( ms-- )
+	{
+		TIMER0_COMPA_vect();
+	}
+}
+
+bool ht_write( const uint8_t* data, uint8_t len )
+{
+	uint8_t i;
+
+	if( !ht_listening() )
+	{
+		return false;
+	}
+
+	ht_event( HT_SRX_ADR_ACK );
+	for( i=0; i<len; ++i )
+	{
+		TWDR = data[i];
+		ht_event( HT_SRX_ADR_DATA_ACK );
+	}
+	ht_event( HT_SRX_STOP_RESTART );
+
+	return true;
+}
+
+bool ht_read( uint8_t* data, uint8_t len )
+{
+	uint8_t i;
+
+	if( !ht_listening() )
+	{
+		return false;
+	}
+
+	ht_event( HT_STX_ADR_ACK );
+	for( i=0; i<len; ++i )
+	{
+		data[i] = TWDR;
+		if( i + 1 < len )
+		{
+			ht_event( HT_STX_DATA_ACK );		// Master ACKs all but the last byte.
+		}
+	}
+	ht_event( HT_STX_DATA_NACK );
+
+	return true;
+}
+
+uint8_t ht_command( const uint8_t* msg, uint8_t len, uint8_t* reply, uint8_t max )
+{
+	uint8_t buf[TWI_TX_BUFFER_SIZE + 1];
+	uint8_t count;
+	uint8_t i;
+
+	if( !ht_write( msg, len ) )
+	{
+		return HT_NO_REPLY;
+	}
+
+	for( i=0; i<HT_POLL_MAX; ++i )
+	{
+		ht_loop( 1 );
+		if( twiDataInReceiveBuffer() )
+		{
+			continue;							// not all of the message is taken yet.
+		}
+
+		if( !ht_read( buf, 1 ) )
+		{
+			return HT_NO_REPLY;
+		}
+		count = buf[0];
+		if( count != 0 && count != INIT_BUSY_BYTE )
+		{
+			if( count > max )
+			{
+				count = max;
+			}
+			ht_read( buf, count + 1 );
+			for( i=0; i<count; ++i )
+			{
+				reply[i] = buf[i + 1];
+			}
+			return count;
+		}
+	}
+	return HT_NO_REPLY;
+}
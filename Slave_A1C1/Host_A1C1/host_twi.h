@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * host_twi.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * I2C Master for the host build. Drives TWI_vect with the status codes the TWI hardware would
+ * give, so the firmware sees the same events as on the bus, and runs the main loop.
+ *
+ * ht_boot()						RESET the mock and run init_all() and the staged start up.
+ * ht_loop( passes )				Run service_all() and access_all() like main().
+ * ht_tick( ms )					Run the 1ms Timer0 interrupt.
+ * ht_write( data, len )			SLA+W DATA.. STOP. false if the address is NACK'd.
+ * ht_read( data, len )				SLA+R DATA.. NACK STOP. data[0] is the READY status byte.
+ * ht_command( msg, len, reply )	Write a message, poll READY, read the reply. Returns its length.
+ */ 
+
+
+#ifndef HOST_TWI_H_
+#define HOST_TWI_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HT_POLL_MAX		100			// main loop passes to wait for a reply.
+#define HT_NO_REPLY		0xFF		// ht_command() return when READY stayed 0.
+
+void	ht_boot( void );
+void	ht_loop( uint16_t passes );
+void	ht_tick( uint16_t ms );
+
+bool	ht_write( const uint8_t* data, uint8_t len );
+bool	ht_read( uint8_t* data, uint8_t len );
+uint8_t	ht_command( const uint8_t* msg, uint8_t len, uint8_t* reply, uint8_t max );
+
+#endif /* HOST_TWI_H_ */
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * eeprom.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Host stand-in for <avr/eeprom.h>. The EEPROM is avr_eeprom[]. EEMEM variables are put in
+ * their own section and the section offset is their EEPROM address, the same as .eeprom on
+ * the AVR. Any other pointer is taken as an EEPROM address, e.g. (uint8_t*)E2END.
+ */ 
+
+
+#ifndef MOCK_AVR_EEPROM_H_
+#define MOCK_AVR_EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#define EEMEM	__attribute__((section("avr_eemem")))
+
+#define eeprom_busy_wait()
+#define eeprom_is_ready()	1
+
+uint8_t		eeprom_read_byte( const uint8_t* p );
+uint16_t	eeprom_read_word( const uint16_t* p );
+void		eeprom_read_block( void* dst, const void* src, size_t n );
+void		eeprom_write_byte( uint8_t* p, uint8_t value );
+void		eeprom_write_word( uint16_t* p, uint16_t value );
+void		eeprom_write_block( const void* src, void* dst, size_t n );
+void		eeprom_update_byte( uint8_t* p, uint8_t value );
+void		eeprom_update_word( uint16_t* p, uint16_t value );
+void		eeprom_update_block( const void* src, void* dst, size_t n );
+
+#endif /* MOCK_AVR_EEPROM_H_ */
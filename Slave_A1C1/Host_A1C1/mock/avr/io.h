@@ -0,0 +1,232 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * io.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Host stand-in for <avr/io.h> for the ATmega88A.
+ *
+ * The I/O registers are bytes in avr_io[] at their data space addresses, so the firmware reads
+ * and writes them as usual and a test can set or check them. Only the registers and bits the
+ * A1C1 code uses are here. Two registers act like the hardware so that busy waits end:
+ *   SPSR	SPIF is set on every read. An SPI transfer is done at once.
+ *   ADCSRA	ADSC is cleared on every read. A conversion is done at once. Set ADC first.
+ */ 
+
+
+#ifndef MOCK_AVR_IO_H_
+#define MOCK_AVR_IO_H_
+
+#include <stdint.h>
+
+#include "avr_mock.h"
+
+#define _BV(bit)			(1 << (bit))
+#define _SFR_MEM8(adrs)		(avr_io[adrs])
+#define _SFR_MEM16(adrs)	(*(volatile uint16_t*)&avr_io[adrs])
+
+#define SPM_PAGESIZE	64
+#define RAMEND			0x04FF
+#define FLASHEND		0x1FFF
+#define E2END			0x01FF
+
+/* *** Ports *** */
+#define PINB	_SFR_MEM8(0x23)
+#define DDRB	_SFR_MEM8(0x24)
+#define PORTB	_SFR_MEM8(0x25)
+#define PINC	_SFR_MEM8(0x26)
+#define DDRC	_SFR_MEM8(0x27)
+#define PORTC	_SFR_MEM8(0x28)
+#define PIND	_SFR_MEM8(0x29)
+#define DDRD	_SFR_MEM8(0x2A)
+#define PORTD	_SFR_MEM8(0x2B)
+
+#define PB0		0
+#define PB1		1
+#define PB2		2
+#define PB3		3
+#define PB4		4
+#define PB5		5
+#define PB6		6
+#define PB7		7
+#define PC0		0
+#define PC1		1
+#define PC2		2
+#define PC3		3
+#define PC4		4
+#define PC5		5
+#define PC6		6
+#define PD0		0
+#define PD1		1
+#define PD2		2
+#define PD3		3
+#define PD4		4
+#define PD5		5
+#define PD6		6
+#define PD7		7
+#define PORTC0	0
+#define PORTC1	1
+#define PORTC2	2
+#define PORTC3	3
+
+/* *** Core *** */
+#define TIFR0	_SFR_MEM8(0x35)
+#define TIFR1	_SFR_MEM8(0x36)
+#define TIFR2	_SFR_MEM8(0x37)
+#define PCIFR	_SFR_MEM8(0x3B)
+#define GPIOR0	_SFR_MEM8(0x3E)
+#define EECR	_SFR_MEM8(0x3F)
+#define GPIOR1	_SFR_MEM8(0x4A)
+#define GPIOR2	_SFR_MEM8(0x4B)
+#define MCUSR	_SFR_MEM8(0x54)
+#define MCUCR	_SFR_MEM8(0x55)
+#define SREG	_SFR_MEM8(0x5F)
+#define WDTCSR	_SFR_MEM8(0x60)
+#define PCICR	_SFR_MEM8(0x68)
+#define PCMSK0	_SFR_MEM8(0x6B)
+#define PCMSK1	_SFR_MEM8(0x6C)
+#define PCMSK2	_SFR_MEM8(0x6D)
+
+#define OCF0A	1
+#define OCF0B	2
+#define OCF2A	1
+#define OCF2B	2
+#define EEPE	1
+#define PCIE0	0
+#define PCIE1	1
+#define PCIE2	2
+#define SREG_I	7
+
+/* *** Timer0 *** */
+#define TCCR0A	_SFR_MEM8(0x44)
+#define TCCR0B	_SFR_MEM8(0x45)
+#define TCNT0	_SFR_MEM8(0x46)
+#define OCR0A	_SFR_MEM8(0x47)
+#define OCR0B	_SFR_MEM8(0x48)
+#define TIMSK0	_SFR_MEM8(0x6E)
+
+#define WGM00	0
+#define WGM01	1
+#define TOIE0	0
+#define OCIE0A	1
+#define OCIE0B	2
+
+/* *** Timer1 *** */
+#define TIMSK1	_SFR_MEM8(0x6F)
+#define TCCR1A	_SFR_MEM8(0x80)
+#define TCCR1B	_SFR_MEM8(0x81)
+#define TCNT1	_SFR_MEM16(0x84)
+#define ICR1	_SFR_MEM16(0x86)
+#define OCR1A	_SFR_MEM16(0x88)
+#define OCR1B	_SFR_MEM16(0x8A)
+
+#define WGM10	0
+#define WGM11	1
+#define COM1B0	4
+#define COM1B1	5
+#define COM1A0	6
+#define COM1A1	7
+#define CS10	0
+#define CS11	1
+#define CS12	2
+#define WGM12	3
+#define WGM13	4
+
+/* *** Timer2 *** */
+#define TIMSK2	_SFR_MEM8(0x70)
+#define TCCR2A	_SFR_MEM8(0xB0)
+#define TCCR2B	_SFR_MEM8(0xB1)
+#define TCNT2	_SFR_MEM8(0xB2)
+#define OCR2A	_SFR_MEM8(0xB3)
+#define OCR2B	_SFR_MEM8(0xB4)
+
+#define WGM20	0
+#define WGM21	1
+#define CS20	0
+#define CS21	1
+#define CS22	2
+#define TOIE2	0
+#define OCIE2A	1
+#define OCIE2B	2
+
+/* *** SPI *** */
+#define SPCR	_SFR_MEM8(0x4C)
+#define SPSR	(*avr_spsr())
+#define SPDR	_SFR_MEM8(0x4E)
+
+#define SPR0	0
+#define SPR1	1
+#define CPHA	2
+#define CPOL	3
+#define MSTR	4
+#define DORD	5
+#define SPE		6
+#define SPIE	7
+#define SPI2X	0
+#define SPIF	7
+
+/* *** ADC *** */
+#define ADC		_SFR_MEM16(0x78)
+#define ADCW	_SFR_MEM16(0x78)
+#define ADCL	_SFR_MEM8(0x78)
+#define ADCH	_SFR_MEM8(0x79)
+#define ADCSRA	(*avr_adcsra())
+#define ADCSRB	_SFR_MEM8(0x7B)
+#define ADMUX	_SFR_MEM8(0x7C)
+#define DIDR0	_SFR_MEM8(0x7E)
+
+#define ADPS0	0
+#define ADPS1	1
+#define ADPS2	2
+#define ADIE	3
+#define ADIF	4
+#define ADATE	5
+#define ADSC	6
+#define ADEN	7
+#define ADTS0	0
+#define ADTS1	1
+#define ADTS2	2
+#define ADLAR	5
+#define REFS0	6
+#define REFS1	7
+
+/* *** TWI *** */
+#define TWBR	_SFR_MEM8(0xB8)
+#define TWSR	_SFR_MEM8(0xB9)
+#define TWAR	_SFR_MEM8(0xBA)
+#define TWDR	_SFR_MEM8(0xBB)
+#define TWCR	_SFR_MEM8(0xBC)
+#define TWAMR	_SFR_MEM8(0xBD)
+
+#define TWIE	0
+#define TWEN	2
+#define TWWC	3
+#define TWSTO	4
+#define TWSTA	5
+#define TWEA	6
+#define TWINT	7
+#define TWGCE	0
+
+#endif /* MOCK_AVR_IO_H_ */
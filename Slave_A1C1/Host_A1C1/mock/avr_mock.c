@@ -0,0 +1,141 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * avr_mock.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#include <stdint.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+
+volatile uint8_t	avr_io[AVR_IO_SIZE];
+uint8_t				avr_eeprom[AVR_EE_SIZE] = { [0 ... AVR_EE_SIZE - 1] = 0xFF };
+uint8_t				avr_wdt;
+uint32_t			avr_delayUs;
+
+// Start and end of the EEMEM section. Set by the linker.
+extern char __start_avr_eemem[] __attribute__((weak));
+extern char __stop_avr_eemem[] __attribute__((weak));
+
+void avr_reset( void )
+{
+	memset( (void*)avr_io, 0, sizeof(avr_io) );
+	avr_wdt = 0;
+	avr_delayUs = 0;
+}
+
+void avr_eeErase( void )
+{
+	memset( avr_eeprom, 0xFF, sizeof(avr_eeprom) );
+}
+
+uint16_t avr_eeAddress( const void* p )
+{
+	const char* c = (const char*)p;
+
+	if( (c >= __start_avr_eemem) && (c < __stop_avr_eemem) )
+	{
+		return (uint16_t)(c - __start_avr_eemem);
+	}
+	return (uint16_t)(uintptr_t)p & E2END;
+}
+
+volatile uint8_t* avr_spsr( void )
+{
+	avr_io[0x4D] |= (1<<SPIF);
+	return &avr_io[0x4D];
+}
+
+volatile uint8_t* avr_adcsra( void )
+{
+	avr_io[0x7A] &= ~(1<<ADSC);
+	return &avr_io[0x7A];
+}
+
+/* *** EEPROM *** */
+uint8_t eeprom_read_byte( const uint8_t* p )
+{
+	return avr_eeprom[avr_eeAddress( p )];
+}
+
+uint16_t eeprom_read_word( const uint16_t* p )
+{
+	uint16_t adrs = avr_eeAddress( p );
+
+	return avr_eeprom[adrs] | (avr_eeprom[(adrs + 1) & E2END] << 8);
+}
+
+void eeprom_read_block( void* dst, const void* src, size_t n )
+{
+	uint16_t adrs = avr_eeAddress( src );
+	size_t i;
+
+	for( i=0; i<n; ++i )
+	{
+		((uint8_t*)dst)[i] = avr_eeprom[(adrs + i) & E2END];
+	}
+}
+
+void eeprom_write_byte( uint8_t* p, uint8_t value )
+{
+	avr_eeprom[avr_eeAddress( p )] = value;
+}
+
+void eeprom_write_word( uint16_t* p, uint16_t value )
+{
+	uint16_t adrs = avr_eeAddress( p );
+
+	avr_eeprom[adrs] = (uint8_t)value;
+	avr_eeprom[(adrs + 1) & E2END] = (uint8_t)(value >> 8);
+}
+
+void eeprom_write_block( const void* src, void* dst, size_t n )
+{
+	uint16_t adrs = avr_eeAddress( dst );
+	size_t i;
+
+	for( i=0; i<n; ++i )
+	{
+		avr_eeprom[(adrs + i) & E2END] = ((const uint8_t*)src)[i];
+	}
+}
+
+void eeprom_update_byte( uint8_t* p, uint8_t value )
+{
+	eeprom_write_byte( p, value );
+}
+
+void eeprom_update_word( uint16_t* p, uint16_t value )
+{
+	eeprom_write_word( p, value );
+}
+
+void eeprom_update_block( const void* src, void* dst, size_t n )
+{
+	eeprom_write_block( src, dst, n );
+}
@@ -0,0 +1,63 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * avr_mock.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * State of the host AVR stand-in. avr_reset() is a RESET: the registers are cleared and the
+ * EEPROM is kept. Tests can set or check the registers, EEPROM and watchdog directly.
+ */ 
+
+
+#ifndef AVR_MOCK_H_
+#define AVR_MOCK_H_
+
+#include <stdint.h>
+
+#define AVR_IO_SIZE		0x100
+#define AVR_EE_SIZE		512
+
+extern volatile uint8_t	avr_io[AVR_IO_SIZE];	// I/O registers at their data space addresses.
+extern uint8_t			avr_eeprom[AVR_EE_SIZE];
+extern uint8_t			avr_wdt;				// 0x80 | WDTO_x when enabled.
+extern uint32_t			avr_delayUs;			// total of the _delay_xx() calls.
+
+void	avr_reset( void );						// registers 0. EEPROM is kept.
+void	avr_eeErase( void );					// EEPROM all 0xFF.
+uint16_t avr_eeAddress( const void* p );
+
+volatile uint8_t* avr_spsr( void );
+volatile uint8_t* avr_adcsra( void );
+
+// Interrupt vectors used by the firmware. Call them to run the ISR.
+void	TWI_vect( void );
+void	TIMER0_COMPA_vect( void );
+void	TIMER0_COMPB_vect( void );
+void	TIMER2_COMPA_vect( void );
+void	TIMER2_COMPB_vect( void );
+void	ADC_vect( void );
+void	PCINT2_vect( void );
+
+#endif /* AVR_MOCK_H_ */
@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * node_api.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add node_setUid().
+ */ 
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+
+#include "node_api.h"
+#include "initialize.h"
+#include "service.h"
+#include "access.h"
+#include "config.h"
+#include "i2c_address.h"
+
+extern uint8_t ia_eeUid[IA_UID_SIZE];		// i2c_address.c
+
+void node_boot( uint8_t adrs )
+{
+	avr_reset();
+	if( adrs != 0 )
+	{
+		cfg_init();
+		cfg_set( CFG_KEY_I2C_ADRS, adrs );
+		while( cfg_busy() )
+		{
+			cfg_service();
+		}
+		avr_reset();
+	}
+	init_all();
+}
+
+void node_loop( void )
+{
+	service_all();
+	access_all();
+}
+
+void node_tick( void )
+{
+	TIMER0_COMPA_vect();
+}
+
+void node_twi( uint8_t status, uint8_t data )
+{
+	TWSR = status;
+	TWDR = data;
+	TWI_vect();
+}
+
+uint8_t node_io( uint8_t adrs )
+{
+	return avr_io[adrs];
+}
+
+void node_setIo( uint8_t adrs, uint8_t value )
+{
+	avr_io[adrs] = value;
+}
+
+void node_setUid( const uint8_t* uid )
+{
+	eeprom_update_block( uid, ia_eeUid, IA_UID_SIZE );
+}
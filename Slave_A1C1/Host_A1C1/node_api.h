@@ -0,0 +1,66 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * node_api.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * C entry points of the a1c1_node shared library. Each node of the bus simulator is its own
+ * copy of the library, so every node has its own firmware variables and I/O registers.
+ *
+ * node_boot( adrs )		RESET with the I2C address set in the config store (0 = SLAVE_ADRS)
+ *							and run init_all(). The devices start up in node_loop() as usual.
+ * node_loop()				One main loop pass: service_all() and access_all().
+ * node_tick()				The 1ms Timer0 interrupt.
+ * node_twi( status, data )	TWSR = status, TWDR = data and run TWI_vect.
+ * node_io( adrs )			Read an I/O register (data space address).
+ * node_setIo( adrs, v )	Write an I/O register.
+ * node_setUid( uid )		Write the IA_UID_SIZE byte UID to EEPROM. Used from the next node_boot().
+ *
+ * revision: 10/17/2026	0.02	ndp		add node_setUid().
+ */ 
+
+
+#ifndef NODE_API_H_
+#define NODE_API_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void	node_boot( uint8_t adrs );
+void	node_loop( void );
+void	node_tick( void );
+void	node_twi( uint8_t status, uint8_t data );
+uint8_t	node_io( uint8_t adrs );
+void	node_setIo( uint8_t adrs, uint8_t value );
+void	node_setUid( const uint8_t* uid );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NODE_API_H_ */
@@ -0,0 +1,318 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_access.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * access.c message framing and dispatch, and the FLASH table look ups of flash_table.c.
+ *
+ * revision: 10/17/2026	0.02	ndp		GPIO leaves the module pins alone.
+ * revision: 10/17/2026	0.03	ndp		SEQ SAVE runs in the background.
+ * revision: 10/17/2026	0.04	ndp		Matrix ROWS and XOR check BITMAP against LEN.
+ */ 
+
+#include <string.h>
+
+#include <avr/io.h>
+
+#include "host_test.h"
+#include "host_twi.h"
+#include "sysdefs.h"
+#include "function_tables.h"
+#include "flash_table.h"
+#include "icon_table.h"
+#include "access.h"
+#include "twiSlave.h"
+#include "dev_led_1.h"
+#include "dev_gpio.h"
+#include "dev_adc.h"
+#include "dev_seq.h"
+#include "dev_matrix.h"
+
+#define LED_BIT		(1<<DEV_LED_OUT_PIN)
+
+static const uint8_t ledOn[]  = { 0xF0, DEV_LED_1_ID, CMD_LED_ON };
+static const uint8_t ledOff[] = { 0xF0, DEV_LED_1_ID, CMD_LED_OFF };
+
+static void acc_ledOnOff( void )
+{
+	ht_boot();
+	HT_CHECK( ht_write( ledOn, sizeof(ledOn) ) );
+	ht_loop( sizeof(ledOn) );
+	HT_CHECK( DEV_LED_PORT & LED_BIT );
+
+	HT_CHECK( ht_write( ledOff, sizeof(ledOff) ) );
+	ht_loop( sizeof(ledOff) );
+	HT_CHECK( !(DEV_LED_PORT & LED_BIT) );
+}
+
+static void acc_byteByByte( void )
+{
+	uint8_t i;
+
+	ht_boot();
+	for( i=0; i<sizeof(ledOn); ++i )
+	{
+		HT_CHECK( !(DEV_LED_PORT & LED_BIT) );
+		HT_CHECK( ht_write( &ledOn[i], 1 ) );
+		ht_loop( 2 );
+	}
+	HT_CHECK( DEV_LED_PORT & LED_BIT );
+}
+
+static void acc_badLength( void )
+{
+	const uint8_t bad[] = { 0x33 };			// high nibble is not ~LEN.
+
+	ht_boot();
+	HT_CHECK( ht_write( bad, sizeof(bad) ) );
+	HT_CHECK( ht_write( ledOn, sizeof(ledOn) ) );
+	ht_loop( 10 );
+	HT_CHECK( DEV_LED_PORT & LED_BIT );		// the next message is in sync.
+}
+
+static void acc_unknown( void )
+{
+	const uint8_t noMod[] = { 0xF0, 0xEE, 0x01 };
+	const uint8_t noCmd[] = { 0xF0, DEV_LED_1_ID, 0x7E };
+	uint8_t buf[2];
+
+	ht_boot();
+	HT_CHECK( ht_write( noMod, sizeof(noMod) ) );
+	HT_CHECK( ht_write( noCmd, sizeof(noCmd) ) );
+	HT_CHECK( ht_write( ledOn, sizeof(ledOn) ) );
+	ht_loop( 10 );
+	HT_CHECK( DEV_LED_PORT & LED_BIT );
+
+	// Nothing to read back.
+	HT_CHECK( ht_read( buf, 2 ) );
+	HT_EQ( buf[0], 0 );
+	HT_EQ( buf[1], TWI_UNDERRUN_BYTE );
+}
+
+static void acc_reply( void )
+{
+	const uint8_t read[] = { 0xF0, DEV_GPIO_ID, CMD_GPIO_READ };
+	uint8_t reply[4];
+
+	ht_boot();
+	PINB = 0x5A;
+	PINC = 0x03;
+	PIND = 0xC4;
+	HT_EQ( ht_command( read, sizeof(read), reply, sizeof(reply) ), 3 );
+	HT_EQ( reply[0], 0x5A );
+	HT_EQ( reply[1], 0x03 );
+	HT_EQ( reply[2], 0xC4 );
+}
+
+static void acc_dispatch( void )
+{
+	uint8_t msg[ACCESS_MSG_BUFF_SIZE] = { 0xC3, DEV_GPIO_ID, CMD_GPIO_SET, 0x81, 0xFF, 0x02 };
+
+	ht_boot();
+	HT_CHECK( access_dispatch( msg ) );
+	HT_EQ( PORTB, 0x81 & DEV_GPIO_MASK_B );
+	HT_EQ( PORTC, DEV_GPIO_MASK_C );
+	HT_EQ( PORTD, 0x02 );
+
+	msg[1] = 0xEE;
+	HT_CHECK( !access_dispatch( msg ) );
+	msg[1] = DEV_GPIO_ID;
+	msg[2] = 0x7E;
+	HT_CHECK( !access_dispatch( msg ) );
+}
+
+/*
+ * GPIO INPUT and CLEAR of every pin only reach the free ones. The matrix SPI, the BAM planes,
+ * LED-1 and the ADC inputs keep their set up.
+ */
+static void acc_gpioModulePins( void )
+{
+	uint8_t msg[ACCESS_MSG_BUFF_SIZE] = { 0xC3, DEV_GPIO_ID, CMD_GPIO_INPUT, 0xFF, 0xFF, 0xFF };
+	const uint8_t adc[] = { 0xD2, DEV_ADC_ID, CMD_ADC_CONFIG, 0x03, 0x00 };
+	uint8_t ddrB;
+	uint8_t ddrD;
+
+	ht_boot();
+	HT_CHECK( ht_write( adc, sizeof(adc) ) );
+	ht_loop( sizeof(adc) );
+	HT_EQ( DIDR0, 0x03 );
+
+	DDRC = 0x0F;
+	PORTC = 0x0F;
+	ddrB = DDRB;
+	ddrD = DDRD;
+	HT_EQ( ddrB & DEV_GPIO_USED_MATRIX & ~(1<<PB4), DEV_GPIO_USED_MATRIX & ~(1<<PB4) );
+	HT_CHECK( access_dispatch( msg ) );
+	HT_EQ( DDRB, ddrB & ~DEV_GPIO_MASK_B );
+	HT_EQ( DDRB & DEV_GPIO_USED_MATRIX, ddrB & DEV_GPIO_USED_MATRIX );
+	HT_EQ( DDRD & ((1<<DEV_LED_OUT_PIN) | DEV_LED_BAM_MASK0), ddrD & ((1<<DEV_LED_OUT_PIN) | DEV_LED_BAM_MASK0) );
+	HT_EQ( DDRC, 0x03 );							// PC0:1 are ADC inputs.
+
+	msg[2] = CMD_GPIO_CLEAR;
+	HT_CHECK( access_dispatch( msg ) );
+	HT_EQ( PORTC, 0x03 );
+}
+
+/*
+ * SEQ SAVE returns at once and is written one byte per service pass. STATUS shows
+ * SEQ_STATE_SAVING until AUTORUN is written, and the saved program runs after RESET.
+ */
+static void acc_seqSave( void )
+{
+	const uint8_t load[] = { 0x96, DEV_SEQ_ID, CMD_SEQ_LOAD, 0x00, SEQ_OP_SET, 0x00, DEV_LED_1_ID, CMD_LED_ON, SEQ_OP_END };
+	const uint8_t save[] = { 0xE1, DEV_SEQ_ID, CMD_SEQ_SAVE, 0x01 };
+	const uint8_t status[] = { 0xF0, DEV_SEQ_ID, CMD_SEQ_STATUS };
+	uint8_t reply[2];
+	uint8_t passes;
+
+	ht_boot();
+	HT_CHECK( ht_write( load, sizeof(load) ) );
+	HT_CHECK( ht_write( save, sizeof(save) ) );
+	ht_loop( sizeof(load) + sizeof(save) );
+	HT_EQ( ht_command( status, sizeof(status), reply, sizeof(reply) ), 2 );
+	HT_EQ( reply[0], SEQ_STATE_STOP | SEQ_STATE_SAVING );
+	HT_CHECK( !(DEV_LED_PORT & LED_BIT) );
+
+	for( passes=0; passes<=SEQ_PROG_SIZE; ++passes )
+	{
+		HT_EQ( ht_command( status, sizeof(status), reply, sizeof(reply) ), 2 );
+		if( !(reply[0] & SEQ_STATE_SAVING) )
+			break;
+		ht_loop( 1 );
+	}
+	HT_EQ( reply[0], SEQ_STATE_STOP );
+	HT_CHECK( passes > 1 );
+
+	ht_boot();
+	ht_loop( 2 );
+	HT_CHECK( DEV_LED_PORT & LED_BIT );
+}
+
+/*
+ * Run the matrix ISR for a whole frame and check the COLUMN byte sent for each row.
+ */
+static void acc_matrixShown( const uint8_t* rows )
+{
+	uint8_t i;
+
+	for( i=0; i<8; ++i )
+	{
+		TIMER0_COMPB_vect();
+		HT_EQ( SPDR, rows[i] );
+	}
+}
+
+/*
+ * ROWS and XOR with a data byte for each BITMAP bit change those rows. Too few or too many
+ * data bytes drop the message.
+ */
+static void acc_matrixRows( void )
+{
+	uint8_t msg[ACCESS_MSG_BUFF_SIZE] = { 0x69, DEV_MATRIX_ID, CMD_MATRIX_FRAME, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+	uint8_t rows[8] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+
+	ht_boot();
+	HT_CHECK( access_dispatch( msg ) );
+	acc_matrixShown( rows );
+
+	// BITMAP has two rows, one data byte.
+	msg[0] = 0xD2;
+	msg[2] = CMD_MATRIX_ROWS;
+	msg[3] = 0x05;
+	msg[4] = 0xA0;
+	msg[5] = 0xA2;
+	HT_CHECK( access_dispatch( msg ) );
+	acc_matrixShown( rows );
+
+	// Two rows, two bytes.
+	msg[0] = 0xC3;
+	HT_CHECK( access_dispatch( msg ) );
+	rows[0] = 0xA0;
+	rows[2] = 0xA2;
+	acc_matrixShown( rows );
+
+	// One row, two bytes.
+	msg[2] = CMD_MATRIX_XOR;
+	msg[3] = 0x80;
+	msg[4] = 0xFF;
+	HT_CHECK( access_dispatch( msg ) );
+	acc_matrixShown( rows );
+
+	// One row, one byte.
+	msg[0] = 0xD2;
+	HT_CHECK( access_dispatch( msg ) );
+	rows[7] ^= 0xFF;
+	acc_matrixShown( rows );
+}
+
+static void ft_tables( void )
+{
+	uint8_t index;
+
+	for( index=0; mod_access_table[index].id != 0; ++index )
+	{
+		HT_EQ( flash_get_mod_access_id( index ), mod_access_table[index].id );
+		HT_CHECK( flash_get_mod_function_table( index ) == mod_access_table[index].cmd_table );
+	}
+	HT_EQ( flash_get_mod_access_id( index ), 0 );
+
+	for( index=0; mod_init_table[index].id != 0; ++index )
+	{
+		HT_EQ( flash_get_access_cmd( index, (MOD_FUNCTION_ENTRY*)mod_init_table ), mod_init_table[index].id );
+		HT_CHECK( flash_get_access_func( index, (MOD_FUNCTION_ENTRY*)mod_init_table ) == mod_init_table[index].function );
+	}
+	HT_EQ( flash_get_access_cmd( index, (MOD_FUNCTION_ENTRY*)mod_init_table ), 0 );
+}
+
+static void ft_copy8( void )
+{
+	uint8_t sram[10];
+
+	memset( sram, 0x55, sizeof(sram) );
+	flash_copy8( ICON_SMILE, icon_table, &sram[1] );
+	HT_CHECK( memcmp( &sram[1], &icon_table[ICON_SMILE], 8 ) == 0 );
+	HT_EQ( sram[0], 0x55 );
+	HT_EQ( sram[9], 0x55 );
+}
+
+int main( void )
+{
+	avr_eeErase();
+
+	HT_RUN( acc_ledOnOff );
+	HT_RUN( acc_byteByByte );
+	HT_RUN( acc_badLength );
+	HT_RUN( acc_unknown );
+	HT_RUN( acc_reply );
+	HT_RUN( acc_dispatch );
+	HT_RUN( acc_gpioModulePins );
+	HT_RUN( acc_seqSave );
+	HT_RUN( acc_matrixRows );
+	HT_RUN( ft_tables );
+	HT_RUN( ft_copy8 );
+
+	return ht_result();
+}
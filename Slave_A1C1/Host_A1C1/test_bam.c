@@ -0,0 +1,184 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_bam.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * dev_led_bam against a Timer2 that counts one LSB per step. Checks the interrupt count per
+ * frame that the load table in dev_led_bam.h is based on, and that each channel is ON for
+ * exactly LEVEL of the 255 counts.
+ */ 
+
+#include <string.h>
+
+#include <avr/io.h>
+
+#include "host_test.h"
+#include "host_twi.h"
+#include "dev_led_bam.h"
+
+#define BAM_FRAME		255				// Timer2 counts per frame.
+#define BAM_FRAMES		4
+
+static const uint8_t levels[DEV_LED_BAM_CHANNELS] =
+{
+	0, 0, 1, 37, 128, 200, 254, 255,			// PORT0. Only 2:7 are driven.
+	3, 0, 0, 0, 0, 0, 90, 170					// PORT1. Only 8, 14 and 15 are driven.
+};
+
+static uint8_t	bam_ticks;						// Timer2 count.
+
+static bool bam_driven( uint8_t chan )
+{
+	if( chan < 8 )
+		return DEV_LED_BAM_MASK0 & (1<<chan);
+	return DEV_LED_BAM_MASK1 & (1<<(chan-8));
+}
+
+static bool bam_pin( uint8_t chan )
+{
+	if( chan < 8 )
+		return DEV_LED_BAM_PORT0 & (1<<chan);
+	return DEV_LED_BAM_PORT1 & (1<<(chan-8));
+}
+
+/*
+ * Advance Timer2 one count at a time for ticks counts. The compare ISR runs on a match, like
+ * the hardware with no other interrupt in the way. on[] counts the counts each pin was HIGH.
+ * Returns the number of interrupts.
+ */
+static uint16_t bam_run( uint16_t ticks, uint16_t* on )
+{
+	uint16_t isrs = 0;
+	uint16_t t;
+	uint8_t chan;
+
+	for( t=0; t<ticks; ++t )
+	{
+		TCNT2 = ++bam_ticks;
+		if( (TIMSK2 & (1<<OCIE2B)) && (TCNT2 == OCR2B) )
+		{
+			TIMER2_COMPB_vect();
+			++isrs;
+		}
+		for( chan=0; on && (chan<DEV_LED_BAM_CHANNELS); ++chan )
+		{
+			if( bam_pin( chan ) )
+				++on[chan];
+		}
+	}
+	return isrs;
+}
+
+/*
+ * Boot and load levels[] with two SET ALL messages of 8 levels.
+ */
+static void bam_load( void )
+{
+	uint8_t msg[4+8];
+	uint8_t half;
+
+	ht_boot();
+	bam_ticks = TCNT2;
+	for( half=0; half<2; ++half )
+	{
+		msg[0] = 0x69;								// LEN 9
+		msg[1] = DEV_LED_BAM_ID;
+		msg[2] = CMD_LED_BAM_SET_ALL;
+		msg[3] = half * 8;
+		memcpy( &msg[4], &levels[half * 8], 8 );
+		HT_CHECK( ht_write( msg, sizeof(msg) ) );
+		ht_loop( sizeof(msg) + 2 );
+		bam_run( 2 * BAM_FRAME, 0 );				// the ISR takes the new planes at a frame start.
+		ht_loop( 1 );								// then the service can build the next set.
+	}
+	bam_run( 2 * BAM_FRAME, 0 );
+}
+
+/*
+ * 8 interrupts per frame for 16 channels, and the frame stays 255 counts long.
+ */
+static void bam_isrPerFrame( void )
+{
+	uint8_t start;
+
+	bam_load();
+	start = OCR2B;
+	HT_EQ( bam_run( BAM_FRAMES * BAM_FRAME, 0 ), BAM_FRAMES * 8 );
+	HT_EQ( OCR2B, (uint8_t)(start + BAM_FRAMES * BAM_FRAME) );
+}
+
+/*
+ * Each driven channel is HIGH for LEVEL counts per frame. The others are never driven.
+ */
+static void bam_duty( void )
+{
+	uint16_t on[DEV_LED_BAM_CHANNELS];
+	uint8_t chan;
+
+	bam_load();
+	memset( on, 0, sizeof(on) );
+	bam_run( BAM_FRAMES * BAM_FRAME, on );
+
+	for( chan=0; chan<DEV_LED_BAM_CHANNELS; ++chan )
+	{
+		if( bam_driven( chan ) )
+			HT_EQ( on[chan], BAM_FRAMES * levels[chan] );
+	}
+}
+
+/*
+ * OFF stops the interrupt and clears the pins. ON starts it again at the same levels.
+ */
+static void bam_offOn( void )
+{
+	static const uint8_t off[] = { 0xF0, DEV_LED_BAM_ID, CMD_LED_BAM_OFF };
+	static const uint8_t on[] = { 0xF0, DEV_LED_BAM_ID, CMD_LED_BAM_ON };
+	uint16_t count[DEV_LED_BAM_CHANNELS];
+
+	bam_load();
+	HT_CHECK( ht_write( off, sizeof(off) ) );
+	ht_loop( sizeof(off) );
+	memset( count, 0, sizeof(count) );
+	HT_EQ( bam_run( BAM_FRAME, count ), 0 );
+	HT_EQ( count[7], 0 );
+
+	HT_CHECK( ht_write( on, sizeof(on) ) );
+	ht_loop( sizeof(on) );
+	bam_run( 2 * BAM_FRAME, 0 );
+	memset( count, 0, sizeof(count) );
+	HT_EQ( bam_run( BAM_FRAME, count ), 8 );
+	HT_EQ( count[7], levels[7] );
+	HT_EQ( count[5], levels[5] );
+}
+
+int main( void )
+{
+	HT_RUN( bam_isrPerFrame );
+	HT_RUN( bam_duty );
+	HT_RUN( bam_offOn );
+
+	return ht_result();
+}
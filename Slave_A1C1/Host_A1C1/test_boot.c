@@ -0,0 +1,430 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_boot.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Boot_A1C1 bootloader.c against the RAM flash of host_boot_flash.c. The Master side streams
+ * images with ADDR DATA FLUSH the way a loader would, checking STATUS READY before each page,
+ * then checks CRC and RUN.
+ */ 
+
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+
+#include "host_test.h"
+#include "host_boot_flash.h"
+#include "boot_info.h"
+#include "bootloader.h"
+#include "i2c_address.h"
+#include "twiSlave.h"
+
+/* TWI status codes. Same values as twiSlave.c */
+#define BT_SRX_ADR_ACK			0x60
+#define BT_SRX_ADR_DATA_ACK		0x80
+#define BT_SRX_STOP_RESTART		0xA0
+#define BT_STX_ADR_ACK			0xA8
+#define BT_STX_DATA_ACK			0xB8
+#define BT_STX_DATA_NACK		0xC0
+
+#define BT_LOOP_MAX			2000		// main loop passes to wait for the Slave.
+#define BT_IMAGE_SIZE		1000		// not a whole number of pages.
+
+static uint8_t	bt_image[BOOT_START];
+static uint16_t	bt_overlaps;			// STATUS seen READY while a page was being written.
+
+static void bt_event( uint8_t status )
+{
+	TWSR = status;
+	TWI_vect();
+}
+
+static void bt_loop( void )
+{
+	bl_service();
+	bl_access();
+}
+
+static void bt_reset( void )
+{
+	avr_reset();
+	avr_eeErase();
+	hbf_reset();
+	twiSlaveInit( SLAVE_ADRS );
+	bl_init();
+	twiSlaveEnable();
+	twiClearOutput();
+	while( twiDataInReceiveBuffer() )
+	{
+		(void)twiReceiveByte();
+	}
+	bt_overlaps = 0;
+}
+
+/*
+ * Write one BOOT_ID message and run the main loop until all of it is taken.
+ */
+static void bt_send( uint8_t cmd, const uint8_t* data, uint8_t len )
+{
+	uint8_t msg[BOOT_MSG_BUFF_SIZE];
+	uint16_t passes;
+	uint8_t i;
+
+	msg[0] = (uint8_t)((~len << 4) & 0xF0) | len;
+	msg[1] = BOOT_ID;
+	msg[2] = cmd;
+	memcpy( &msg[3], data, len );
+
+	bt_event( BT_SRX_ADR_ACK );
+	for( i=0; i<len + 3; ++i )
+	{
+		TWDR = msg[i];
+		bt_event( BT_SRX_ADR_DATA_ACK );
+	}
+	bt_event( BT_SRX_STOP_RESTART );
+
+	for( passes=0; twiDataInReceiveBuffer() && (passes < BT_LOOP_MAX); ++passes )
+	{
+		bt_loop();
+	}
+	HT_CHECK( !twiDataInReceiveBuffer() );
+}
+
+static void bt_read( uint8_t* data, uint8_t len )
+{
+	uint8_t i;
+
+	bt_event( BT_STX_ADR_ACK );
+	for( i=0; i<len; ++i )
+	{
+		data[i] = TWDR;
+		if( i + 1 < len )
+		{
+			bt_event( BT_STX_DATA_ACK );
+		}
+	}
+	bt_event( BT_STX_DATA_NACK );
+}
+
+/*
+ * Send a command and read its LEN byte reply.
+ */
+static void bt_query( uint8_t cmd, const uint8_t* data, uint8_t len, uint8_t* reply, uint8_t replyLen )
+{
+	uint8_t buf[TWI_TX_BUFFER_SIZE + 1];
+	uint16_t passes;
+
+	bt_send( cmd, data, len );
+	for( passes=0; passes < BT_LOOP_MAX; ++passes )
+	{
+		bt_read( buf, 1 );
+		if( buf[0] != 0 )
+		{
+			break;
+		}
+		bt_loop();
+	}
+	HT_EQ( buf[0], replyLen );
+	bt_read( buf, replyLen + 1 );
+	memcpy( reply, &buf[1], replyLen );
+}
+
+/*
+ * Poll STATUS until a page can be sent. Returns the ERROR byte.
+ */
+static uint8_t bt_waitReady( void )
+{
+	uint8_t status[4];
+	uint16_t passes;
+
+	for( passes=0; passes < BT_LOOP_MAX; ++passes )
+	{
+		bt_query( CMD_BOOT_STATUS, 0, 0, status, 4 );
+		if( status[0] & BOOT_STATE_READY )
+		{
+			if( status[0] & BOOT_STATE_BUSY )
+			{
+				++bt_overlaps;
+			}
+			return status[1];
+		}
+		bt_loop();
+	}
+	HT_CHECK( 0 );
+	return 0xFF;
+}
+
+/*
+ * ADDR then DATA in BOOT_DATA_MAX pieces, then FLUSH for a partial last page.
+ */
+static void bt_load( uint16_t adrs, const uint8_t* image, uint16_t len )
+{
+	uint8_t data[2];
+	uint16_t i;
+	uint8_t count;
+
+	data[0] = (uint8_t)adrs;
+	data[1] = adrs >> 8;
+	bt_send( CMD_BOOT_ADDR, data, 2 );
+
+	for( i=0; i<len; i+=count )
+	{
+		if( (i & (SPM_PAGESIZE - 1)) == 0 )
+		{
+			HT_EQ( bt_waitReady(), 0 );
+		}
+		count = (len - i < BOOT_DATA_MAX) ? (uint8_t)(len - i) : BOOT_DATA_MAX;
+		bt_send( CMD_BOOT_DATA, &image[i], count );
+	}
+	bt_send( CMD_BOOT_FLUSH, 0, 0 );
+}
+
+/*
+ * CRC-16/XMODEM one bit at a time, to check the table free version in bootloader.c.
+ */
+static uint16_t bt_crc( const uint8_t* data, uint16_t len )
+{
+	uint16_t crc = 0;
+	uint16_t i;
+	uint8_t bit;
+
+	for( i=0; i<len; ++i )
+	{
+		crc ^= (uint16_t)data[i] << 8;
+		for( bit=0; bit<8; ++bit )
+		{
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+static void bt_makeImage( uint8_t seed )
+{
+	uint16_t i;
+
+	for( i=0; i<sizeof(bt_image); ++i )
+	{
+		bt_image[i] = (uint8_t)(i * 37 + (i >> 8) + seed);
+	}
+}
+
+static uint16_t bt_slaveCrc( uint16_t len )
+{
+	uint8_t data[2];
+	uint8_t reply[2];
+
+	data[0] = (uint8_t)len;
+	data[1] = len >> 8;
+	bt_query( CMD_BOOT_CRC, data, 2, reply, 2 );
+	return reply[0] | (reply[1] << 8);
+}
+
+static void bt_run( uint16_t len, uint16_t crc )
+{
+	uint8_t data[4];
+
+	data[0] = (uint8_t)len;
+	data[1] = len >> 8;
+	data[2] = (uint8_t)crc;
+	data[3] = crc >> 8;
+	bt_send( CMD_BOOT_RUN, data, 4 );
+}
+
+/*
+ * A multi-page image with a partial last page. Pages are received while the one before is
+ * written.
+ */
+static void boot_image( void )
+{
+	uint8_t status[4];
+	uint16_t pages = (BT_IMAGE_SIZE + SPM_PAGESIZE - 1) / SPM_PAGESIZE;
+	uint16_t i;
+
+	bt_reset();
+	bt_makeImage( 1 );
+	bt_load( 0, bt_image, BT_IMAGE_SIZE );
+
+	HT_EQ( bt_slaveCrc( BT_IMAGE_SIZE ), bt_crc( bt_image, BT_IMAGE_SIZE ) );
+	HT_CHECK( memcmp( hbf_flash, bt_image, BT_IMAGE_SIZE ) == 0 );
+	for( i=BT_IMAGE_SIZE; i<pages * SPM_PAGESIZE; ++i )
+	{
+		HT_EQ( hbf_flash[i], 0xFF );					// FLUSH fill.
+	}
+	HT_EQ( hbf_flash[pages * SPM_PAGESIZE], 0xFF );
+	HT_EQ( hbf_erases, pages );
+	HT_EQ( hbf_writes, pages );
+	HT_EQ( hbf_errors, 0 );
+	HT_CHECK( bt_overlaps != 0 );
+
+	bt_query( CMD_BOOT_STATUS, 0, 0, status, 4 );
+	HT_EQ( status[0], BOOT_STATE_READY );
+	HT_EQ( status[1], 0 );
+}
+
+/*
+ * A second load over part of the first. The pages it covers are erased again, the others kept.
+ */
+static void boot_overlap( void )
+{
+	uint8_t first[4 * SPM_PAGESIZE];
+
+	bt_reset();
+	bt_makeImage( 1 );
+	memcpy( first, bt_image, sizeof(first) );
+	bt_load( 0, first, sizeof(first) );
+
+	bt_makeImage( 0x5A );
+	bt_load( SPM_PAGESIZE, bt_image, 2 * SPM_PAGESIZE );
+	bt_slaveCrc( 0 );								// wait for the last page.
+
+	HT_CHECK( memcmp( &hbf_flash[0], &first[0], SPM_PAGESIZE ) == 0 );
+	HT_CHECK( memcmp( &hbf_flash[SPM_PAGESIZE], bt_image, 2 * SPM_PAGESIZE ) == 0 );
+	HT_CHECK( memcmp( &hbf_flash[3 * SPM_PAGESIZE], &first[3 * SPM_PAGESIZE], SPM_PAGESIZE ) == 0 );
+	HT_EQ( hbf_writes, 6 );
+	HT_EQ( hbf_errors, 0 );
+}
+
+/*
+ * RUN with the right CRC saves the check values and starts the application.
+ */
+static void boot_runPass( void )
+{
+	uint16_t crc;
+
+	bt_reset();
+	eeprom_write_byte( (uint8_t*)BOOT_EE_REQUEST, BOOT_REQUEST );
+	bt_makeImage( 2 );
+	bt_load( 0, bt_image, BT_IMAGE_SIZE );
+	crc = bt_crc( bt_image, BT_IMAGE_SIZE );
+
+	bt_run( BT_IMAGE_SIZE, crc );
+	HT_CHECK( hbf_appStarted );
+	HT_EQ( eeprom_read_word( (uint16_t*)BOOT_EE_LEN ), BT_IMAGE_SIZE );
+	HT_EQ( eeprom_read_word( (uint16_t*)BOOT_EE_CRC ), crc );
+	HT_EQ( eeprom_read_byte( (uint8_t*)BOOT_EE_REQUEST ), 0xFF );
+	HT_CHECK( bl_appValid() );
+	HT_EQ( hbf_errors, 0 );
+}
+
+/*
+ * RUN with a bad CRC stays in the bootloader with BOOT_ERR_CRC and leaves the EEPROM alone.
+ */
+static void boot_runFail( void )
+{
+	uint8_t status[4];
+
+	bt_reset();
+	eeprom_write_byte( (uint8_t*)BOOT_EE_REQUEST, BOOT_REQUEST );
+	bt_makeImage( 2 );
+	bt_load( 0, bt_image, BT_IMAGE_SIZE );
+
+	bt_run( BT_IMAGE_SIZE, bt_crc( bt_image, BT_IMAGE_SIZE ) ^ 0x0001 );
+	HT_CHECK( !hbf_appStarted );
+	bt_query( CMD_BOOT_STATUS, 0, 0, status, 4 );
+	HT_EQ( status[1], BOOT_ERR_CRC );
+	HT_EQ( eeprom_read_word( (uint16_t*)BOOT_EE_LEN ), 0xFFFF );
+	HT_EQ( eeprom_read_word( (uint16_t*)BOOT_EE_CRC ), 0xFFFF );
+	HT_EQ( eeprom_read_byte( (uint8_t*)BOOT_EE_REQUEST ), BOOT_REQUEST );
+
+	bt_run( BOOT_START + SPM_PAGESIZE, 0 );			// past the application section.
+	HT_CHECK( !hbf_appStarted );
+}
+
+/*
+ * The RESET check of the EEPROM record.
+ */
+static void boot_appValid( void )
+{
+	bt_reset();
+	HT_CHECK( !bl_appValid() );						// erased.
+
+	bt_makeImage( 3 );
+	bt_load( 0, bt_image, BT_IMAGE_SIZE );
+	bt_slaveCrc( 0 );								// wait for the last page.
+	HT_CHECK( bl_appValid() );						// no record, loaded by ISP.
+
+	bt_run( BT_IMAGE_SIZE, bt_crc( bt_image, BT_IMAGE_SIZE ) );
+	HT_CHECK( bl_appValid() );
+
+	hbf_flash[BT_IMAGE_SIZE - 1] ^= 0x10;
+	HT_CHECK( !bl_appValid() );
+	hbf_flash[BT_IMAGE_SIZE - 1] ^= 0x10;
+
+	eeprom_write_word( (uint16_t*)BOOT_EE_LEN, BOOT_START + 1 );
+	HT_CHECK( !bl_appValid() );
+}
+
+/*
+ * ADDR and DATA that the bootloader refuses.
+ */
+static void boot_badAddress( void )
+{
+	uint8_t status[4];
+	uint8_t data[2];
+	uint8_t i;
+
+	bt_reset();
+	data[0] = (uint8_t)BOOT_START;
+	data[1] = BOOT_START >> 8;
+	bt_send( CMD_BOOT_ADDR, data, 2 );
+	bt_query( CMD_BOOT_STATUS, 0, 0, status, 4 );
+	HT_EQ( status[1], BOOT_ERR_ADRS );
+
+	data[0] = 0x41;
+	data[1] = 0x00;
+	bt_send( CMD_BOOT_ADDR, data, 2 );
+	bt_query( CMD_BOOT_STATUS, 0, 0, status, 4 );
+	HT_EQ( status[1], BOOT_ERR_ADRS );
+
+	// 60 bytes then 8 more crosses the page.
+	data[0] = 0;
+	bt_send( CMD_BOOT_ADDR, data, 2 );
+	for( i=0; i<7; ++i )
+	{
+		bt_send( CMD_BOOT_DATA, bt_image, BOOT_DATA_MAX );
+	}
+	bt_send( CMD_BOOT_DATA, bt_image, 4 );
+	bt_send( CMD_BOOT_DATA, bt_image, BOOT_DATA_MAX );
+	bt_query( CMD_BOOT_STATUS, 0, 0, status, 4 );
+	HT_EQ( status[1], BOOT_ERR_ALIGN );
+	HT_EQ( hbf_writes, 0 );
+	HT_EQ( hbf_errors, 0 );
+}
+
+int main( void )
+{
+	HT_RUN( boot_image );
+	HT_RUN( boot_overlap );
+	HT_RUN( boot_runPass );
+	HT_RUN( boot_runFail );
+	HT_RUN( boot_appValid );
+	HT_RUN( boot_badAddress );
+
+	return ht_result();
+}
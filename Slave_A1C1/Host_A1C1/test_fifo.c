@@ -0,0 +1,216 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_fifo.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * twiSlave.c FIFO watermark events and reads framed by READY. Built with only the driver and the mock,
+ * with TWI_RX_HIGH_WATER and TWI_TX_LOW_WATER set by CMakeLists.txt.
+ */ 
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "host_test.h"
+#include "twiSlave.h"
+
+/* TWI status codes. Same values as twiSlave.c */
+#define FT_SRX_ADR_ACK			0x60
+#define FT_SRX_ADR_DATA_ACK		0x80
+#define FT_SRX_STOP_RESTART		0xA0
+#define FT_STX_ADR_ACK			0xA8
+#define FT_STX_DATA_ACK			0xB8
+#define FT_STX_DATA_NACK		0xC0
+
+#define FT_STREAM_CHUNK		16			// bytes the producer adds on each TX_LOW.
+
+static uint8_t ft_next;					// next byte the producer makes.
+
+static void ft_event( uint8_t status )
+{
+	TWSR = status;
+	TWI_vect();
+}
+
+static void ft_reset( void )
+{
+	avr_reset();
+	twiSlaveInit( 0x40 );
+	twiSlaveEnable();
+	twiClearOutput();
+	while( twiDataInReceiveBuffer() )
+	{
+		(void)twiReceiveByte();
+	}
+	(void)twiGetEvents();
+	ft_next = 0;
+}
+
+/*
+ * Stand-in for a streaming producer such as ADC readout.
+ */
+static void ft_produce( void )
+{
+	uint8_t i;
+
+	for( i=0; i<FT_STREAM_CHUNK; ++i )
+	{
+		twiTransmitByte( ft_next++ );
+	}
+	twiTransmitReady();
+}
+
+static void fifo_rxHigh( void )
+{
+	uint8_t i;
+
+	ft_reset();
+	ft_event( FT_SRX_ADR_ACK );
+	for( i=0; i<TWI_RX_HIGH_WATER - 1; ++i )
+	{
+		TWDR = i;
+		ft_event( FT_SRX_ADR_DATA_ACK );
+	}
+	HT_EQ( twiRxCount(), TWI_RX_HIGH_WATER - 1 );
+	HT_EQ( twiGetEvents(), 0 );
+
+	TWDR = i;
+	ft_event( FT_SRX_ADR_DATA_ACK );
+	HT_EQ( twiRxCount(), TWI_RX_HIGH_WATER );
+	HT_EQ( twiGetEvents(), TWI_EVENT_RX_HIGH );
+	HT_EQ( twiGetEvents(), 0 );					// read clears it.
+
+	// Once per crossing. More bytes do not raise it again.
+	TWDR = 0x55;
+	ft_event( FT_SRX_ADR_DATA_ACK );
+	ft_event( FT_SRX_STOP_RESTART );
+	HT_EQ( twiGetEvents(), 0 );
+
+	// Drained and filled again.
+	while( twiDataInReceiveBuffer() )
+	{
+		(void)twiReceiveByte();
+	}
+	HT_EQ( twiRxCount(), 0 );
+	ft_event( FT_SRX_ADR_ACK );
+	for( i=0; i<TWI_RX_HIGH_WATER; ++i )
+	{
+		TWDR = i;
+		ft_event( FT_SRX_ADR_DATA_ACK );
+	}
+	ft_event( FT_SRX_STOP_RESTART );
+	HT_EQ( twiGetEvents(), TWI_EVENT_RX_HIGH );
+}
+
+static void fifo_txLow( void )
+{
+	uint8_t i;
+
+	ft_reset();
+	ft_produce();
+	HT_EQ( twiTxCount(), FT_STREAM_CHUNK );
+
+	ft_event( FT_STX_ADR_ACK );
+	HT_EQ( TWDR, FT_STREAM_CHUNK );				// READY
+	for( i=0; i<FT_STREAM_CHUNK - TWI_TX_LOW_WATER - 1; ++i )
+	{
+		ft_event( FT_STX_DATA_ACK );
+		HT_EQ( TWDR, i );
+	}
+	HT_EQ( twiGetEvents(), 0 );
+	ft_event( FT_STX_DATA_ACK );
+	HT_EQ( twiTxCount(), TWI_TX_LOW_WATER );
+	HT_EQ( twiGetEvents(), TWI_EVENT_TX_LOW );
+	ft_event( FT_STX_DATA_NACK );
+}
+
+static void fifo_refill( void )
+{
+	uint16_t n;
+	uint8_t ready;
+	uint8_t i;
+
+	// Read four times the FIFO size over several reads. The producer tops up on TX_LOW.
+	ft_reset();
+	ft_produce();
+	n = 0;
+	while( n < 4*TWI_TX_BUFFER_SIZE )
+	{
+		ft_event( FT_STX_ADR_ACK );
+		ready = TWDR;
+		HT_CHECK( ready != 0 );
+		for( i=0; i<ready; ++i )
+		{
+			ft_event( FT_STX_DATA_ACK );
+			HT_EQ( TWDR, (uint8_t)n );
+			++n;
+			if( twiGetEvents() & TWI_EVENT_TX_LOW )
+			{
+				ft_produce();
+			}
+		}
+		// Made ready during this read, but past READY. Only the underrun byte is sent.
+		ft_event( FT_STX_DATA_ACK );
+		HT_EQ( TWDR, TWI_UNDERRUN_BYTE );
+		ft_event( FT_STX_DATA_NACK );
+	}
+
+	// The producer stops. The last read runs out into the underrun byte.
+	ft_event( FT_STX_ADR_ACK );
+	ready = TWDR;
+	for( i=0; i<ready; ++i )
+	{
+		ft_event( FT_STX_DATA_ACK );
+		HT_EQ( TWDR, (uint8_t)n );
+		++n;
+	}
+	ft_event( FT_STX_DATA_ACK );
+	HT_EQ( TWDR, TWI_UNDERRUN_BYTE );
+	ft_event( FT_STX_DATA_NACK );
+	HT_EQ( twiTxCount(), 0 );
+}
+
+static void fifo_notReady( void )
+{
+	// Data not marked ready is not sent.
+	ft_reset();
+	twiTransmitByte( 0x11 );
+	ft_event( FT_STX_ADR_ACK );
+	HT_EQ( TWDR, 0 );
+	ft_event( FT_STX_DATA_ACK );
+	HT_EQ( TWDR, TWI_UNDERRUN_BYTE );
+	ft_event( FT_STX_DATA_NACK );
+	HT_EQ( twiTxCount(), 1 );
+}
+
+int main( void )
+{
+	HT_RUN( fifo_rxHigh );
+	HT_RUN( fifo_txLow );
+	HT_RUN( fifo_refill );
+	HT_RUN( fifo_notReady );
+
+	return ht_result();
+}
@@ -0,0 +1,157 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_init.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Staged start up, boot profile and the configuration store across a RESET.
+ */ 
+
+#include <avr/io.h>
+
+#include "host_test.h"
+#include "host_twi.h"
+#include "sysdefs.h"
+#include "function_tables.h"
+#include "initialize.h"
+#include "service.h"
+#include "access.h"
+#include "twiSlave.h"
+#include "config.h"
+#include "dev_led_1.h"
+
+static uint8_t init_devices( void )
+{
+	uint8_t count = 0;
+
+	while( mod_init_table[count].id != 0 )
+	{
+		++count;
+	}
+	return count;
+}
+
+static void init_staged( void )
+{
+	const uint8_t ledOn[] = { 0xF0, DEV_LED_1_ID, CMD_LED_ON };
+	uint8_t buf[3];
+
+	avr_reset();
+	init_all();
+	HT_CHECK( !init_ready() );
+
+	// The Slave answers at once but is BUSY and holds messages.
+	HT_CHECK( ht_write( ledOn, sizeof(ledOn) ) );
+	HT_CHECK( ht_read( buf, 3 ) );
+	HT_EQ( buf[0], 0 );
+	HT_EQ( buf[1], INIT_BUSY_BYTE );
+	HT_EQ( buf[2], INIT_BUSY_BYTE );
+	access_all();
+	HT_CHECK( twiDataInReceiveBuffer() );
+
+	// One device per pass.
+	ht_loop( init_devices() );
+	HT_CHECK( !init_ready() );
+	ht_loop( 1 );
+	HT_CHECK( init_ready() );
+
+	ht_loop( sizeof(ledOn) );
+	HT_CHECK( DEV_LED_PORT & (1<<DEV_LED_OUT_PIN) );
+	HT_CHECK( ht_read( buf, 2 ) );
+	HT_EQ( buf[1], TWI_UNDERRUN_BYTE );
+}
+
+static void init_statusCmd( void )
+{
+	const uint8_t status[] = { 0xF0, INIT_ID, CMD_INIT_STATUS };
+	uint8_t reply[6];
+
+	ht_boot();
+	HT_EQ( ht_command( status, sizeof(status), reply, sizeof(reply) ), 6 );
+	HT_EQ( reply[0], 1 );
+	HT_EQ( reply[1], init_devices() );
+}
+
+static void init_profileCmd( void )
+{
+	const uint8_t first[] = { 0xE1, INIT_ID, CMD_INIT_PROFILE, 0 };
+	const uint8_t last[] = { 0xE1, INIT_ID, CMD_INIT_PROFILE, 2 };
+	uint8_t reply[31];
+	uint8_t devices = init_devices();
+	uint8_t i;
+
+	ht_boot();
+	HT_EQ( ht_command( first, sizeof(first), reply, sizeof(reply) ), 1 + 3 * devices );
+	HT_EQ( reply[0], devices );
+	for( i=0; i<devices; ++i )
+	{
+		HT_EQ( reply[1 + 3*i], mod_init_table[i].id );
+	}
+
+	HT_EQ( ht_command( last, sizeof(last), reply, sizeof(reply) ), 1 + 3 * (devices - 2) );
+	HT_EQ( reply[1], mod_init_table[2].id );
+}
+
+static void init_configKept( void )
+{
+	const uint8_t set[] = { 0xC3, CONFIG_ID, CMD_CFG_SET, CFG_KEY_GLOW_RATE, 0x34, 0x12 };
+	const uint8_t get[] = { 0xE1, CONFIG_ID, CMD_CFG_GET, CFG_KEY_GLOW_RATE };
+	uint8_t reply[3];
+	uint16_t passes = 0;
+
+	avr_eeErase();
+	ht_boot();
+	HT_CHECK( ht_write( set, sizeof(set) ) );
+	ht_loop( sizeof(set) );
+	while( cfg_busy() && ++passes < 100 )
+	{
+		ht_loop( 1 );
+	}
+	HT_CHECK( !cfg_busy() );
+
+	// RESET. The setting is read back from EEPROM.
+	ht_boot();
+	HT_EQ( ht_command( get, sizeof(get), reply, sizeof(reply) ), 3 );
+	HT_EQ( reply[0], 0x34 );
+	HT_EQ( reply[1], 0x12 );
+	HT_EQ( reply[2], 1 );
+
+	avr_eeErase();
+	ht_boot();
+	HT_EQ( ht_command( get, sizeof(get), reply, sizeof(reply) ), 3 );
+	HT_EQ( reply[2], 0 );
+}
+
+int main( void )
+{
+	avr_eeErase();
+
+	HT_RUN( init_staged );
+	HT_RUN( init_statusCmd );
+	HT_RUN( init_profileCmd );
+	HT_RUN( init_configKept );
+
+	return ht_result();
+}
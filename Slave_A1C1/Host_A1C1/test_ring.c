@@ -0,0 +1,262 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_ring.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * ring.h stress test. The producer and the consumer run on two threads with the host acquire
+ * and release atomics. One side stands in for the ISR: it holds irqLock while it runs, like
+ * an ISR that can not start inside RING_ATOMIC, which takes the same lock here. The other side
+ * runs free, so ringPut() and ringTake() are only ever ordered by the ring indices.
+ *
+ * Each byte is the low 8 bits of a running count, so the consumer can check that every byte
+ * comes once and in order. A clear may drop bytes. The producer counts its clears inside
+ * RING_ATOMIC, so the consumer knows when a gap is allowed.
+ */ 
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "host_test.h"
+
+static pthread_mutex_t irqLock = PTHREAD_MUTEX_INITIALIZER;
+
+#define RING_ATOMIC																	\
+	for( int rt_once = ( pthread_mutex_lock( &irqLock ), 1 ); rt_once;				\
+		 rt_once = ( pthread_mutex_unlock( &irqLock ), 0 ) )
+
+#include "ring.h"
+
+#define RT_SIZE			16					// small, so it wraps and fills often.
+#define RT_MASK			( RT_SIZE - 1 )
+#define RT_BYTES		2000000UL
+#define RT_CLEAR_EVERY	10007				// puts or takes between clears.
+
+static uint8_t			rtBuf[ RT_SIZE ];
+static RING				rtRing;
+static bool				rtDone;				// producer finished. Atomic.
+static unsigned long	rtClears;			// changed inside RING_ATOMIC only.
+
+typedef struct {
+	bool			isr;					// this side holds irqLock while it runs.
+	bool			clears;					// producer clears in RING_ATOMIC, consumer with ringDrop().
+	unsigned long	count;					// bytes put or taken.
+	unsigned long	fails;					// consumer: out of order bytes.
+	unsigned long	gaps;					// consumer: bytes dropped by a clear.
+	unsigned		maxCount;				// largest ringCount() seen.
+} RT_SIDE;
+
+static void rt_enter( const RT_SIDE* side )
+{
+	if( side->isr )
+	{
+		pthread_mutex_lock( &irqLock );
+	}
+}
+
+static void rt_exit( const RT_SIDE* side )
+{
+	if( side->isr )
+	{
+		pthread_mutex_unlock( &irqLock );
+	}
+}
+
+static void* rt_producer( void* arg )
+{
+	RT_SIDE* side = (RT_SIDE*)arg;
+	unsigned long n = 0;
+	bool put;
+
+	while( n < RT_BYTES )
+	{
+		rt_enter( side );
+		put = ringPut( &rtRing, rtBuf, RT_MASK, (uint8_t)n );
+		rt_exit( side );
+		if( !put )
+		{
+			sched_yield();					// full. Let the consumer run.
+			continue;
+		}
+		++n;
+		if( side->clears && ( n % RT_CLEAR_EVERY ) == 0 )
+		{
+			RING_ATOMIC
+			{
+				(void)ringDrop( &rtRing );
+				++rtClears;
+			}
+		}
+	}
+	side->count = n;
+	__atomic_store_n( &rtDone, true, __ATOMIC_RELEASE );
+	return NULL;
+}
+
+static void* rt_consumer( void* arg )
+{
+	RT_SIDE* side = (RT_SIDE*)arg;
+	uint8_t expect = 0;
+	unsigned long clears = 0;
+	unsigned long seen;
+	bool dropped = false;
+	uint8_t data;
+	unsigned count;
+	bool took;
+
+	for( ;; )
+	{
+		rt_enter( side );
+		count = ringCount( &rtRing, RT_MASK );
+		took = !ringEmpty( &rtRing );
+		if( took )
+		{
+			data = ringTake( &rtRing, rtBuf, RT_MASK );
+		}
+		seen = __atomic_load_n( &rtClears, __ATOMIC_ACQUIRE );
+		rt_exit( side );
+
+		if( count > side->maxCount )
+		{
+			side->maxCount = count;
+		}
+		if( !took )
+		{
+			if( __atomic_load_n( &rtDone, __ATOMIC_ACQUIRE ) && ringEmpty( &rtRing ) )
+			{
+				break;
+			}
+			sched_yield();						// empty. Let the producer run.
+			continue;
+		}
+		if( data != expect )
+		{
+			if( seen != clears || dropped )
+			{
+				++side->gaps;
+			}
+			else
+			{
+				++side->fails;
+			}
+		}
+		clears = seen;
+		dropped = false;
+		expect = data + 1;
+		++side->count;
+
+		if( side->clears && ( side->count % RT_CLEAR_EVERY ) == 0 )
+		{
+			rt_enter( side );
+			(void)ringDrop( &rtRing );			// the consumer owns tail.
+			rt_exit( side );
+			dropped = true;
+		}
+	}
+	return NULL;
+}
+
+static void rt_run( RT_SIDE* prod, RT_SIDE* cons )
+{
+	pthread_t p, c;
+
+	ringInit( &rtRing );
+	rtDone = false;
+	rtClears = 0;
+
+	pthread_create( &c, NULL, rt_consumer, cons );
+	pthread_create( &p, NULL, rt_producer, prod );
+	pthread_join( p, NULL );
+	pthread_join( c, NULL );
+}
+
+/*
+ * Output buffer. Main puts, the ISR takes.
+ */
+static void ring_txOrder( void )
+{
+	RT_SIDE prod = { .isr = false };
+	RT_SIDE cons = { .isr = true };
+
+	rt_run( &prod, &cons );
+	HT_EQ( prod.count, RT_BYTES );
+	HT_EQ( cons.count, RT_BYTES );
+	HT_EQ( cons.fails, 0 );
+	HT_CHECK( cons.maxCount <= RT_MASK );
+}
+
+/*
+ * Input buffer. The ISR puts, main takes.
+ */
+static void ring_rxOrder( void )
+{
+	RT_SIDE prod = { .isr = true };
+	RT_SIDE cons = { .isr = false };
+
+	rt_run( &prod, &cons );
+	HT_EQ( cons.count, RT_BYTES );
+	HT_EQ( cons.fails, 0 );
+	HT_CHECK( cons.maxCount <= RT_MASK );
+}
+
+/*
+ * twiClearOutput(). Main clears the output buffer while the ISR takes from it.
+ */
+static void ring_txClear( void )
+{
+	RT_SIDE prod = { .isr = false, .clears = true };
+	RT_SIDE cons = { .isr = true };
+
+	rt_run( &prod, &cons );
+	HT_EQ( cons.fails, 0 );
+	HT_CHECK( cons.count <= RT_BYTES );
+	HT_CHECK( cons.count + rtClears * RT_MASK >= RT_BYTES );		// a clear drops a ring at most.
+}
+
+/*
+ * Main drops the input buffer while the ISR puts into it.
+ */
+static void ring_rxClear( void )
+{
+	RT_SIDE prod = { .isr = true };
+	RT_SIDE cons = { .isr = false, .clears = true };
+
+	rt_run( &prod, &cons );
+	HT_EQ( prod.count, RT_BYTES );
+	HT_EQ( cons.fails, 0 );
+	HT_CHECK( cons.count < RT_BYTES );
+}
+
+int main( void )
+{
+	HT_RUN( ring_txOrder );
+	HT_RUN( ring_rxOrder );
+	HT_RUN( ring_txClear );
+	HT_RUN( ring_rxClear );
+
+	return ht_result();
+}
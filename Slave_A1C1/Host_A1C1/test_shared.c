@@ -0,0 +1,158 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_shared.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * isrShared.h. The seqlock is run with the writer and the reader on two threads, the writer
+ * standing in for the ISR. Every value the writer makes has the same low and high halves, so
+ * a read that mixes two writes is seen. The copy helpers and the double buffer are checked
+ * on one thread.
+ */ 
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "host_test.h"
+#include "isrShared.h"
+
+#define TS_WRITES		1000000UL
+
+static SHARED_SEQ32		tsSeq;
+static bool				tsDone;				// writer finished. Atomic.
+
+static uint32_t ts_value( uint32_t n )
+{
+	return ( (n & 0xFFFF) << 16 ) | ( n & 0xFFFF );
+}
+
+static void* ts_writer( void* arg )
+{
+	uint32_t n;
+
+	(void)arg;
+	for( n=1; n<=TS_WRITES; ++n )
+	{
+		seqWrite32( &tsSeq, ts_value( n ) );
+		if( ( n & 0x3FF ) == 0 )
+		{
+			sched_yield();
+		}
+	}
+	__atomic_store_n( &tsDone, true, __ATOMIC_RELEASE );
+	return NULL;
+}
+
+static void shared_seqThreads( void )
+{
+	pthread_t w;
+	uint32_t v;
+	uint32_t last = 0;
+	unsigned long torn = 0;
+	unsigned long backward = 0;
+	bool done;
+
+	seqWrite32( &tsSeq, 0 );
+	tsDone = false;
+	pthread_create( &w, NULL, ts_writer, NULL );
+	do {
+		done = __atomic_load_n( &tsDone, __ATOMIC_ACQUIRE );
+		v = seqRead32( &tsSeq );
+		if( ( v >> 16 ) != ( v & 0xFFFF ) )
+		{
+			++torn;
+		}
+		if( ( v & 0xFFFF ) < ( last & 0xFFFF ) && ( last & 0xFFFF ) - ( v & 0xFFFF ) < 0x8000 )
+		{
+			++backward;
+		}
+		last = v;
+	} while( !done );
+	pthread_join( w, NULL );
+
+	HT_EQ( torn, 0 );
+	HT_EQ( backward, 0 );
+	HT_EQ( seqRead32( &tsSeq ), ts_value( TS_WRITES ) );
+	HT_EQ( tsSeq.seq & 1, 0 );
+}
+
+static void shared_seq16( void )
+{
+	SHARED_SEQ16 s = { 0 };
+	uint16_t i;
+
+	for( i=0; i<300; ++i )
+	{
+		seqAdd16( &s, 1 );
+	}
+	HT_EQ( seqRead16( &s ), 300 );
+	HT_EQ( s.seq, (uint8_t)600 );				// two per write. Wraps.
+	seqWrite16( &s, 0xBEEF );
+	HT_EQ( seqRead16( &s ), 0xBEEF );
+}
+
+static void shared_dbuf( void )
+{
+	SHARED_DBUF16 d16 = { { 0 }, 0 };
+	SHARED_DBUF32 d32 = { { 0 }, 0 };
+	uint8_t cur;
+
+	cur = d16.cur;
+	dbufWrite16( &d16, 0x1234 );
+	HT_EQ( dbufRead16( &d16 ), 0x1234 );
+	HT_EQ( d16.cur, cur ^ 1 );					// written to the other slot, then flipped.
+	HT_EQ( d16.value[cur], 0 );
+	dbufWrite16( &d16, 0x5678 );
+	HT_EQ( dbufRead16( &d16 ), 0x5678 );
+	HT_EQ( d16.value[cur ^ 1], 0x1234 );
+
+	dbufWrite32( &d32, 0x89ABCDEFUL );
+	HT_EQ( dbufRead32( &d32 ), 0x89ABCDEFUL );
+	dbufWrite32( &d32, 0x01234567UL );
+	HT_EQ( dbufRead32( &d32 ), 0x01234567UL );
+}
+
+static void shared_copy( void )
+{
+	volatile uint16_t v16 = 0;
+	volatile uint32_t v32 = 0;
+
+	sharedWrite16( &v16, 0xA55A );
+	HT_EQ( sharedRead16( &v16 ), 0xA55A );
+	sharedWrite32( &v32, 0xDEADBEEFUL );
+	HT_EQ( sharedRead32( &v32 ), 0xDEADBEEFUL );
+}
+
+int main( void )
+{
+	HT_RUN( shared_seqThreads );
+	HT_RUN( shared_seq16 );
+	HT_RUN( shared_dbuf );
+	HT_RUN( shared_copy );
+
+	return ht_result();
+}
@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_twi.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * twiSlave.c FIFOs, READY status and underrun byte, driven through TWI_vect.
+ */ 
+
+#include <avr/io.h>
+
+#include "host_test.h"
+#include "host_twi.h"
+#include "twiSlave.h"
+#include "initialize.h"
+
+static void twi_writeFifo( void )
+{
+	const uint8_t msg[] = { 0x11, 0x22, 0x33 };
+
+	ht_boot();
+	HT_CHECK( ht_write( msg, sizeof(msg) ) );
+
+	HT_CHECK( twiDataInReceiveBuffer() );
+	HT_EQ( twiReceiveByte(), 0x11 );
+	HT_EQ( twiReceiveByte(), 0x22 );
+	HT_EQ( twiReceiveByte(), 0x33 );
+	HT_CHECK( !twiDataInReceiveBuffer() );
+	HT_EQ( twiReceiveByte(), 0x88 );			// empty
+}
+
+static void twi_readyStatus( void )
+{
+	uint8_t buf[5];
+
+	ht_boot();
+	twiTransmitByte( 0xA1 );
+	twiTransmitByte( 0xA2 );
+
+	// Not marked READY yet. Status 0 then the underrun byte.
+	HT_CHECK( ht_read( buf, 2 ) );
+	HT_EQ( buf[0], 0 );
+	HT_EQ( buf[1], TWI_UNDERRUN_BYTE );
+
+	twiTransmitReady();
+	HT_CHECK( ht_read( buf, 5 ) );
+	HT_EQ( buf[0], 2 );
+	HT_EQ( buf[1], 0xA1 );
+	HT_EQ( buf[2], 0xA2 );
+	HT_EQ( buf[3], TWI_UNDERRUN_BYTE );		// read past the reply.
+	HT_EQ( buf[4], TWI_UNDERRUN_BYTE );
+	HT_CHECK( !twiDataInTransmitBuffer() );
+
+	HT_CHECK( ht_read( buf, 1 ) );
+	HT_EQ( buf[0], 0 );
+}
+
+static void twi_partialRead( void )
+{
+	uint8_t buf[3];
+
+	ht_boot();
+	twiTransmitByte( 1 );
+	twiTransmitByte( 2 );
+	twiTransmitByte( 3 );
+	twiTransmitReady();
+
+	// A read of part of the reply leaves the rest for the next read.
+	HT_CHECK( ht_read( buf, 2 ) );
+	HT_EQ( buf[0], 3 );
+	HT_EQ( buf[1], 1 );
+	HT_CHECK( ht_read( buf, 3 ) );
+	HT_EQ( buf[0], 2 );
+	HT_EQ( buf[1], 2 );
+	HT_EQ( buf[2], 3 );
+}
+
+static void twi_wrap( void )
+{
+	uint8_t buf[4];
+	uint8_t i;
+
+	ht_boot();
+	for( i=0; i<3*TWI_TX_BUFFER_SIZE; ++i )
+	{
+		twiTransmitByte( i );
+		twiTransmitByte( ~i );
+		twiTransmitReady();
+		HT_CHECK( ht_read( buf, 3 ) );
+		HT_EQ( buf[0], 2 );
+		HT_EQ( buf[1], i );
+		HT_EQ( buf[2], (uint8_t)~i );
+	}
+}
+
+static void twi_txFull( void )
+{
+	uint8_t buf[TWI_TX_BUFFER_SIZE + 1];
+	uint8_t i;
+
+	ht_boot();
+	for( i=0; i<TWI_TX_BUFFER_SIZE + 4; ++i )
+	{
+		twiTransmitByte( i );					// bytes past a full buffer are dropped.
+	}
+	twiTransmitReady();
+
+	HT_CHECK( ht_read( buf, TWI_TX_BUFFER_SIZE + 1 ) );
+	HT_EQ( buf[0], TWI_TX_BUFFER_SIZE - 1 );
+	HT_EQ( buf[1], 0 );
+	HT_EQ( buf[TWI_TX_BUFFER_SIZE - 1], TWI_TX_BUFFER_SIZE - 2 );
+	HT_EQ( buf[TWI_TX_BUFFER_SIZE], TWI_UNDERRUN_BYTE );
+}
+
+static void twi_clearInRead( void )
+{
+	uint8_t buf[2];
+
+	ht_boot();
+	twiTransmitByte( 0x11 );
+	twiTransmitByte( 0x22 );
+	twiTransmitByte( 0x33 );
+	twiTransmitReady();
+
+	// SLA+R and the first reply byte, then the output is cleared before the next byte.
+	TWSR = 0xA8;
+	TWI_vect();
+	HT_EQ( TWDR, 3 );
+	TWSR = 0xB8;
+	TWI_vect();
+	HT_EQ( TWDR, 0x11 );
+	twiClearOutput();
+	TWI_vect();
+	HT_EQ( TWDR, TWI_UNDERRUN_BYTE );			// not bytes past the cleared end.
+	TWSR = 0xC0;
+	TWI_vect();
+	HT_CHECK( !twiDataInTransmitBuffer() );
+
+	twiTransmitByte( 0x44 );
+	twiTransmitReady();
+	HT_CHECK( ht_read( buf, 2 ) );
+	HT_EQ( buf[0], 1 );
+	HT_EQ( buf[1], 0x44 );
+}
+
+static void twi_disabled( void )
+{
+	const uint8_t msg[] = { 0xF0, 0x10, 0x01 };
+
+	avr_reset();
+	twiSlaveInit( 0x40 );						// TWEN only. Address not ACK'd.
+	HT_CHECK( !ht_write( msg, sizeof(msg) ) );
+	twiSlaveEnable();
+	HT_CHECK( ht_write( msg, sizeof(msg) ) );
+	HT_EQ( TWAR, (0x40 << 1) | (1<<TWGCE) );
+}
+
+int main( void )
+{
+	avr_eeErase();
+
+	HT_RUN( twi_writeFifo );
+	HT_RUN( twi_readyStatus );
+	HT_RUN( twi_partialRead );
+	HT_RUN( twi_wrap );
+	HT_RUN( twi_txFull );
+	HT_RUN( twi_clearInRead );
+	HT_RUN( twi_disabled );
+
+	return ht_result();
+}
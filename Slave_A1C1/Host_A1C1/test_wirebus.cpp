@@ -0,0 +1,332 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_wirebus.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Bus simulator checks. Firmware nodes and Masters on a WireBus, with general call, clock
+ * stretching, arbitration and two nodes on one address. SlaveMaster address assignment on
+ * nodes that all start at SLAVE_ADRS.
+ *
+ * revision: 10/17/2026	0.02	ndp		add wire_assign.
+ * revision: 10/17/2026	0.03	ndp		add wire_batch.
+ */ 
+
+#include <string.h>
+
+#include "host_test.h"
+#include "WireBus.h"
+#include "WireMaster.h"
+#include "FirmwareNode.h"
+#include "WireMasterBus.h"
+#include "SlaveMaster.h"
+#include "dev_gpio.h"
+#include "dev_led_1.h"
+
+#define PINB_ADRS	0x23
+#define PIND_ADRS	0x29
+#define PORTD_ADRS	0x2B
+#define TWAR_ADRS	0xBA
+
+#define START_NS	50000000ull			// node start up.
+
+#define RUN_MAX_NS	200000000ull
+
+static WireQuery gpioRead( uint8_t adrs )
+{
+	WireQuery q;
+
+	memset( &q, 0, sizeof(q) );
+	q.adrs = adrs;
+	q.msg[0] = 0xF0;
+	q.msg[1] = DEV_GPIO_ID;
+	q.msg[2] = CMD_GPIO_READ;
+	q.len = 3;
+	q.replyLen = 3;
+	return q;
+}
+
+static void runIdle( WireBus& bus, WireMaster& m1, WireMaster* m2 = 0 )
+{
+	while( ( !m1.idle() || ( m2 && !m2->idle() ) ) && bus.now() < RUN_MAX_NS )
+		bus.step();
+}
+
+static void wire_query( void )
+{
+	WireBus bus;
+	WireMaster master;
+	FirmwareNode a( A1C1_NODE_LIB, 0x20 );
+	FirmwareNode b( A1C1_NODE_LIB, 0x21 );
+
+	HT_CHECK( a.ok() && b.ok() );
+	a.setIo( PINB_ADRS, 0x5A );
+	b.setIo( PINB_ADRS, 0xA5 );
+	bus.attach( &a );
+	bus.attach( &b );
+	bus.attach( &master );
+
+	master.queue( gpioRead( 0x20 ) );
+	master.queue( gpioRead( 0x21 ) );
+	runIdle( bus, master );
+
+	HT_EQ( master.done().size(), 2 );
+	HT_CHECK( master.done()[0].ok );
+	HT_EQ( master.done()[0].reply[0], 0x5A );
+	HT_CHECK( master.done()[1].ok );
+	HT_EQ( master.done()[1].reply[0], 0xA5 );
+	HT_EQ( master.nacks(), 0 );
+	HT_EQ( a.collisions() + b.collisions(), 0 );
+	HT_CHECK( bus.busyNs() > 0 && bus.busyNs() < bus.now() );
+
+	// No one at 0x30.
+	master.queue( gpioRead( 0x30 ) );
+	runIdle( bus, master );
+	HT_CHECK( !master.done()[2].ok );
+	HT_EQ( master.nacks(), 1 );
+}
+
+static void wire_generalCall( void )
+{
+	WireBus bus;
+	WireMaster master;
+	FirmwareNode a( A1C1_NODE_LIB, 0x20 );
+	FirmwareNode b( A1C1_NODE_LIB, 0x21 );
+	WireQuery ledOn;
+
+	bus.attach( &a );
+	bus.attach( &b );
+	bus.attach( &master );
+
+	memset( &ledOn, 0, sizeof(ledOn) );
+	ledOn.adrs = 0;
+	ledOn.msg[0] = 0xF0;
+	ledOn.msg[1] = DEV_LED_1_ID;
+	ledOn.msg[2] = CMD_LED_ON;
+	ledOn.len = 3;
+	master.queue( gpioRead( 0x20 ) );		// waits out the start up.
+	master.queue( ledOn );
+	runIdle( bus, master );
+	bus.run( 1000000 );						// let the nodes run the command.
+
+	HT_CHECK( master.done()[1].ok );
+	HT_CHECK( a.io( PORTD_ADRS ) & 0x01 );
+	HT_CHECK( b.io( PORTD_ADRS ) & 0x01 );
+}
+
+static void wire_arbitration( void )
+{
+	WireBus bus;
+	WireMaster m1;
+	WireMaster m2;
+	FirmwareNode a( A1C1_NODE_LIB, 0x20 );
+	FirmwareNode b( A1C1_NODE_LIB, 0x21 );
+	int i;
+
+	bus.attach( &a );
+	bus.attach( &b );
+	bus.attach( &m1 );
+	bus.attach( &m2 );
+
+	for( i=0; i<4; ++i )
+	{
+		m1.queue( gpioRead( 0x21 ) );		// 0x21 loses to 0x20 on the last address bit.
+		m2.queue( gpioRead( 0x20 ) );
+	}
+	runIdle( bus, m1, &m2 );
+
+	HT_EQ( m1.done().size(), 4 );
+	HT_EQ( m2.done().size(), 4 );
+	for( i=0; i<4; ++i )
+	{
+		HT_CHECK( m1.done()[i].ok );
+		HT_CHECK( m2.done()[i].ok );
+	}
+	HT_CHECK( m1.arbitrationLost() + m2.arbitrationLost() >= 1 );
+}
+
+static void wire_sameAddress( void )
+{
+	WireBus bus;
+	WireMaster master;
+	FirmwareNode a( A1C1_NODE_LIB, 0x20 );
+	FirmwareNode b( A1C1_NODE_LIB, 0x20 );
+
+	a.setIo( PIND_ADRS, 0x0F );
+	b.setIo( PIND_ADRS, 0xF0 );
+	bus.attach( &a );
+	bus.attach( &b );
+	bus.attach( &master );
+
+	master.queue( gpioRead( 0x20 ) );
+	runIdle( bus, master );
+
+	HT_CHECK( a.collisions() + b.collisions() > 0 );
+}
+
+static uint64_t latency( uint32_t isrNs )
+{
+	WireBus bus;
+	WireMaster master;
+	FirmwareNode a( A1C1_NODE_LIB, 0x20, NODE_LOOP_NS, isrNs );
+
+	bus.attach( &a );
+	bus.attach( &master );
+	master.queue( gpioRead( 0x20 ) );		// start up.
+	master.queue( gpioRead( 0x20 ) );
+	runIdle( bus, master );
+	return master.done()[1].endNs - master.done()[1].startNs;
+}
+
+static void wire_stretch( void )
+{
+	// A slow ISR holds SCL longer on every byte.
+	HT_CHECK( latency( 40000 ) > latency( 1000 ) );
+}
+
+/*
+ * Three nodes with their own UIDs, all at SLAVE_ADRS. Two differ only in the last bit. The
+ * search moves each to its own address, lowest UID first, and they keep it after RESET.
+ */
+static void wire_assign( void )
+{
+	static const uint8_t uids[3][IA_UID_SIZE] = {
+		{ 0xC3, 0x00, 0x10, 0x01 },
+		{ 0x12, 0x34, 0x56, 0x79 },
+		{ 0x12, 0x34, 0x56, 0x78 }
+	};
+	static const uint8_t expect[3] = { 0x52, 0x51, 0x50 };
+	WireBus bus;
+	WireMaster master;
+	WireMasterBus smBus( bus, master );
+	SlaveMaster sm( smBus );
+	FirmwareNode a( A1C1_NODE_LIB, 0 );
+	FirmwareNode b( A1C1_NODE_LIB, 0 );
+	FirmwareNode c( A1C1_NODE_LIB, 0 );
+	FirmwareNode* nodes[3] = { &a, &b, &c };
+	uint8_t uid[IA_UID_SIZE];
+	uint8_t count;
+	int i;
+
+	for( i=0; i<3; ++i )
+	{
+		nodes[i]->setUid( uids[i] );
+		nodes[i]->reset();
+		bus.attach( nodes[i] );
+	}
+	bus.attach( &master );
+	bus.run( START_NS );
+
+	HT_EQ( sm.iaAssignAll( 0x50, 8, count ), SM_OK );
+	HT_EQ( count, 3 );
+	bus.run( 1000000 );
+
+	// RESET. The saved address is used.
+	for( i=0; i<3; ++i )
+	{
+		nodes[i]->reset();
+	}
+	bus.run( START_NS );
+	for( i=0; i<3; ++i )
+	{
+		HT_EQ( nodes[i]->io( TWAR_ADRS ) >> 1, expect[i] );
+		sm.setAddress( expect[i] );
+		HT_EQ( sm.iaUid( uid ), SM_OK );
+		HT_CHECK( memcmp( uid, uids[i], IA_UID_SIZE ) == 0 );
+	}
+
+	// No node left at SLAVE_ADRS.
+	HT_EQ( sm.iaAssignAll( 0x50, 8, count ), SM_OK );
+	HT_EQ( count, 0 );
+
+	// All back to SLAVE_ADRS.
+	HT_EQ( sm.iaReset(), SM_OK );
+	bus.run( 1000000 );
+	for( i=0; i<3; ++i )
+	{
+		HT_EQ( nodes[i]->io( TWAR_ADRS ) >> 1, SLAVE_ADRS );
+	}
+}
+
+/*
+ * A SlaveMaster batch up to SM_BATCH_MAX bytes goes out as one write and the node runs all
+ * of it.
+ */
+static void wire_batch( void )
+{
+	WireBus bus;
+	WireMaster master;
+	WireMasterBus smBus( bus, master );
+	SlaveMaster sm( smBus );
+	FirmwareNode a( A1C1_NODE_LIB, 0x20 );
+	size_t count;
+	int i;
+
+	bus.attach( &a );
+	bus.attach( &master );
+	bus.run( START_NS );
+	sm.setAddress( 0x20 );
+
+	// Ten LED commands, 30 bytes. The last is ON.
+	count = master.done().size();
+	sm.beginBatch();
+	for( i=0; i<5; ++i )
+	{
+		HT_EQ( sm.ledOff(), SM_OK );
+		HT_EQ( sm.ledOn(), SM_OK );
+	}
+	HT_EQ( master.done().size(), count );
+	HT_EQ( sm.endBatch(), SM_OK );
+	HT_CHECK( (master.done().size() == count + 1) && (master.done().back().len == 30) );
+	bus.run( 1000000 );
+	HT_CHECK( a.io( PORTD_ADRS ) & 0x01 );
+
+	// One more does not fit. The first ten go out on their own.
+	sm.beginBatch();
+	for( i=0; i<5; ++i )
+	{
+		HT_EQ( sm.ledOn(), SM_OK );
+		HT_EQ( sm.ledOff(), SM_OK );
+	}
+	HT_EQ( sm.ledOn(), SM_OK );
+	HT_EQ( master.done().size(), count + 2 );
+	HT_EQ( sm.endBatch(), SM_OK );
+	HT_CHECK( (master.done().size() == count + 3) && (master.done().back().len == 3) );
+	bus.run( 1000000 );
+	HT_CHECK( a.io( PORTD_ADRS ) & 0x01 );
+}
+
+int main( void )
+{
+	HT_RUN( wire_query );
+	HT_RUN( wire_generalCall );
+	HT_RUN( wire_arbitration );
+	HT_RUN( wire_sameAddress );
+	HT_RUN( wire_stretch );
+	HT_RUN( wire_assign );
+	HT_RUN( wire_batch );
+
+	return ht_result();
+}
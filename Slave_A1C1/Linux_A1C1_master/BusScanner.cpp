@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * BusScanner.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add setQuery().
+ */ 
+
+#include <string.h>
+
+#include "BusScanner.h"
+
+#define SCAN_POLLS			20
+#define SCAN_UNDERRUN		0x88		// TWI_UNDERRUN_BYTE
+#define SCAN_PROFILE_PAGE	10			// entries per INIT PROFILE reply.
+
+bool SlaveInfo::has( uint8_t mod ) const
+{
+	uint8_t i;
+
+	for( i=0; i<idCount; ++i )
+	{
+		if( ids[i] == mod )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+BusScanner::BusScanner( SlaveBus& bus )
+	: _bus(bus), _first(SCAN_FIRST), _last(SCAN_LAST), _query(true)
+{
+}
+
+/*
+ * Probe every address in the range. Returns the number of Slaves found.
+ */
+uint8_t BusScanner::scan( std::vector<SlaveInfo>& found )
+{
+	SlaveInfo info;
+	uint8_t count = 0;
+	uint8_t adrs;
+
+	for( adrs = _first; adrs <= _last; ++adrs )
+	{
+		if( probe( adrs, info ) )
+		{
+			found.push_back( info );
+			++count;
+		}
+	}
+	return count;
+}
+
+/*
+ * Returns false if nothing ACKs the address.
+ */
+bool BusScanner::probe( uint8_t adrs, SlaveInfo& info )
+{
+	uint8_t buf[2];
+
+	memset( &info, 0, sizeof(info) );
+	info.adrs = adrs;
+	info.type = SCAN_OTHER;
+
+	if( _bus.read( adrs, buf, sizeof(buf) ) != sizeof(buf) )
+	{
+		return false;
+	}
+	if( buf[0] != 0 )
+	{
+		return true;
+	}
+
+	if( buf[1] == INIT_BUSY_BYTE )
+	{
+		info.type = SCAN_STARTING;
+	}
+	else if( (buf[1] == SCAN_UNDERRUN) && !_query )
+	{
+		info.type = SCAN_IDLE;
+	}
+	else if( (buf[1] == SCAN_UNDERRUN) && !identify( info ) )
+	{
+		drain( adrs );
+	}
+	return true;
+}
+
+/*
+ * The capability query. Returns false if the replies are not from an A1C1 node.
+ */
+bool BusScanner::identify( SlaveInfo& info )
+{
+	SlaveMaster sm( _bus, info.adrs );
+	SlaveReply reply;
+	uint8_t start;
+	uint8_t count;
+	uint8_t i;
+
+	sm.setRetry( 1, 0 );
+	sm.setReplyPolls( SCAN_POLLS );
+
+	if( (sm.initStatus( reply ) != SM_OK) || (reply.u8( 0 ) > 1) || (reply.u8( 1 ) > SCAN_IDS_MAX) )
+	{
+		return false;
+	}
+	info.devices = reply.u8( 1 );
+
+	for( start = 0; start < info.devices; start += count )
+	{
+		if( sm.query( INIT_ID, CMD_INIT_PROFILE, &start, 1, reply, 1 + 3 * SCAN_PROFILE_PAGE ) == SM_ERR_BUSY )
+		{
+			return false;
+		}
+		count = reply.u8( 0 );
+		if( (count == 0) || (reply.count() < 1 + 3 * count) || (start + count > SCAN_IDS_MAX) )
+		{
+			break;
+		}
+		for( i=0; i<count; ++i )
+		{
+			info.ids[info.idCount++] = reply.u8( 1 + 3 * i );
+		}
+	}
+
+	info.type = SCAN_A1C1;
+	return true;
+}
+
+/*
+ * Read back whatever a Slave that is not an A1C1 made of the query, e.g. the echoes of an A1B3.
+ */
+void BusScanner::drain( uint8_t adrs )
+{
+	uint8_t buf[SM_REPLY_MAX + 1];
+
+	_bus.read( adrs, buf, sizeof(buf) );
+}
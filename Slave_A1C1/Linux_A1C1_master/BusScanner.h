@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * BusScanner.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Finds the Slaves on a bus and what they can do.
+ *
+ * Each address from 0x08 to 0x77 is probed with a two byte read. A Slave_A1C1 node answers
+ * READY = 0 and then its underrun byte: 0x88 when it is up, INIT_BUSY_BYTE while its devices
+ * are still starting. Only nodes that answer that way are sent the capability query:
+ * INIT STATUS, then INIT PROFILE for the IDs of the devices that started. The simple tutorial
+ * Slaves answer the probe some other way and are listed as SCAN_OTHER without being written to.
+ *
+ * An idle A1B3 uses the same driver and answers the probe the same way, and no read tells the
+ * two apart once an A1C1 is up. So the scan WRITES to every A1B3 it finds: it takes the three
+ * INIT STATUS bytes as three echo commands (its COUNT goes up by 3) and the scanner reads the
+ * echoes back, then lists it as SCAN_OTHER. setQuery( false ) makes a scan that never writes.
+ * Those nodes are then listed as SCAN_IDLE, which is an A1C1 or an A1B3.
+ *
+ * revision: 10/17/2026	0.02	ndp		say that A1B3 nodes are written to. Add setQuery().
+ */ 
+
+
+#ifndef BUSSCANNER_H_
+#define BUSSCANNER_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "SlaveBus.h"
+#include "SlaveMaster.h"
+
+#define SCAN_FIRST			0x08		// 0x00:0x07 and 0x78:0x7F are reserved.
+#define SCAN_LAST			0x77
+#define SCAN_IDS_MAX		16			// INIT_PROFILE_SIZE
+
+enum { SCAN_A1C1, SCAN_STARTING, SCAN_OTHER, SCAN_IDLE };
+
+struct SlaveInfo
+{
+	uint8_t		adrs;
+	uint8_t		type;					// SCAN_A1C1 SCAN_STARTING SCAN_OTHER SCAN_IDLE
+	uint8_t		devices;				// from INIT STATUS.
+	uint8_t		idCount;
+	uint8_t		ids[SCAN_IDS_MAX];		// device IDs in start up order.
+
+	bool	has( uint8_t mod ) const;
+};
+
+class BusScanner
+{
+public:
+	explicit BusScanner( SlaveBus& bus );
+
+	void	setRange( uint8_t first, uint8_t last ) { _first = first; _last = last; }
+	void	setQuery( bool on ) { _query = on; }			// false: read only.
+
+	uint8_t	scan( std::vector<SlaveInfo>& found );
+	bool	probe( uint8_t adrs, SlaveInfo& info );
+
+private:
+	bool	identify( SlaveInfo& info );
+	void	drain( uint8_t adrs );
+
+	SlaveBus&	_bus;
+	uint8_t		_first;
+	uint8_t		_last;
+	bool		_query;
+};
+
+#endif /* BUSSCANNER_H_ */
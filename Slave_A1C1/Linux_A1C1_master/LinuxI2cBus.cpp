@@ -0,0 +1,141 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * LinuxI2cBus.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		transfer() reports the parts done.
+ */ 
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "LinuxI2cBus.h"
+
+LinuxI2cBus::~LinuxI2cBus()
+{
+	close();
+}
+
+bool LinuxI2cBus::open( const char* dev )
+{
+	close();
+	_fd = ::open( dev, O_RDWR );
+	return _fd >= 0;
+}
+
+void LinuxI2cBus::close()
+{
+	if( _fd >= 0 )
+	{
+		::close( _fd );
+		_fd = -1;
+	}
+}
+
+uint8_t LinuxI2cBus::write( uint8_t adrs, const uint8_t* data, uint8_t len )
+{
+	SlaveBusMsg msg = { adrs, 0, len, (uint8_t*)data };
+	return transfer( &msg, 1 );
+}
+
+uint8_t LinuxI2cBus::read( uint8_t adrs, uint8_t* data, uint8_t len )
+{
+	SlaveBusMsg msg = { adrs, SB_READ, len, data };
+
+	if( transfer( &msg, 1 ) != SB_OK )
+	{
+		return 0;
+	}
+	return msg.len;
+}
+
+void LinuxI2cBus::delayMs( uint16_t ms )
+{
+	struct timespec ts;
+
+	ts.tv_sec = ms / 1000;
+	ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+	nanosleep( &ts, 0 );
+}
+
+/*
+ * One I2C_RDWR ioctl. The adapter NACK errors are mapped to the Wire codes.
+ * The ioctl does not say which message failed, so DONE is SB_DONE_UNKNOWN if it fails.
+ */
+uint8_t LinuxI2cBus::transfer( SlaveBusMsg* msgs, uint8_t count, uint8_t* done )
+{
+	struct i2c_msg im[LIB_MAX_MSGS];
+	struct i2c_rdwr_ioctl_data rdwr;
+	uint8_t i;
+
+	if( done )
+	{
+		*done = 0;
+	}
+	if( _fd < 0 )
+	{
+		return SB_ERR_OTHER;
+	}
+	if( count > LIB_MAX_MSGS )
+	{
+		return SB_ERR_LENGTH;
+	}
+
+	for( i=0; i<count; ++i )
+	{
+		im[i].addr = msgs[i].adrs;
+		im[i].flags = (msgs[i].flags & SB_READ) ? I2C_M_RD : 0;
+		im[i].len = msgs[i].len;
+		im[i].buf = msgs[i].buf;
+	}
+	rdwr.msgs = im;
+	rdwr.nmsgs = count;
+
+	if( ioctl( _fd, I2C_RDWR, &rdwr ) < 0 )
+	{
+		if( done )
+		{
+			*done = SB_DONE_UNKNOWN;
+		}
+		// Most adapters return ENXIO or EREMOTEIO for a NACK.
+		if( (errno == ENXIO) || (errno == EREMOTEIO) )
+		{
+			return SB_ERR_ADRS_NACK;
+		}
+		return SB_ERR_OTHER;
+	}
+	if( done )
+	{
+		*done = count;
+	}
+	return SB_OK;
+}
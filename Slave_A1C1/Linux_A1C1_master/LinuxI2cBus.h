@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * LinuxI2cBus.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * SlaveBus backend for Linux /dev/i2c-N. Every transfer is one I2C_RDWR ioctl, so a list of
+ * messages goes out as one combined transaction with repeated STARTs.
+ */ 
+
+
+#ifndef LINUXI2CBUS_H_
+#define LINUXI2CBUS_H_
+
+#include "SlaveBus.h"
+
+#define LIB_MAX_MSGS		42			// I2C_RDWR_IOCTL_MAX_MSGS
+
+class LinuxI2cBus : public SlaveBus
+{
+public:
+	LinuxI2cBus() : _fd(-1) {}
+	virtual ~LinuxI2cBus();
+
+	bool	open( const char* dev );		// "/dev/i2c-1"
+	void	close();
+
+	virtual uint8_t write( uint8_t adrs, const uint8_t* data, uint8_t len );
+	virtual uint8_t read( uint8_t adrs, uint8_t* data, uint8_t len );
+	virtual void delayMs( uint16_t ms );
+	virtual uint8_t transfer( SlaveBusMsg* msgs, uint8_t count, uint8_t* done = 0 );
+
+private:
+	int		_fd;
+};
+
+#endif /* LINUXI2CBUS_H_ */
@@ -0,0 +1,192 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * MasterPool.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		signal doneFd() when results are added.
+ */ 
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "MasterPool.h"
+
+#define MP_IN_MAX		256			// requests held for a bus before submit() refuses them.
+
+MasterPool::MasterPool()
+	: _pending(0), _running(false)
+{
+	_doneFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+}
+
+MasterPool::~MasterPool()
+{
+	size_t i;
+
+	stop();
+	for( i=0; i<_lanes.size(); ++i )
+	{
+		delete _lanes[i]->queue;
+		delete _lanes[i];
+	}
+	if( _doneFd >= 0 )
+	{
+		close( _doneFd );
+	}
+}
+
+uint8_t MasterPool::addBus( SlaveBus& bus )
+{
+	Lane* lane = new Lane;
+
+	lane->bus = &bus;
+	lane->queue = new MasterQueue( bus );
+	_lanes.push_back( lane );
+	return (uint8_t)(_lanes.size() - 1);
+}
+
+void MasterPool::start()
+{
+	size_t i;
+
+	_running = true;
+	for( i=0; i<_lanes.size(); ++i )
+	{
+		_lanes[i]->thread = std::thread( &MasterPool::worker, this, _lanes[i] );
+	}
+}
+
+/*
+ * Stop the threads. Requests not yet run are dropped.
+ */
+void MasterPool::stop()
+{
+	size_t i;
+
+	{
+		std::lock_guard<std::mutex> guard( _lock );
+		_running = false;
+	}
+	_work.notify_all();
+	for( i=0; i<_lanes.size(); ++i )
+	{
+		if( _lanes[i]->thread.joinable() )
+		{
+			_lanes[i]->thread.join();
+		}
+	}
+}
+
+bool MasterPool::submit( const MasterRequest& req )
+{
+	std::lock_guard<std::mutex> guard( _lock );
+
+	if( (req.bus >= _lanes.size()) || (_lanes[req.bus]->in.size() >= MP_IN_MAX)
+		|| (req.len > SM_DATA_MAX) || (req.replyLen > SM_REPLY_MAX) )
+	{
+		return false;
+	}
+	_lanes[req.bus]->in.push_back( req );
+	++_pending;
+	_work.notify_all();
+	return true;
+}
+
+/*
+ * Move the finished requests to DONE. With WAIT, block until there is at least one or
+ * nothing is pending.
+ */
+size_t MasterPool::collect( std::vector<MasterRequest>& done, bool wait )
+{
+	std::unique_lock<std::mutex> guard( _lock );
+	size_t count;
+
+	while( wait && _done.empty() && (_pending != 0) )
+	{
+		_doneReady.wait( guard );
+	}
+	count = _done.size();
+	done.insert( done.end(), _done.begin(), _done.end() );
+	_done.clear();
+	if( (count != 0) && (_doneFd >= 0) )
+	{
+		uint64_t events;
+		ssize_t n = read( _doneFd, &events, sizeof(events) );		// clear it.
+
+		(void)n;
+	}
+	return count;
+}
+
+size_t MasterPool::pending()
+{
+	std::lock_guard<std::mutex> guard( _lock );
+
+	return _pending;
+}
+
+/*
+ * One per bus. Feeds the bus's MasterQueue and runs its rounds while it has work.
+ */
+void MasterPool::worker( Lane* lane )
+{
+	std::vector<MasterRequest> done;
+	std::unique_lock<std::mutex> guard( _lock );
+
+	while( _running )
+	{
+		while( !lane->in.empty() && lane->queue->submit( lane->in.front() ) )
+		{
+			lane->in.pop_front();
+		}
+
+		if( lane->queue->pending() == 0 )
+		{
+			_work.wait( guard );
+			continue;
+		}
+
+		guard.unlock();
+		done.clear();
+		lane->queue->step( done );
+		guard.lock();
+
+		if( !done.empty() )
+		{
+			_done.insert( _done.end(), done.begin(), done.end() );
+			_pending -= done.size();
+			_doneReady.notify_all();
+			if( _doneFd >= 0 )
+			{
+				uint64_t one = 1;
+				ssize_t n = write( _doneFd, &one, sizeof(one) );
+
+				(void)n;
+			}
+		}
+	}
+	_doneReady.notify_all();
+}
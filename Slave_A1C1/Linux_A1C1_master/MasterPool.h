@@ -0,0 +1,98 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * MasterPool.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Fan-out over several buses. Each bus has its own MasterQueue run by its own thread, so the
+ * buses work at the same time while each MasterQueue interleaves the Slaves on its bus.
+ * submit() and collect() may be called from any thread.
+ *
+ *   MasterPool pool;
+ *   pool.addBus( bus0 );				before start()
+ *   pool.addBus( bus1 );
+ *   pool.start();
+ *   req.bus = 1; pool.submit( req );
+ *   pool.collect( done, true );		wait for at least one result
+ * doneFd() is readable while results are waiting, so a caller can poll() it with its other
+ * file descriptors instead of blocking in collect().
+ *
+ * revision: 10/17/2026	0.02	ndp		add doneFd().
+ */ 
+
+
+#ifndef MASTERPOOL_H_
+#define MASTERPOOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MasterQueue.h"
+
+class MasterPool
+{
+public:
+	MasterPool();
+	~MasterPool();
+
+	uint8_t	addBus( SlaveBus& bus );				// returns the bus index.
+	uint8_t	buses() const { return (uint8_t)_lanes.size(); }
+	MasterQueue& queue( uint8_t bus ) { return *_lanes[bus]->queue; }	// set up before start().
+
+	void	start();
+	void	stop();
+
+	bool	submit( const MasterRequest& req );		// req.bus picks the bus.
+	size_t	collect( std::vector<MasterRequest>& done, bool wait );
+	size_t	pending();
+	int		doneFd() const { return _doneFd; }		// eventfd. collect() clears it.
+
+private:
+	struct Lane
+	{
+		SlaveBus*					bus;
+		MasterQueue*				queue;
+		std::thread					thread;
+		std::deque<MasterRequest>	in;
+	};
+
+	void	worker( Lane* lane );
+
+	std::vector<Lane*>			_lanes;
+	std::mutex					_lock;
+	std::condition_variable		_work;
+	std::condition_variable		_doneReady;
+	std::vector<MasterRequest>	_done;
+	size_t						_pending;
+	bool						_running;
+	int							_doneFd;
+};
+
+#endif /* MASTERPOOL_H_ */
@@ -0,0 +1,342 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * MasterQueue.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		pipeline batches behind a reply that is not read yet.
+ * revision: 10/17/2026	0.03	ndp		resend only from the failed part.
+ * revision: 10/17/2026	0.04	ndp		no second command with a reply until the first is read.
+ */ 
+
+#include <string.h>
+
+#include "MasterQueue.h"
+
+#define MQ_TRIES			3			// write attempts per command.
+#define MQ_POLLS			200			// reads of a reply that is not READY.
+#define MQ_MAX_MSGS			42			// parts in one combined transaction. I2C_RDWR_IOCTL_MAX_MSGS
+
+MasterQueue::MasterQueue( SlaveBus& bus )
+	: _bus(bus), _tries(MQ_TRIES), _polls(MQ_POLLS)
+{
+}
+
+bool MasterQueue::submit( const MasterRequest& req )
+{
+	Slave& s = _slaves[req.adrs & 0x7F];
+
+	if( (s.queue.size() >= MQ_QUEUE_MAX) || (req.len > SM_DATA_MAX) || (req.replyLen > SM_REPLY_MAX) )
+	{
+		return false;
+	}
+	s.queue.push_back( req );
+	return true;
+}
+
+size_t MasterQueue::pending() const
+{
+	size_t count = 0;
+	std::map<uint8_t, Slave>::const_iterator it;
+
+	for( it = _slaves.begin(); it != _slaves.end(); ++it )
+	{
+		count += it->second.queue.size() + it->second.awaiting.size();
+	}
+	return count;
+}
+
+/*
+ * Run the parts as combined transactions of up to MQ_MAX_MSGS. STATUS gets the result of each
+ * part. If a part fails, the ones before it are done and the ones after it never went out, so
+ * the transaction starts again after the failed part. A part that reached its Slave is not sent
+ * again. If the backend can not say which part failed, all of them get MQ_ERR_UNSURE.
+ */
+uint8_t MasterQueue::run( std::vector<SlaveBusMsg>& msgs, std::vector<uint8_t>& status )
+{
+	uint8_t result = SB_OK;
+	uint8_t error;
+	uint8_t done;
+	size_t start;
+	size_t count;
+	size_t i;
+
+	status.assign( msgs.size(), SB_OK );
+	for( start = 0; start < msgs.size(); start += count )
+	{
+		count = msgs.size() - start;
+		if( count > MQ_MAX_MSGS )
+		{
+			count = MQ_MAX_MSGS;
+		}
+		error = _bus.transfer( &msgs[start], (uint8_t)count, &done );
+		if( error == SB_OK )
+		{
+			continue;
+		}
+
+		if( done >= count )
+		{
+			for( i = start; i < start + count; ++i )
+			{
+				status[i] = MQ_ERR_UNSURE;
+			}
+			result = MQ_ERR_UNSURE;
+		}
+		else
+		{
+			status[start + done] = error;
+			count = done + 1;					// go on after the failed part.
+			if( result == SB_OK )
+			{
+				result = error;
+			}
+		}
+	}
+	return result;
+}
+
+void MasterQueue::finish( MasterRequest& req, uint8_t status, std::vector<MasterRequest>& done )
+{
+	req.status = status;
+	done.push_back( req );
+}
+
+/*
+ * Build the Slave's next write from its queue. Returns false if nothing can be sent now.
+ */
+bool MasterQueue::batch( Slave& s )
+{
+	uint8_t replies = 0;
+	uint8_t size;
+	size_t i;
+
+	if( s.awaiting.empty() )
+	{
+		s.inflight = 0;						// all written before the last reply is done.
+	}
+	for( i=0; i<s.awaiting.size(); ++i )
+	{
+		replies += s.awaiting[i].replyLen;
+	}
+
+	s.batchLen = 0;
+	while( !s.queue.empty() )
+	{
+		MasterRequest& req = s.queue.front();
+
+		size = 3 + req.len;
+		if( (!s.awaiting.empty() && (req.replyLen != 0))		// its reply would follow one not read.
+			|| (s.batchLen + size > SM_BATCH_MAX)
+			|| (!s.awaiting.empty() && (s.inflight + s.batchLen + size > MQ_INFLIGHT_MAX))
+			|| (replies + req.replyLen > MQ_REPLIES_MAX) )
+		{
+			break;
+		}
+
+		req.replyCount = 0;
+		s.batch[s.batchLen++] = SlaveMaster::makeHeader( req.len );
+		s.batch[s.batchLen++] = req.mod;
+		s.batch[s.batchLen++] = req.cmd;
+		memcpy( &s.batch[s.batchLen], req.data, req.len );
+		s.batchLen += req.len;
+
+		s.sent.push_back( req );
+		s.queue.pop_front();
+		if( s.sent.back().replyLen != 0 )
+		{
+			break;
+		}
+	}
+	return s.batchLen != 0;
+}
+
+/*
+ * The write is done. Commands without a reply are finished, the last one waits for its reply.
+ * A failed write is put back to try again, or failed after the last try. One that may have
+ * reached the Slave (MQ_ERR_UNSURE) is failed now.
+ */
+void MasterQueue::written( Slave& s, uint8_t status, std::vector<MasterRequest>& done )
+{
+	size_t i;
+
+	if( status != SB_OK )
+	{
+		if( (status != MQ_ERR_UNSURE) && (++s.tries < _tries) )
+		{
+			s.queue.insert( s.queue.begin(), s.sent.begin(), s.sent.end() );
+		}
+		else
+		{
+			s.tries = 0;
+			for( i=0; i<s.sent.size(); ++i )
+			{
+				finish( s.sent[i], status, done );
+			}
+		}
+		s.sent.clear();
+		return;
+	}
+
+	s.tries = 0;
+	for( i=0; i<s.sent.size(); ++i )
+	{
+		s.inflight += 3 + s.sent[i].len;
+		if( s.sent[i].replyLen == 0 )
+		{
+			finish( s.sent[i], SM_OK, done );
+		}
+		else
+		{
+			s.awaiting.push_back( s.sent[i] );
+			s.awaitBytes.push_back( s.inflight );
+		}
+	}
+	s.sent.clear();
+}
+
+/*
+ * A read of the oldest reply is done. COUNT bytes are in s.rx, READY first.
+ */
+void MasterQueue::replied( Slave& s, uint8_t status, uint8_t count, std::vector<MasterRequest>& done )
+{
+	MasterRequest& req = s.awaiting.front();
+	uint8_t used;
+	size_t i;
+
+	if( status == SB_OK )
+	{
+		if( (count == 0) || (s.rx[0] == 0) )
+		{
+			// not READY. Read again next round.
+			if( ++s.polls < _polls )
+			{
+				return;
+			}
+			status = SM_ERR_BUSY;
+		}
+		else
+		{
+			--count;
+			if( count > s.rx[0] )
+			{
+				count = s.rx[0];
+			}
+			memcpy( req.reply, &s.rx[1], count );
+			req.replyCount = count;
+			finish( req, (count < req.replyLen) ? SM_ERR_SHORT : SM_OK, done );
+
+			used = s.awaitBytes.front();
+			for( i=1; i<s.awaitBytes.size(); ++i )
+			{
+				s.awaitBytes[i] -= used;
+			}
+			s.inflight -= used;
+			s.awaiting.pop_front();
+			s.awaitBytes.pop_front();
+			s.polls = 0;
+			return;
+		}
+	}
+
+	// The Slave is gone or stuck. The replies after this one can not be trusted either.
+	for( i=0; i<s.awaiting.size(); ++i )
+	{
+		finish( s.awaiting[i], status, done );
+	}
+	s.awaiting.clear();
+	s.awaitBytes.clear();
+	s.inflight = 0;
+	s.polls = 0;
+}
+
+void MasterQueue::step( std::vector<MasterRequest>& done )
+{
+	std::map<uint8_t, Slave>::iterator it;
+	std::vector<SlaveBusMsg> msgs;
+	std::vector<Slave*> owners;
+	std::vector<uint8_t> status;
+	SlaveBusMsg msg;
+	size_t i;
+
+	/* *** Writes *** */
+	for( it = _slaves.begin(); it != _slaves.end(); ++it )
+	{
+		Slave& s = it->second;
+
+		if( !batch( s ) )
+		{
+			continue;
+		}
+		msg.adrs = it->first;
+		msg.flags = 0;
+		msg.len = s.batchLen;
+		msg.buf = s.batch;
+		msgs.push_back( msg );
+		owners.push_back( &s );
+	}
+
+	run( msgs, status );
+	for( i=0; i<owners.size(); ++i )
+	{
+		written( *owners[i], status[i], done );
+	}
+
+	/* *** Reads *** */
+	msgs.clear();
+	owners.clear();
+	for( it = _slaves.begin(); it != _slaves.end(); ++it )
+	{
+		Slave& s = it->second;
+
+		if( s.awaiting.empty() )
+		{
+			continue;
+		}
+		msg.adrs = it->first;
+		msg.flags = SB_READ;
+		msg.len = s.awaiting.front().replyLen + 1;
+		msg.buf = s.rx;
+		msgs.push_back( msg );
+		owners.push_back( &s );
+	}
+
+	run( msgs, status );
+	for( i=0; i<owners.size(); ++i )
+	{
+		replied( *owners[i], status[i], msgs[i].len, done );
+	}
+}
+
+/*
+ * Run rounds until every queue is empty.
+ */
+void MasterQueue::flush( std::vector<MasterRequest>& done )
+{
+	while( pending() != 0 )
+	{
+		step( done );
+	}
+}
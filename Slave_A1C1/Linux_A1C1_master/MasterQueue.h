@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * MasterQueue.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Command queues for many Slaves on one bus.
+ *
+ * Each Slave has its own queue, run in order. step() does one round over all Slaves:
+ *   1. One write per Slave, joined into one combined transaction. Commands for a Slave are
+ *      batched into its write up to SM_BATCH_MAX bytes. A command with a reply ends the batch.
+ *   2. One read per Slave that has a reply coming, also joined into one transaction.
+ * The Slaves process their commands in parallel while the bus is busy with the others, so with
+ * more than a few Slaves the replies are READY by the time they are read. A Slave that is not
+ * READY is read again in the next round.
+ *
+ * A Slave that is still working on a reply can be sent more commands without a reply, so it has
+ * work waiting when it finishes. The bytes written since its unread reply are kept within its
+ * input FIFO (MQ_INFLIGHT_MAX). Only one command with a reply is out at a time: READY counts
+ * the bytes of every complete reply, and some replies are shorter than asked for (ADC READ) or
+ * missing (an unknown command), so a second reply could not be told apart from the first.
+ *
+ * Commands without a reply are done (SM_OK) when their write is ACKed. If a combined
+ * transaction fails (a Slave NACKs), the parts before the failed one are done. Only the failed
+ * part is retried or failed, and the parts after it are sent again as a new transaction. A part
+ * is never sent twice after it reached its Slave, since a command may not be safe to repeat.
+ * If the backend can not tell which part failed (Linux I2C_RDWR), every part of the transaction
+ * ends with MQ_ERR_UNSURE and is not retried.
+ *
+ * revision: 10/17/2026	0.02	ndp		pipeline batches behind a reply that is not read yet.
+ * revision: 10/17/2026	0.03	ndp		resend only from the failed part. Add MQ_ERR_UNSURE.
+ * revision: 10/17/2026	0.04	ndp		one command with a reply out per Slave.
+ */ 
+
+
+#ifndef MASTERQUEUE_H_
+#define MASTERQUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "SlaveBus.h"
+#include "SlaveMaster.h"
+
+#if TWI_REPLY_STATUS != 1
+#  error MasterQueue needs the Slave READY status byte (TWI_REPLY_STATUS)
+#endif
+
+#define MQ_QUEUE_MAX		64			// commands waiting per Slave.
+#define MQ_INFLIGHT_MAX		31			// bytes in a Slave's input FIFO.
+#define MQ_REPLIES_MAX		31			// reply bytes in a Slave's output FIFO.
+
+#define MQ_ERR_UNSURE		0x20		// a combined transaction failed and this part may have run.
+
+struct MasterRequest
+{
+	uint8_t		adrs;
+	uint8_t		mod;
+	uint8_t		cmd;
+	uint8_t		len;
+	uint8_t		data[SM_DATA_MAX];
+	uint8_t		replyLen;				// bytes of reply to read. 0 = none.
+	uint32_t	tag;					// for the caller.
+	uint8_t		bus;					// MasterPool bus index.
+
+	// Set when done.
+	uint8_t		status;					// SM_OK, SB_ERR, SM_ERR or MQ_ERR code.
+	uint8_t		replyCount;
+	uint8_t		reply[SM_REPLY_MAX];
+};
+
+class MasterQueue
+{
+public:
+	explicit MasterQueue( SlaveBus& bus );
+
+	void	setRetry( uint8_t tries ) { _tries = tries; }
+	void	setPolls( uint16_t polls ) { _polls = polls; }
+
+	bool	submit( const MasterRequest& req );
+	size_t	pending() const;
+
+	void	step( std::vector<MasterRequest>& done );
+	void	flush( std::vector<MasterRequest>& done );
+
+private:
+	struct Slave
+	{
+		Slave() : inflight(0), polls(0), tries(0), batchLen(0) {}
+
+		std::deque<MasterRequest>	queue;
+		std::vector<MasterRequest>	sent;			// in this round's write.
+		std::deque<MasterRequest>	awaiting;		// replies not read yet, oldest first.
+		std::deque<uint8_t>			awaitBytes;		// bytes written up to each, since the one before.
+		uint8_t		inflight;						// bytes written since the oldest unread reply.
+		uint16_t	polls;
+		uint8_t		tries;
+		uint8_t		batchLen;
+		uint8_t		batch[SM_BATCH_MAX];
+		uint8_t		rx[SM_REPLY_MAX + 1];
+	};
+
+	uint8_t	run( std::vector<SlaveBusMsg>& msgs, std::vector<uint8_t>& status );
+	bool	batch( Slave& s );
+	void	written( Slave& s, uint8_t status, std::vector<MasterRequest>& done );
+	void	replied( Slave& s, uint8_t status, uint8_t count, std::vector<MasterRequest>& done );
+	void	finish( MasterRequest& req, uint8_t status, std::vector<MasterRequest>& done );
+
+	SlaveBus&					_bus;
+	std::map<uint8_t, Slave>	_slaves;
+	uint8_t						_tries;
+	uint16_t					_polls;
+};
+
+#endif /* MASTERQUEUE_H_ */
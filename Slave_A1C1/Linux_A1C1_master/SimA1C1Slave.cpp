@@ -0,0 +1,285 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SimA1C1Slave.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add INIT PROFILE for the bus scanner.
+ * revision: 10/17/2026	0.03	ndp		add ADC READ.
+ */ 
+
+#include <string.h>
+
+#include "SimA1C1Slave.h"
+
+// The devices the model has, in start up order, for INIT STATUS and PROFILE.
+static const uint8_t simDevices[] = { DEV_LED_1_ID, DEV_LED_PWM_ID, DEV_SEQ_ID, DEV_GPIO_ID };
+
+#define SIM_DEVICE_COUNT	(sizeof(simDevices) / sizeof(simDevices[0]))
+
+SimA1C1Slave::SimA1C1Slave( uint32_t uid, uint32_t msgUs )
+	: _rxCount(0), _txCount(0), _txReady(0), _msgUs(msgUs), _budgetUs(0),
+	  _messages(0), _errors(0), _ledOn(false), _pwmOn(false), _pwmRate(0), _cfgValid(0)
+{
+	uint8_t i;
+
+	for( i=0; i<IA_UID_SIZE; ++i )
+	{
+		_uid[i] = (uint8_t)(uid >> (8 * i));
+	}
+	memset( _port, 0, sizeof(_port) );
+	memset( _ddr, 0, sizeof(_ddr) );
+	memset( _cfg, 0, sizeof(_cfg) );
+}
+
+/*
+ * Bytes past the input FIFO are lost, the same as twiStuffRxBuf().
+ */
+void SimA1C1Slave::receive( const uint8_t* data, uint8_t len )
+{
+	uint8_t i;
+
+	for( i=0; i<len; ++i )
+	{
+		if( _rxCount < SIM_FIFO_SIZE - 1 )
+		{
+			_rx[_rxCount++] = data[i];
+		}
+		else
+		{
+			++_errors;
+		}
+	}
+}
+
+/*
+ * READY first, then the reply bytes. 0x88 once there are no more.
+ */
+uint8_t SimA1C1Slave::transmit( uint8_t* data, uint8_t len )
+{
+	uint8_t count;
+	uint8_t i;
+
+	if( len == 0 )
+	{
+		return 0;
+	}
+
+#if TWI_REPLY_STATUS == 1
+	count = _txReady;
+	data[0] = count;
+	++data;
+	--len;
+#else
+	count = _txReady;
+#endif
+	if( count > len )
+	{
+		count = len;
+	}
+	for( i=0; i<len; ++i )
+	{
+		data[i] = (i < count) ? _tx[i] : 0x88;
+	}
+
+	memmove( _tx, &_tx[count], _txCount - count );
+	_txCount -= count;
+	_txReady -= count;
+
+#if TWI_REPLY_STATUS == 1
+	return len + 1;
+#else
+	return len;
+#endif
+}
+
+void SimA1C1Slave::advance( uint32_t us )
+{
+	_budgetUs += us;
+	while( _budgetUs >= _msgUs )
+	{
+		if( !process() )
+		{
+			_budgetUs = 0;					// idle. Time does not bank.
+			return;
+		}
+		_budgetUs -= _msgUs;
+	}
+}
+
+/*
+ * Take one message from the input FIFO. Returns false if there is no full message yet.
+ */
+bool SimA1C1Slave::process()
+{
+	uint8_t size;
+
+	if( _rxCount == 0 )
+	{
+		return false;
+	}
+
+	size = _rx[0] & 0x0F;
+	if( ((~_rx[0] >> 4) & 0x0F) != size )
+	{
+		++_errors;							// bad LEN. Drop the byte and sync on the next one.
+		memmove( _rx, &_rx[1], --_rxCount );
+		return true;
+	}
+	size += 3;
+	if( _rxCount < size )
+	{
+		return false;
+	}
+
+	++_messages;
+	command( _rx[1], _rx[2], &_rx[3], size - 3 );
+	_txReady = _txCount;					// twiTransmitReady()
+
+	_rxCount -= size;
+	memmove( _rx, &_rx[size], _rxCount );
+	return true;
+}
+
+void SimA1C1Slave::reply( uint8_t data )
+{
+	if( _txCount < SIM_FIFO_SIZE - 1 )
+	{
+		_tx[_txCount++] = data;
+	}
+}
+
+void SimA1C1Slave::command( uint8_t mod, uint8_t cmd, const uint8_t* data, uint8_t len )
+{
+	uint8_t count;
+	uint8_t i;
+
+	switch( mod )
+	{
+		case INIT_ID:
+			if( cmd == CMD_INIT_STATUS )
+			{
+				reply( 1 );
+				reply( SIM_DEVICE_COUNT );
+				for( i=0; i<4; ++i )
+					reply( 0 );
+			}
+			else if( (cmd == CMD_INIT_PROFILE) && (len >= 1) )
+			{
+				// COUNT then ID T_L T_H. Each device takes 25 counts (200us) to start.
+				count = (data[0] < SIM_DEVICE_COUNT) ? (uint8_t)(SIM_DEVICE_COUNT - data[0]) : 0;
+				reply( count );
+				for( i=data[0]; i<data[0] + count; ++i )
+				{
+					reply( simDevices[i] );
+					reply( (uint8_t)(25 * (i + 1)) );
+					reply( 0 );
+				}
+			}
+			break;
+
+		case DEV_LED_1_ID:
+			if( cmd == CMD_LED_OFF )
+				_ledOn = false;
+			else if( cmd == CMD_LED_ON )
+				_ledOn = true;
+			break;
+
+		case DEV_LED_PWM_ID:
+			if( cmd == CMD_LED_PWM_OFF )
+				_pwmOn = false;
+			else if( cmd == CMD_LED_PWM_ON )
+				_pwmOn = true;
+			else if( (cmd == CMD_LED_PWM_RATE) && (len >= 1) )
+				_pwmRate = data[0];
+			break;
+
+		case DEV_GPIO_ID:
+			if( cmd == CMD_GPIO_READ )
+			{
+				for( i=0; i<3; ++i )
+					reply( _port[i] );
+				break;
+			}
+			if( (cmd == CMD_GPIO_WRITE) && (len >= 6) )
+			{
+				for( i=0; i<3; ++i )
+					_port[i] = (_port[i] & ~data[2*i]) | (data[2*i + 1] & data[2*i]);
+				break;
+			}
+			if( len < 3 )
+				break;
+			for( i=0; i<3; ++i )
+			{
+				switch( cmd )
+				{
+					case CMD_GPIO_SET:		_port[i] |= data[i];	break;
+					case CMD_GPIO_CLEAR:	_port[i] &= ~data[i];	break;
+					case CMD_GPIO_TOGGLE:	_port[i] ^= data[i];	break;
+					case CMD_GPIO_OUTPUT:	_ddr[i] |= data[i];		break;
+					case CMD_GPIO_INPUT:	_ddr[i] &= ~data[i];	break;
+				}
+			}
+			break;
+
+		case DEV_ADC_ID:
+			if( (cmd == CMD_ADC_READ) && (len >= 1) )
+				reply( 0 );							// COUNT. Nothing sampled.
+			break;
+
+		case DEV_SEQ_ID:
+			if( cmd == CMD_SEQ_STATUS )
+			{
+				reply( SEQ_STATE_STOP );
+				reply( 0 );
+			}
+			break;
+
+		case CONFIG_ID:
+			if( (cmd == CMD_CFG_GET) && (len >= 1) && (data[0] < CFG_KEY_COUNT) )
+			{
+				reply( (uint8_t)_cfg[data[0]] );
+				reply( _cfg[data[0]] >> 8 );
+				reply( (_cfgValid >> data[0]) & 1 );
+			}
+			else if( (cmd == CMD_CFG_SET) && (len >= 3) && (data[0] < CFG_KEY_COUNT) )
+			{
+				_cfg[data[0]] = data[1] | (data[2] << 8);
+				_cfgValid |= (1 << data[0]);
+			}
+			break;
+
+		case I2C_ADRS_ID:
+			if( cmd == CMD_IA_UID )
+			{
+				for( i=0; i<IA_UID_SIZE; ++i )
+					reply( _uid[i] );
+			}
+			break;
+
+		default:
+			break;
+	}
+}
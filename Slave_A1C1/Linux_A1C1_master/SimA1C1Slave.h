@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SimA1C1Slave.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Behavioral model of a Slave_A1C1 node for SimBus.
+ *
+ * It has the same 32 byte input and output FIFOs and the READY status byte. One message is
+ * processed each msgUs of simulated time, so a read right after a write sees READY = 0 the
+ * same as the real Slave. The modules are modelled only as far as their replies:
+ *   INIT     STATUS PROFILE
+ *   LED-1    OFF ON		(ledOn())
+ *   PWM      OFF ON RATE	(pwmOn() pwmRate())
+ *   GPIO     all			PINx reads back PORTx
+ *   ADC      READ			no samples yet, COUNT = 0
+ *   SEQ      STATUS		always STOP
+ *   CONFIG   GET SET
+ *   I2C_ADRS UID
+ * Other valid messages are counted and dropped.
+ *
+ * revision: 10/17/2026	0.02	ndp		add INIT PROFILE.
+ * revision: 10/17/2026	0.03	ndp		add ADC READ, a reply shorter than asked for.
+ */ 
+
+
+#ifndef SIMA1C1SLAVE_H_
+#define SIMA1C1SLAVE_H_
+
+#include <stdint.h>
+
+#include "SimBus.h"
+#include "SlaveIds.h"
+
+#define SIM_FIFO_SIZE		32
+
+class SimA1C1Slave : public SimSlave
+{
+public:
+	explicit SimA1C1Slave( uint32_t uid = 0x12345678, uint32_t msgUs = 50 );
+
+	virtual void	receive( const uint8_t* data, uint8_t len );
+	virtual uint8_t	transmit( uint8_t* data, uint8_t len );
+	virtual void	advance( uint32_t us );
+
+	uint32_t	messages() const { return _messages; }		// valid messages processed.
+	uint32_t	errors() const { return _errors; }			// bad LEN or input FIFO overflow.
+	bool		ledOn() const { return _ledOn; }
+	bool		pwmOn() const { return _pwmOn; }
+	uint8_t		pwmRate() const { return _pwmRate; }
+	uint8_t		port( uint8_t index ) const { return _port[index]; }	// 0:B 1:C 2:D
+
+private:
+	bool	process();
+	void	command( uint8_t mod, uint8_t cmd, const uint8_t* data, uint8_t len );
+	void	reply( uint8_t data );
+
+	uint8_t		_rx[SIM_FIFO_SIZE];
+	uint8_t		_rxCount;
+	uint8_t		_tx[SIM_FIFO_SIZE];
+	uint8_t		_txCount;
+	uint8_t		_txReady;					// bytes of complete replies at the front of _tx.
+
+	uint32_t	_msgUs;
+	uint32_t	_budgetUs;
+	uint32_t	_messages;
+	uint32_t	_errors;
+
+	uint8_t		_uid[IA_UID_SIZE];
+	bool		_ledOn;
+	bool		_pwmOn;
+	uint8_t		_pwmRate;
+	uint8_t		_port[3];
+	uint8_t		_ddr[3];
+	uint16_t	_cfg[CFG_KEY_COUNT];
+	uint16_t	_cfgValid;
+};
+
+#endif /* SIMA1C1SLAVE_H_ */
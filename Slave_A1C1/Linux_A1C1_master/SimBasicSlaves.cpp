@@ -0,0 +1,203 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SimBasicSlaves.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#include <string.h>
+
+#include "SimBasicSlaves.h"
+
+#define SIM_TWI_UNDERRUN	0x88
+#define SIM_USI_UNDERRUN	0xFF
+
+SimFifoSlave::SimFifoSlave( bool usi, bool readyStatus, uint32_t loopUs, uint32_t stretchUs )
+	: _commands(0), _rxHead(0), _rxTail(0), _txHead(0), _txTail(0), _txReady(0),
+	  _usi(usi), _readyStatus(readyStatus), _loopUs(loopUs ? loopUs : 1),
+	  _stretchUs(usi ? stretchUs : 0), _budgetUs(0), _errors(0), _underruns(0)
+{
+	memset( _rx, 0, sizeof(_rx) );
+	memset( _tx, 0, sizeof(_tx) );
+}
+
+/*
+ * Same as the ISR. A byte that does not fit is dropped.
+ */
+void SimFifoSlave::receive( const uint8_t* data, uint8_t len )
+{
+	uint8_t head;
+	uint8_t i;
+
+	for( i=0; i<len; ++i )
+	{
+		head = (_rxHead + 1) & SIM_RING_MASK;
+		if( head == _rxTail )
+		{
+			++_errors;
+			continue;
+		}
+		_rx[head] = data[i];
+		_rxHead = head;
+	}
+}
+
+uint8_t SimFifoSlave::transmit( uint8_t* data, uint8_t len )
+{
+	uint8_t sending = 0;
+	uint8_t i = 0;
+	bool released = false;
+
+	if( _readyStatus && (len != 0) )
+	{
+		sending = (_txReady - _txTail) & SIM_RING_MASK;
+		data[i++] = sending;
+	}
+
+	for( ; i<len; ++i )
+	{
+		if( released )
+		{
+			data[i] = SIM_USI_UNDERRUN;
+			continue;
+		}
+
+		if( (_readyStatus && (sending == 0)) || (!_readyStatus && !txAvailable()) )
+		{
+			++_underruns;
+			if( _usi )
+			{
+				released = true;
+				data[i] = SIM_USI_UNDERRUN;
+			}
+			else
+			{
+				data[i] = SIM_TWI_UNDERRUN;
+			}
+			continue;
+		}
+
+		if( _readyStatus )
+		{
+			--sending;
+		}
+		_txTail = (_txTail + 1) & SIM_RING_MASK;
+		data[i] = _tx[_txTail];
+		loop();												// main loop runs while the byte shifts out.
+	}
+	return len;
+}
+
+void SimFifoSlave::advance( uint32_t us )
+{
+	_budgetUs += us;
+	while( _budgetUs >= _loopUs )
+	{
+		if( !loop() )
+		{
+			_budgetUs = 0;
+			return;
+		}
+		_budgetUs -= _loopUs;
+	}
+}
+
+uint8_t SimFifoSlave::rxByte()
+{
+	_rxTail = (_rxTail + 1) & SIM_RING_MASK;
+	return _rx[_rxTail];
+}
+
+void SimFifoSlave::txByte( uint8_t data )
+{
+	uint8_t head = (_txHead + 1) & SIM_RING_MASK;
+
+	if( head == _txTail )
+	{
+		++_errors;
+		return;
+	}
+	_tx[head] = data;
+	_txHead = head;
+}
+
+/* *** A1B1 A2B1 *** */
+SimLedSlave::SimLedSlave( bool usi, uint32_t loopUs, uint32_t stretchUs )
+	: SimFifoSlave( usi, false, loopUs, stretchUs ), _ledOn(false)
+{
+}
+
+bool SimLedSlave::loop()
+{
+	if( !rxAvailable() )
+	{
+		return false;
+	}
+	_ledOn = (rxByte() != 0);
+	++_commands;
+	return true;
+}
+
+/* *** A1B2 A2B2 *** */
+SimCountSlave::SimCountSlave( bool usi, uint32_t loopUs, uint32_t stretchUs )
+	: SimFifoSlave( usi, false, loopUs, stretchUs ), _count(0)
+{
+	loop();													// first pass after power up.
+}
+
+bool SimCountSlave::loop()
+{
+	if( txAvailable() )
+	{
+		return false;
+	}
+	txByte( _count );
+	++_count;
+	++_commands;
+	return true;
+}
+
+/* *** A1B3 *** */
+SimEchoSlave::SimEchoSlave( uint32_t loopUs )
+	: SimFifoSlave( false, true, loopUs, 0 ), _count(0)
+{
+}
+
+bool SimEchoSlave::loop()
+{
+	uint8_t data;
+
+	if( !rxAvailable() )
+	{
+		return false;
+	}
+	data = rxByte();
+	txByte( data );
+	txByte( (data == 0x55) ? _count : 0 );
+	txReady();
+	++_count;
+	++_commands;
+	return true;
+}
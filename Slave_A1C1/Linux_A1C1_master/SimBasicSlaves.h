@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SimBasicSlaves.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Behavioral models of the simple tutorial Slaves for SimBus.
+ *
+ *   SimLedSlave		A1B1 (TWI) A2B1 (USI)	each byte written sets the LED. 0:OFF else ON
+ *   SimCountSlave		A1B2 (TWI) A2B2 (USI)	each byte read is the next count
+ *   SimEchoSlave		A1B3 (TWI)				each byte written returns CMD and COUNT (or 0)
+ *
+ * The FIFOs work like Slave_Driver/twiSlave.c and usiTwiSlave.c: 32 byte rings that drop a
+ * byte that does not fit. An empty TX FIFO sends 0x88 (TWI) or releases the
+ * bus (USI) so the Master reads 0xFF. The main loop takes loopUs per pass and handles one
+ * byte per pass, as in the firmware. A multi-byte read gets one main loop pass between bytes,
+ * since a byte on the bus takes longer than a pass at any standard clock.
+ *
+ * The USI Slaves hold SCL low after each byte until the overflow ISR has run. stretchUs
+ * sets that time.
+ */ 
+
+
+#ifndef SIMBASICSLAVES_H_
+#define SIMBASICSLAVES_H_
+
+#include <stdint.h>
+
+#include "SimBus.h"
+
+#define SIM_RING_SIZE		32
+#define SIM_RING_MASK		(SIM_RING_SIZE - 1)
+
+#define SIM_LOOP_US			3			// main loop pass at 8MHz.
+#define SIM_USI_STRETCH_US	10			// USI overflow ISR at 8MHz.
+
+class SimFifoSlave : public SimSlave
+{
+public:
+	SimFifoSlave( bool usi, bool readyStatus, uint32_t loopUs, uint32_t stretchUs );
+
+	virtual void	receive( const uint8_t* data, uint8_t len );
+	virtual uint8_t	transmit( uint8_t* data, uint8_t len );
+	virtual void	advance( uint32_t us );
+	virtual uint32_t stretchUs() const { return _stretchUs; }
+
+	uint32_t	commands() const { return _commands; }	// bytes handled by the main loop.
+	uint32_t	errors() const { return _errors; }		// FIFO overflows. Data was lost.
+	uint32_t	underruns() const { return _underruns; }	// bytes read with no data to send.
+
+protected:
+	virtual bool loop() = 0;							// one main loop pass. false if idle.
+
+	bool	rxAvailable() const { return _rxHead != _rxTail; }
+	uint8_t	rxByte();
+	bool	txAvailable() const { return _txHead != _txTail; }
+	void	txByte( uint8_t data );
+	void	txReady() { _txReady = _txHead; }
+
+	uint32_t	_commands;
+
+private:
+	uint8_t		_rx[SIM_RING_SIZE];
+	uint8_t		_rxHead;
+	uint8_t		_rxTail;
+	uint8_t		_tx[SIM_RING_SIZE];
+	uint8_t		_txHead;
+	uint8_t		_txTail;
+	uint8_t		_txReady;
+
+	bool		_usi;
+	bool		_readyStatus;
+	uint32_t	_loopUs;
+	uint32_t	_stretchUs;
+	uint32_t	_budgetUs;
+	uint32_t	_errors;
+	uint32_t	_underruns;
+};
+
+class SimLedSlave : public SimFifoSlave
+{
+public:
+	explicit SimLedSlave( bool usi, uint32_t loopUs = SIM_LOOP_US, uint32_t stretchUs = SIM_USI_STRETCH_US );
+
+	bool	ledOn() const { return _ledOn; }
+
+protected:
+	virtual bool loop();
+
+private:
+	bool	_ledOn;
+};
+
+class SimCountSlave : public SimFifoSlave
+{
+public:
+	explicit SimCountSlave( bool usi, uint32_t loopUs = SIM_LOOP_US, uint32_t stretchUs = SIM_USI_STRETCH_US );
+
+protected:
+	virtual bool loop();
+
+private:
+	uint8_t	_count;
+};
+
+class SimEchoSlave : public SimFifoSlave
+{
+public:
+	explicit SimEchoSlave( uint32_t loopUs = SIM_LOOP_US );
+
+protected:
+	virtual bool loop();
+
+private:
+	uint8_t	_count;
+};
+
+#endif /* SIMBASICSLAVES_H_ */
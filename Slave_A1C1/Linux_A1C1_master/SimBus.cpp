@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SimBus.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Bus time per transaction is START + 9 bits per byte (address and data) + 1 bit for each
+ * repeated START + STOP. A Slave that stretches the clock adds its stretchUs() to each byte
+ * it takes part in, address byte included. Written bytes reach the Slave one at a time as they
+ * cross the bus, so a Slave can work on the first bytes of a long write before the last arrive.
+ *
+ * revision: 10/17/2026	0.02	ndp		add Slave clock stretching. Byte by byte writes.
+ * revision: 10/17/2026	0.03	ndp		transfer() reports the part that NACKed.
+ */ 
+
+#include <string.h>
+
+#include "SimBus.h"
+
+SimBus::SimBus( uint32_t clockHz )
+	: _clockHz(clockHz), _timeUs(0), _transactions(0), _bytes(0), _bits(0), _bitsUs(0)
+{
+	memset( _slaves, 0, sizeof(_slaves) );
+}
+
+void SimBus::attach( uint8_t adrs, SimSlave* slave )
+{
+	_slaves[adrs & 0x7F] = slave;
+}
+
+void SimBus::detach( uint8_t adrs )
+{
+	_slaves[adrs & 0x7F] = 0;
+}
+
+void SimBus::resetStats()
+{
+	_timeUs = 0;
+	_transactions = 0;
+	_bytes = 0;
+}
+
+/*
+ * Spend the bus time of BITS plus any clock stretch.
+ */
+void SimBus::spendBits( uint32_t bits, uint32_t stretchUs )
+{
+	uint64_t us;
+
+	_bits += bits;
+	us = (_bits * 1000000) / _clockHz;
+	spend( (uint32_t)(us - _bitsUs) + stretchUs );
+	_bitsUs = us;
+}
+
+void SimBus::spend( uint32_t us )
+{
+	uint8_t i;
+
+	_timeUs += us;
+	for( i=0; i<128; ++i )
+	{
+		if( _slaves[i] != 0 )
+		{
+			_slaves[i]->advance( us );
+		}
+	}
+}
+
+uint8_t SimBus::write( uint8_t adrs, const uint8_t* data, uint8_t len )
+{
+	SlaveBusMsg msg = { adrs, 0, len, (uint8_t*)data };
+	return transfer( &msg, 1 );
+}
+
+uint8_t SimBus::read( uint8_t adrs, uint8_t* data, uint8_t len )
+{
+	SlaveBusMsg msg = { adrs, SB_READ, len, data };
+
+	if( transfer( &msg, 1 ) != SB_OK )
+	{
+		return 0;
+	}
+	return msg.len;
+}
+
+void SimBus::delayMs( uint16_t ms )
+{
+	spend( (uint32_t)ms * 1000 );
+}
+
+/*
+ * A combined transaction. Each part takes its bus time before the next one starts.
+ * A missing Slave NACKs its address and ends the transaction, like I2C_RDWR.
+ */
+uint8_t SimBus::transfer( SlaveBusMsg* msgs, uint8_t count, uint8_t* done )
+{
+	SimSlave* slave;
+	uint8_t status = SB_OK;
+	uint8_t i;
+	uint8_t j;
+
+	++_transactions;
+	spendBits( 1 );											// START
+
+	for( i=0; i<count; ++i )
+	{
+		slave = _slaves[msgs[i].adrs & 0x7F];
+		_bytes += 1;
+		if( slave == 0 )
+		{
+			spendBits( 9 );
+			status = SB_ERR_ADRS_NACK;
+			break;
+		}
+		spendBits( 9, slave->stretchUs() );					// address
+
+		if( msgs[i].flags & SB_READ )
+		{
+			msgs[i].len = slave->transmit( msgs[i].buf, msgs[i].len );
+			spendBits( 9 * msgs[i].len, slave->stretchUs() * msgs[i].len );
+		}
+		else
+		{
+			for( j=0; j<msgs[i].len; ++j )
+			{
+				slave->receive( &msgs[i].buf[j], 1 );
+				spendBits( 9, slave->stretchUs() );
+			}
+		}
+		_bytes += msgs[i].len;
+
+		if( i + 1 < count )
+		{
+			spendBits( 1 );									// repeated START
+		}
+	}
+
+	spendBits( 1 );											// STOP
+	if( done )
+	{
+		*done = i;
+	}
+	return status;
+}
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SimBus.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * In-process simulated I2C bus. Slaves are SimSlave objects attached at an address.
+ * Time is simulated: each transaction adds its bus time at the set clock, and delayMs() adds
+ * the delay. Slaves see the time pass through advance() so they can take time to process
+ * a command, the same as a real Slave between the write and the read.
+ *
+ * revision: 10/17/2026	0.02	ndp		add stretchUs() for Slaves that hold SCL low after each byte.
+ *									Writes reach the Slave one byte at a time.
+ */ 
+
+
+#ifndef SIMBUS_H_
+#define SIMBUS_H_
+
+#include <stdint.h>
+
+#include "SlaveBus.h"
+
+class SimSlave
+{
+public:
+	virtual ~SimSlave() {}
+
+	virtual void	receive( const uint8_t* data, uint8_t len ) = 0;	// Master wrote LEN bytes.
+	virtual uint8_t	transmit( uint8_t* data, uint8_t len ) = 0;		// Master reads LEN bytes. Always fills LEN.
+	virtual void	advance( uint32_t us ) { (void)us; }				// simulated time passed.
+	virtual uint32_t stretchUs() const { return 0; }				// SCL held low after each byte.
+};
+
+class SimBus : public SlaveBus
+{
+public:
+	explicit SimBus( uint32_t clockHz = 100000 );
+
+	uint32_t	clockHz() const { return _clockHz; }
+
+	void	attach( uint8_t adrs, SimSlave* slave );
+	void	detach( uint8_t adrs );
+
+	virtual uint8_t write( uint8_t adrs, const uint8_t* data, uint8_t len );
+	virtual uint8_t read( uint8_t adrs, uint8_t* data, uint8_t len );
+	virtual void delayMs( uint16_t ms );
+	virtual uint8_t transfer( SlaveBusMsg* msgs, uint8_t count, uint8_t* done = 0 );
+
+	void		wait( uint32_t us ) { spend( us ); }		// let time pass without bus traffic.
+	uint64_t	timeUs() const { return _timeUs; }
+	uint32_t	transactions() const { return _transactions; }
+	uint32_t	bytes() const { return _bytes; }			// address and data bytes on the bus.
+	void		resetStats();
+
+private:
+	void	spend( uint32_t us );
+	void	spendBits( uint32_t bits, uint32_t stretchUs = 0 );
+
+	SimSlave*	_slaves[128];
+	uint32_t	_clockHz;
+	uint64_t	_timeUs;
+	uint32_t	_transactions;
+	uint32_t	_bytes;
+	uint64_t	_bits;						// bus bits so far, to keep the bit time exact over many bytes.
+	uint64_t	_bitsUs;
+};
+
+#endif /* SIMBUS_H_ */
@@ -0,0 +1,329 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * a1c1d.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Linux I2C Master daemon for Slave_A1C1 nodes.
+ *
+ *   a1c1d -d /dev/i2c-1		use the I2C adapter
+ *   a1c1d -s 4				use a simulated bus with 4 nodes at 0x40:0x43
+ *   -S						scan the buses first and list the Slaves found. This writes an
+ *							INIT STATUS to any A1B3, which it takes as echo commands.
+ *   -v						print the bus statistics at the end
+ * -d and -s can be given more than once for more buses. They are numbered 0, 1, .. in order
+ * and each is run by its own thread.
+ *
+ * Commands are read from stdin, one per line, in hex:
+ *   [BUS:]ADRS MOD CMD [DATA ...] [?N]		?N reads N reply bytes. BUS is 0 if not given.
+ *   40 30 02						PWM ON at 0x40
+ *   1:41 60 07 ?3					GPIO READ at 0x41 on bus 1
+ * Lines that arrive together are queued and run together, pipelined across the Slaves.
+ * Each result is printed as
+ *   LINE [BUS:]ADRS MOD CMD STATUS [REPLY ...]
+ * and each Slave found by -S as
+ *   scan [BUS:]ADRS TYPE DEVICES [ID ...]
+ *
+ * revision: 10/17/2026	0.02	ndp		more than one bus with MasterPool. Add -S bus scan.
+ * revision: 10/17/2026	0.03	ndp		read() stdin into a line buffer. Wait on MasterPool doneFd().
+ * revision: 10/17/2026	0.04	ndp		note that -S writes to A1B3 nodes.
+ */ 
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "BusScanner.h"
+#include "LinuxI2cBus.h"
+#include "MasterPool.h"
+#include "SimA1C1Slave.h"
+#include "SimBus.h"
+
+#define D_BUSES_MAX		8
+#define D_LINE_MAX		256				// a longer line is a bad command.
+
+static void usage()
+{
+	fprintf( stderr, "usage: a1c1d (-d /dev/i2c-N | -s NODES) ... [-S] [-v]\n" );
+	exit( 2 );
+}
+
+/*
+ * Parse one command line. Returns false for a blank or bad line.
+ */
+static bool parse( const char* line, uint32_t tag, MasterRequest& req )
+{
+	std::vector<unsigned long> v;
+	const char* p = line;
+	char* end;
+	unsigned long n;
+
+	memset( &req, 0, sizeof(req) );
+	req.tag = tag;
+
+	while( *p )
+	{
+		while( (*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r') )
+			++p;
+		if( (*p == 0) || (*p == '#') )
+			break;
+		if( *p == '?' )
+		{
+			req.replyLen = (uint8_t)strtoul( p + 1, &end, 10 );
+			if( (end == p + 1) || (req.replyLen > SM_REPLY_MAX) )
+				return false;
+			p = end;
+			continue;
+		}
+		n = strtoul( p, &end, 16 );
+		if( (end == p) || (n > 0xFF) )
+			return false;
+		if( (*end == ':') && v.empty() )
+		{
+			req.bus = (uint8_t)n;
+			p = end + 1;
+			continue;
+		}
+		v.push_back( n );
+		p = end;
+	}
+
+	if( (v.size() < 3) || (v.size() > 3 + SM_DATA_MAX) || (v[0] > 0x7F) )
+		return false;
+
+	req.adrs = (uint8_t)v[0];
+	req.mod = (uint8_t)v[1];
+	req.cmd = (uint8_t)v[2];
+	req.len = (uint8_t)(v.size() - 3);
+	for( size_t i=3; i<v.size(); ++i )
+		req.data[i - 3] = (uint8_t)v[i];
+	return true;
+}
+
+static void printAdrs( uint8_t bus, uint8_t adrs, bool multi )
+{
+	if( multi )
+		printf( "%u:%02X", bus, adrs );
+	else
+		printf( "%02X", adrs );
+}
+
+static void print( const std::vector<MasterRequest>& done, bool multi )
+{
+	for( size_t i=0; i<done.size(); ++i )
+	{
+		const MasterRequest& r = done[i];
+
+		printf( "%u ", r.tag );
+		printAdrs( r.bus, r.adrs, multi );
+		printf( " %02X %02X %02X", r.mod, r.cmd, r.status );
+		for( uint8_t j=0; j<r.replyCount; ++j )
+			printf( " %02X", r.reply[j] );
+		printf( "\n" );
+	}
+	fflush( stdout );
+}
+
+/*
+ * Queue one input line.
+ */
+static void command( MasterPool& pool, const std::string& line, uint32_t tag )
+{
+	MasterRequest req;
+	size_t first = line.find_first_not_of( " \t\r\n" );
+
+	if( parse( line.c_str(), tag, req ) )
+	{
+		if( !pool.submit( req ) )
+			printf( "%u not queued\n", tag );
+	}
+	else if( (first != std::string::npos) && (line[first] != '#') )
+	{
+		printf( "%u bad command\n", tag );
+	}
+	fflush( stdout );
+}
+
+static void scan( SlaveBus& bus, uint8_t index, bool multi )
+{
+	static const char* types[] = { "A1C1", "starting", "other", "idle" };
+	std::vector<SlaveInfo> found;
+	BusScanner scanner( bus );
+
+	scanner.scan( found );
+	for( size_t i=0; i<found.size(); ++i )
+	{
+		printf( "scan " );
+		printAdrs( index, found[i].adrs, multi );
+		printf( " %s %u", types[found[i].type], found[i].devices );
+		for( uint8_t j=0; j<found[i].idCount; ++j )
+			printf( " %02X", found[i].ids[j] );
+		printf( "\n" );
+	}
+	fflush( stdout );
+}
+
+int main( int argc, char** argv )
+{
+	std::vector<SlaveBus*> buses;
+	std::vector<SimBus*> sims;
+	std::vector<SimA1C1Slave*> slaves;
+	bool verbose = false;
+	bool scanFirst = false;
+	int opt;
+	int nodes;
+
+	while( (opt = getopt( argc, argv, "d:s:Sv" )) != -1 )
+	{
+		switch( opt )
+		{
+			case 'd':
+			{
+				LinuxI2cBus* i2c = new LinuxI2cBus;
+
+				if( !i2c->open( optarg ) )
+				{
+					perror( optarg );
+					return 1;
+				}
+				buses.push_back( i2c );
+				sims.push_back( 0 );
+				break;
+			}
+			case 's':
+			{
+				SimBus* sim = new SimBus;
+
+				nodes = atoi( optarg );
+				for( int i=0; i<nodes && i<0x40; ++i )
+				{
+					slaves.push_back( new SimA1C1Slave( 0x1000 * buses.size() + i ) );
+					sim->attach( SLAVE_ADRS + i, slaves.back() );
+				}
+				buses.push_back( sim );
+				sims.push_back( sim );
+				break;
+			}
+			case 'S': scanFirst = true; break;
+			case 'v': verbose = true; break;
+			default: usage();
+		}
+	}
+	if( buses.empty() || (buses.size() > D_BUSES_MAX) )
+		usage();
+
+	bool multi = (buses.size() > 1);
+	MasterPool pool;
+
+	for( size_t i=0; i<buses.size(); ++i )
+	{
+		if( scanFirst )
+			scan( *buses[i], (uint8_t)i, multi );
+		pool.addBus( *buses[i] );
+	}
+	pool.start();
+
+	std::vector<MasterRequest> done;
+	std::string input;
+	char buf[D_LINE_MAX];
+	uint32_t tag = 0;
+	bool eof = false;
+	struct pollfd pfd[2];
+	size_t end;
+	ssize_t n;
+
+	pfd[1].fd = pool.doneFd();
+	pfd[1].events = POLLIN;
+
+	while( !eof || (pool.pending() != 0) )
+	{
+		// Print what is done before waiting, so no result sits behind a blocking poll.
+		done.clear();
+		pool.collect( done, false );
+		print( done, multi );
+
+		// Wait for input or results. stdin is left out after EOF.
+		pfd[0].fd = eof ? -1 : 0;
+		pfd[0].events = POLLIN;
+		if( poll( pfd, 2, -1 ) < 0 )
+		{
+			if( errno == EINTR )
+				continue;
+			perror( "poll" );
+			break;
+		}
+		if( pfd[0].revents == 0 )
+			continue;
+
+		// Only read() here, so no input waits in a stdio buffer that poll() can not see.
+		n = read( 0, buf, sizeof(buf) );
+		if( n < 0 )
+		{
+			if( errno == EINTR )
+				continue;
+			perror( "stdin" );
+		}
+		if( n <= 0 )
+		{
+			eof = true;
+			if( !input.empty() )
+				command( pool, input, ++tag );
+			input.clear();
+			continue;
+		}
+
+		// Lines that arrived together are all queued before the next wait.
+		input.append( buf, n );
+		while( ((end = input.find( '\n' )) != std::string::npos) || (input.size() >= D_LINE_MAX) )
+		{
+			end = (end == std::string::npos) ? input.size() : end + 1;
+			command( pool, input.substr( 0, end ), ++tag );
+			input.erase( 0, end );
+		}
+	}
+	done.clear();
+	pool.collect( done, false );
+	print( done, multi );
+	pool.stop();
+
+	for( size_t i=0; i<buses.size(); ++i )
+	{
+		if( verbose && sims[i] )
+		{
+			fprintf( stderr, "bus %u: %llu us, %u transactions, %u bytes\n", (unsigned)i,
+					 (unsigned long long)sims[i]->timeUs(), sims[i]->transactions(), sims[i]->bytes() );
+		}
+		delete buses[i];
+	}
+	for( size_t i=0; i<slaves.size(); ++i )
+		delete slaves[i];
+	return 0;
+}
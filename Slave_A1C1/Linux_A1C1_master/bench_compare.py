@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# bench_compare.py
+#
+# Created: 10/17/2026		0.01	ndp
+#  Author: Chip
+#
+# revision: 10/17/2026	0.02	ndp		compare the fan-out results too.
+#
+# Compares a slavebench report against a baseline and lists the regressions.
+# Exit status is 1 if there are any.
+#
+#   python3 bench_compare.py bench_baseline.json bench_report.json [-t PERCENT]
+#
+# A throughput that drops, or an average round trip that grows, by more than PERCENT
+# (default 5) is a regression. So is any rise in the saturation error rate. Fan-out results
+# are compared on their commands/s and errors.
+
+import argparse
+import json
+import sys
+
+HIGHER = ('write_cmds_per_s', 'read_bytes_per_s')
+LOWER = ('rtt_us_avg',)
+FAN_HIGHER = ('serial_cmds_per_s', 'queued_cmds_per_s')
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    results = {(r['variant'], r['clock_hz']): r for r in report['results']}
+    fanout = {('%u nodes' % r['slaves'], r['clock_hz']): r for r in report.get('fanout', [])}
+    return results, fanout
+
+
+def compare(base, new, higher, lower, errors, tol):
+    bad = 0
+    for key in sorted(base):
+        if key not in new:
+            print('%s %u: missing' % key)
+            bad += 1
+            continue
+        b = base[key]
+        n = new[key]
+        for name in higher + lower:
+            if b[name] is None:
+                continue
+            if n[name] is None:
+                print('%s %u: %s missing' % (key + (name,)))
+                bad += 1
+                continue
+            change = (n[name] - b[name]) / b[name] if b[name] else 0.0
+            if (name in higher and change < -tol) or (name in lower and change > tol):
+                print('%s %u: %s %.1f -> %.1f (%+.1f%%)' % (key + (name, b[name], n[name], change * 100)))
+                bad += 1
+        if n[errors] > b[errors]:
+            print('%s %u: %s %s -> %s' % (key + (errors, b[errors], n[errors])))
+            bad += 1
+    return bad
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument('baseline')
+    ap.add_argument('report')
+    ap.add_argument('-t', type=float, default=5.0, help='tolerance in percent')
+    args = ap.parse_args()
+
+    base, base_fan = load(args.baseline)
+    new, new_fan = load(args.report)
+    tol = args.t / 100.0
+
+    bad = compare(base, new, HIGHER, LOWER, 'sat_error_rate', tol)
+    bad += compare(base_fan, new_fan, FAN_HIGHER, (), 'errors', tol)
+
+    print('%u regression%s' % (bad, '' if bad == 1 else 's'))
+    return 1 if bad else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,726 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * slavebench.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add the fan-out test.
+ *
+ * Throughput and latency benchmark for the tutorial Slaves.
+ *
+ *   slavebench						all variants on the simulated bus at 100kHz and 400kHz
+ *   slavebench -p A1B3 -k 400000	one variant, one clock
+ *   slavebench -d /dev/i2c-1 -p A1C1 -k 400000
+ *									a real Slave. The adapter sets the clock, -k only labels it.
+ *   -a ADRS	Slave address (hex, default 40)
+ *   -n OPS		rounds per test (default 1000)
+ *   -o FILE	write the JSON report to FILE instead of stdout
+ *   -u US		USI clock stretch per byte for the A2 models (default 10)
+ *   -f			add the fan-out test
+ *   -m US		A1C1 message time for the fan-out test (default 1000)
+ *
+ * Tests. A test that a variant can not do reports null.
+ *   write_cmds_per_s	one command per write, back to back. A1B3 must read each reply before the
+ *						next command, so its number is for the whole write and read.
+ *   read_bytes_per_s	reply data bytes read per second with the largest reads the Slave gives.
+ *						READY bytes are not counted.
+ *   rtt_us_*			write of a query to its complete reply, polling on READY.
+ *   sat_*				the most the Master can offer: full FIFO writes or reads back to back with
+ *						no waiting. An error round is a NACK, a wrong or late reply, or (simulated
+ *						bus only) data the Slave lost to a FIFO overflow.
+ *
+ * Fan-out (-f). Each A1C1 node gets the same stream of LED ON/OFF and GPIO READ commands, run
+ * first one at a time with SlaveMaster (write, then poll for each reply) and then all together
+ * with MasterQueue. On the simulated bus it runs with 1 to 16 nodes that each take -m us per
+ * message, a stand-in for a node with all of its devices running. With -d it runs on the
+ * A1C1 nodes that BusScanner finds.
+ *
+ * A table goes to stderr for reading. The JSON report is for regression tracking, see
+ * bench_compare.py.
+ */ 
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "BusScanner.h"
+#include "LinuxI2cBus.h"
+#include "MasterQueue.h"
+#include "SimA1C1Slave.h"
+#include "SimBasicSlaves.h"
+#include "SimBus.h"
+#include "SlaveMaster.h"
+
+#define BENCH_OPS			1000
+#define BENCH_POLLS			200			// READY polls before a reply is counted lost.
+#define BENCH_ECHO_BATCH	15			// A1B3 commands per write. 30 reply bytes fit the TX FIFO.
+#define BENCH_A1C1_BATCH	7			// A1C1 LED commands ahead of the query in a saturation round.
+#define BENCH_READ_MAX		32
+#define BENCH_FAN_MSG_US	1000
+#define BENCH_FAN_MAX		16			// simulated nodes in the largest fan-out.
+
+enum { KIND_LED, KIND_COUNT, KIND_ECHO, KIND_A1C1 };
+
+typedef struct
+{
+	const char*	name;
+	uint8_t		kind;
+	bool		usi;
+} BenchVariant;
+
+static const BenchVariant variants[] =
+{
+	{ "A1B1", KIND_LED,   false },
+	{ "A1B2", KIND_COUNT, false },
+	{ "A1B3", KIND_ECHO,  false },
+	{ "A1C1", KIND_A1C1,  false },
+	{ "A2B1", KIND_LED,   true  },
+	{ "A2B2", KIND_COUNT, true  },
+};
+
+#define VARIANT_COUNT	(sizeof(variants) / sizeof(variants[0]))
+
+typedef struct
+{
+	double		writeCmds;					// < 0 is n/a for all of these.
+	double		readBytes;
+	double		rttMin;
+	double		rttAvg;
+	double		rttMax;
+	uint32_t	satRounds;
+	uint32_t	satErrors;
+} BenchResult;
+
+class Bench
+{
+public:
+	Bench( SlaveBus& bus, SimBus* sim, uint8_t adrs, uint32_t ops )
+		: _bus(bus), _sim(sim), _adrs(adrs), _ops(ops), _fifo(0), _node(0), _count(0), _countValid(false) {}
+
+	void	setModel( const SimFifoSlave* fifo ) { _fifo = fifo; }
+	void	setModel( const SimA1C1Slave* node ) { _node = node; }
+	void	run( const BenchVariant& v, BenchResult& r );
+
+private:
+	uint64_t	now();
+	uint32_t	lost() const { return _fifo ? _fifo->errors() : (_node ? _node->errors() : 0); }
+	bool		pollReply( uint8_t len, uint8_t* buf );
+	bool		readCounts( uint8_t len, bool& ok );
+
+	void	led( BenchResult& r );
+	void	count( BenchResult& r );
+	void	echo( BenchResult& r );
+	void	a1c1( BenchResult& r );
+
+	SlaveBus&		_bus;
+	SimBus*			_sim;
+	uint8_t			_adrs;
+	uint32_t		_ops;
+	const SimFifoSlave*	_fifo;			// the simulated Slave, for its FIFO overflow count.
+	const SimA1C1Slave*	_node;
+	uint8_t			_count;				// next A1B2 count expected.
+	bool			_countValid;
+};
+
+static uint64_t nowUs( SimBus* sim )
+{
+	struct timespec ts;
+
+	if( sim )
+	{
+		return sim->timeUs();
+	}
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint64_t Bench::now()
+{
+	return nowUs( _sim );
+}
+
+static double perSec( double count, uint64_t us )
+{
+	return (us == 0) ? 0.0 : count * 1000000.0 / (double)us;
+}
+
+/*
+ * Read READY and LEN reply bytes until READY is not 0. Leaves the reply in BUF[1..].
+ * Returns false if it never came or was the wrong size.
+ */
+bool Bench::pollReply( uint8_t len, uint8_t* buf )
+{
+	uint16_t i;
+
+	for( i=0; i<BENCH_POLLS; ++i )
+	{
+		if( _bus.read( _adrs, buf, len + 1 ) != len + 1 )
+		{
+			return false;
+		}
+		if( buf[0] != 0 )
+		{
+			return buf[0] == len;
+		}
+	}
+	return false;
+}
+
+void Bench::run( const BenchVariant& v, BenchResult& r )
+{
+	r.writeCmds = -1;
+	r.readBytes = -1;
+	r.rttMin = -1;
+	r.rttAvg = -1;
+	r.rttMax = -1;
+	r.satRounds = 0;
+	r.satErrors = 0;
+
+	switch( v.kind )
+	{
+		case KIND_LED:		led( r );	break;
+		case KIND_COUNT:	count( r );	break;
+		case KIND_ECHO:		echo( r );	break;
+		case KIND_A1C1:		a1c1( r );	break;
+	}
+}
+
+/* *** A1B1 A2B1 *** */
+void Bench::led( BenchResult& r )
+{
+	uint8_t buf[SIM_RING_SIZE - 1];
+	uint64_t start;
+	uint32_t before;
+	uint32_t i;
+
+	start = now();
+	for( i=0; i<_ops; ++i )
+	{
+		buf[0] = i & 1;
+		_bus.write( _adrs, buf, 1 );
+	}
+	r.writeCmds = perSec( _ops, now() - start );
+
+	for( i=0; i<sizeof(buf); ++i )
+	{
+		buf[i] = i & 1;
+	}
+	for( i=0; i<_ops; ++i )
+	{
+		before = lost();
+		if( (_bus.write( _adrs, buf, sizeof(buf) ) != SB_OK) || (lost() != before) )
+		{
+			++r.satErrors;
+		}
+	}
+	r.satRounds = _ops;
+}
+
+/* *** A1B2 A2B2 *** */
+/*
+ * Read LEN counts and check that they follow on from the last read.
+ * Returns false on a NACK. OK is false if any count was wrong.
+ */
+bool Bench::readCounts( uint8_t len, bool& ok )
+{
+	uint8_t buf[BENCH_READ_MAX];
+	uint8_t i;
+
+	ok = true;
+	if( _bus.read( _adrs, buf, len ) != len )
+	{
+		ok = false;
+		return false;
+	}
+	for( i=0; i<len; ++i )
+	{
+		if( _countValid && (buf[i] != _count) )
+		{
+			ok = false;
+		}
+		_count = buf[i] + 1;
+		_countValid = true;
+	}
+	return true;
+}
+
+void Bench::count( BenchResult& r )
+{
+	uint64_t start;
+	uint32_t bytes = 0;
+	uint32_t i;
+	bool ok;
+
+	_countValid = false;
+	readCounts( 1, ok );									// sync to the count.
+
+	// One byte per read is what the demo does. Longer reads are the most the Slave can give.
+	start = now();
+	for( i=0; i<_ops; ++i )
+	{
+		if( readCounts( BENCH_READ_MAX, ok ) )
+		{
+			bytes += BENCH_READ_MAX;
+		}
+	}
+	r.readBytes = perSec( bytes, now() - start );
+
+	for( i=0; i<_ops; ++i )
+	{
+		readCounts( BENCH_READ_MAX, ok );
+		if( !ok )
+		{
+			++r.satErrors;
+		}
+	}
+	r.satRounds = _ops;
+}
+
+/* *** A1B3 *** */
+void Bench::echo( BenchResult& r )
+{
+	uint8_t cmds[BENCH_ECHO_BATCH];
+	uint8_t buf[1 + 2 * BENCH_ECHO_BATCH];
+	uint8_t cmd = 0x55;
+	uint64_t start;
+	uint64_t t;
+	uint64_t total = 0;
+	uint32_t bytes = 0;
+	uint32_t i;
+	bool ok;
+
+	memset( cmds, 0x55, sizeof(cmds) );
+
+	start = now();
+	for( i=0; i<_ops; ++i )
+	{
+		_bus.write( _adrs, &cmd, 1 );
+		pollReply( 2, buf );
+	}
+	r.writeCmds = perSec( _ops, now() - start );
+
+	start = now();
+	for( i=0; i<_ops; ++i )
+	{
+		_bus.write( _adrs, cmds, sizeof(cmds) );
+		if( pollReply( 2 * BENCH_ECHO_BATCH, buf ) )
+		{
+			bytes += 2 * BENCH_ECHO_BATCH;
+		}
+	}
+	r.readBytes = perSec( bytes, now() - start );
+
+	r.rttMin = 1e12;
+	r.rttMax = 0;
+	for( i=0; i<_ops; ++i )
+	{
+		t = now();
+		_bus.write( _adrs, &cmd, 1 );
+		pollReply( 2, buf );
+		t = now() - t;
+		total += t;
+		if( t < r.rttMin )	r.rttMin = (double)t;
+		if( t > r.rttMax )	r.rttMax = (double)t;
+	}
+	r.rttAvg = (double)total / _ops;
+
+	// No polling. A reply that is not there at once is an error, then polled for so the
+	// next round starts clean.
+	for( i=0; i<_ops; ++i )
+	{
+		ok = (_bus.write( _adrs, cmds, sizeof(cmds) ) == SB_OK);
+		if( ok && (_bus.read( _adrs, buf, sizeof(buf) ) == sizeof(buf)) )
+		{
+			ok = (buf[0] == 2 * BENCH_ECHO_BATCH) && (buf[1] == 0x55);
+			if( buf[0] == 0 )
+			{
+				pollReply( 2 * BENCH_ECHO_BATCH, buf );
+			}
+		}
+		else
+		{
+			ok = false;
+		}
+		if( !ok )
+		{
+			++r.satErrors;
+		}
+	}
+	r.satRounds = _ops;
+}
+
+/* *** A1C1 *** */
+void Bench::a1c1( BenchResult& r )
+{
+	SlaveMaster sm( _bus, _adrs );
+	SlaveReply reply;
+	uint8_t buf[4];
+	uint8_t pinb, pinc, pind;
+	uint64_t start;
+	uint64_t t;
+	uint64_t total = 0;
+	uint32_t bytes = 0;
+	uint32_t before;
+	uint32_t i;
+	uint8_t j;
+	bool ok;
+
+	sm.setRetry( 1, 0 );
+	sm.setReplyPolls( BENCH_POLLS );
+
+	start = now();
+	for( i=0; i<_ops; ++i )
+	{
+		(i & 1) ? sm.ledOn() : sm.ledOff();
+	}
+	r.writeCmds = perSec( _ops, now() - start );
+
+	start = now();
+	for( i=0; i<_ops; ++i )
+	{
+		if( sm.initStatus( reply ) == SM_OK )
+		{
+			bytes += reply.count();
+		}
+	}
+	r.readBytes = perSec( bytes, now() - start );
+
+	r.rttMin = 1e12;
+	r.rttMax = 0;
+	for( i=0; i<_ops; ++i )
+	{
+		t = now();
+		sm.gpioRead( pinb, pinc, pind );
+		t = now() - t;
+		total += t;
+		if( t < r.rttMin )	r.rttMin = (double)t;
+		if( t > r.rttMax )	r.rttMax = (double)t;
+	}
+	r.rttAvg = (double)total / _ops;
+
+	for( i=0; i<_ops; ++i )
+	{
+		before = lost();
+		sm.beginBatch();
+		for( j=0; j<BENCH_A1C1_BATCH; ++j )
+		{
+			(j & 1) ? sm.ledOn() : sm.ledOff();
+		}
+		sm.command( DEV_GPIO_ID, CMD_GPIO_READ );
+		ok = (sm.endBatch() == SM_OK);
+		if( ok && (_bus.read( _adrs, buf, sizeof(buf) ) == sizeof(buf)) )
+		{
+			ok = (buf[0] == 3);
+			if( buf[0] == 0 )
+			{
+				pollReply( 3, buf );
+			}
+		}
+		else
+		{
+			ok = false;
+		}
+		if( !ok || (lost() != before) )
+		{
+			++r.satErrors;
+		}
+	}
+	r.satRounds = _ops;
+}
+
+/* *** Fan-out *** */
+/*
+ * ROUNDS of LED and GPIO READ to each node. Returns commands per second one at a time in
+ * SERIAL and queued in QUEUED. ERRORS counts the commands that failed either way.
+ */
+static void fanout( SlaveBus& bus, SimBus* sim, const std::vector<uint8_t>& nodes, uint32_t rounds,
+					double& serial, double& queued, uint32_t& errors )
+{
+	SlaveMaster sm( bus );
+	MasterQueue queue( bus );
+	std::vector<MasterRequest> done;
+	MasterRequest req;
+	uint8_t pinb, pinc, pind;
+	uint32_t cmds = 2 * rounds * nodes.size();
+	uint64_t start;
+	uint32_t k;
+	size_t i;
+
+	errors = 0;
+	sm.setRetry( 1, 0 );
+	sm.setReplyPolls( BENCH_POLLS );
+
+	start = nowUs( sim );
+	for( k=0; k<rounds; ++k )
+	{
+		for( i=0; i<nodes.size(); ++i )
+		{
+			sm.setAddress( nodes[i] );
+			if( ((k & 1) ? sm.ledOn() : sm.ledOff()) != SM_OK )
+				++errors;
+			if( sm.gpioRead( pinb, pinc, pind ) != SM_OK )
+				++errors;
+		}
+	}
+	serial = perSec( cmds, nowUs( sim ) - start );
+
+	memset( &req, 0, sizeof(req) );
+	start = nowUs( sim );
+	for( k=0; k<rounds; ++k )
+	{
+		for( i=0; i<nodes.size(); ++i )
+		{
+			req.adrs = nodes[i];
+			req.mod = DEV_LED_1_ID;
+			req.cmd = (k & 1) ? CMD_LED_ON : CMD_LED_OFF;
+			req.replyLen = 0;
+			while( !queue.submit( req ) )
+				queue.step( done );
+
+			req.mod = DEV_GPIO_ID;
+			req.cmd = CMD_GPIO_READ;
+			req.replyLen = 3;
+			while( !queue.submit( req ) )
+				queue.step( done );
+		}
+	}
+	queue.flush( done );
+	queued = perSec( cmds, nowUs( sim ) - start );
+
+	for( i=0; i<done.size(); ++i )
+	{
+		if( done[i].status != SM_OK )
+			++errors;
+	}
+}
+
+static void fanoutReport( FILE* f, bool& first, uint8_t slaves, uint32_t clock, uint32_t msgUs,
+						  double serial, double queued, uint32_t errors )
+{
+	fprintf( stderr, "%5u %7u %12.0f %12.0f %7.2fx %7u\n", slaves, clock, serial, queued,
+			 (serial > 0) ? queued / serial : 0.0, errors );
+	fprintf( f, "%s    { \"slaves\": %u, \"clock_hz\": %u, \"msg_us\": %u, "
+			 "\"serial_cmds_per_s\": %.1f, \"queued_cmds_per_s\": %.1f, \"errors\": %u }",
+			 first ? "" : ",\n", slaves, clock, msgUs, serial, queued, errors );
+	first = false;
+}
+
+/* *** Report *** */
+static void jsonNumber( FILE* f, const char* name, double value, bool last = false )
+{
+	if( value < 0 )
+	{
+		fprintf( f, "\"%s\": null%s", name, last ? "" : ", " );
+	}
+	else
+	{
+		fprintf( f, "\"%s\": %.1f%s", name, value, last ? "" : ", " );
+	}
+}
+
+static void tableNumber( int width, double value )
+{
+	if( value < 0 )
+	{
+		fprintf( stderr, "%*s", width, "-" );
+	}
+	else
+	{
+		fprintf( stderr, "%*.0f", width, value );
+	}
+}
+
+static void usage()
+{
+	fprintf( stderr, "usage: slavebench [-d /dev/i2c-N] [-p VARIANT] [-k HZ] [-a ADRS] [-n OPS] [-o FILE] [-u US] [-f] [-m US]\n" );
+	exit( 2 );
+}
+
+int main( int argc, char** argv )
+{
+	const char* dev = 0;
+	const char* only = 0;
+	const char* out = 0;
+	uint32_t clocks[2] = { 100000, 400000 };
+	uint8_t clockCount = 2;
+	uint8_t adrs = SLAVE_ADRS;
+	uint32_t ops = BENCH_OPS;
+	uint32_t stretch = SIM_USI_STRETCH_US;
+	uint32_t msgUs = BENCH_FAN_MSG_US;
+	bool fan = false;
+	bool first = true;
+	FILE* f = stdout;
+	int opt;
+	size_t v;
+	uint8_t c;
+
+	while( (opt = getopt( argc, argv, "d:p:k:a:n:o:u:fm:" )) != -1 )
+	{
+		switch( opt )
+		{
+			case 'd': dev = optarg; break;
+			case 'p': only = optarg; break;
+			case 'k': clocks[0] = strtoul( optarg, 0, 10 ); clockCount = 1; break;
+			case 'a': adrs = (uint8_t)strtoul( optarg, 0, 16 ); break;
+			case 'n': ops = strtoul( optarg, 0, 10 ); break;
+			case 'o': out = optarg; break;
+			case 'u': stretch = strtoul( optarg, 0, 10 ); break;
+			case 'f': fan = true; break;
+			case 'm': msgUs = strtoul( optarg, 0, 10 ); break;
+			default: usage();
+		}
+	}
+	if( (ops == 0) || (clocks[0] == 0) || (dev && (only == 0)) )
+		usage();
+	if( dev && (clockCount == 2) )
+		clockCount = 1;										// the adapter has one clock.
+
+	LinuxI2cBus i2c;
+	if( dev && !i2c.open( dev ) )
+	{
+		perror( dev );
+		return 1;
+	}
+	if( out && ((f = fopen( out, "w" )) == 0) )
+	{
+		perror( out );
+		return 1;
+	}
+
+	fprintf( f, "{\n  \"bench\": \"slavebench\",\n  \"backend\": \"%s\",\n  \"ops\": %u,\n  \"results\": [\n",
+			 dev ? "i2c-dev" : "sim", ops );
+	fprintf( stderr, "%-5s %7s%12s%12s%10s%10s%10s%10s\n",
+			 "", "clock", "write cmd/s", "read B/s", "rtt min", "rtt avg", "rtt max", "sat err" );
+
+	for( v=0; v<VARIANT_COUNT; ++v )
+	{
+		if( only && strcmp( only, variants[v].name ) )
+			continue;
+
+		for( c=0; c<clockCount; ++c )
+		{
+			SimBus sim( clocks[c] );
+			SimLedSlave led( variants[v].usi, SIM_LOOP_US, stretch );
+			SimCountSlave count( variants[v].usi, SIM_LOOP_US, stretch );
+			SimEchoSlave echo;
+			SimA1C1Slave a1c1;
+			Bench bench( dev ? (SlaveBus&)i2c : (SlaveBus&)sim, dev ? 0 : &sim, adrs, ops );
+			BenchResult r;
+
+			if( !dev )
+			{
+				switch( variants[v].kind )
+				{
+					case KIND_LED:		sim.attach( adrs, &led );	bench.setModel( &led );		break;
+					case KIND_COUNT:	sim.attach( adrs, &count );	bench.setModel( &count );	break;
+					case KIND_ECHO:		sim.attach( adrs, &echo );	bench.setModel( &echo );	break;
+					case KIND_A1C1:		sim.attach( adrs, &a1c1 );	bench.setModel( &a1c1 );	break;
+				}
+			}
+			bench.run( variants[v], r );
+
+			fprintf( stderr, "%-5s %7u", variants[v].name, clocks[c] );
+			tableNumber( 12, r.writeCmds );
+			tableNumber( 12, r.readBytes );
+			tableNumber( 10, r.rttMin );
+			tableNumber( 10, r.rttAvg );
+			tableNumber( 10, r.rttMax );
+			fprintf( stderr, " %8.2f%%\n", 100.0 * r.satErrors / r.satRounds );
+
+			fprintf( f, "%s    { \"variant\": \"%s\", \"clock_hz\": %u, ", first ? "" : ",\n",
+					 variants[v].name, clocks[c] );
+			jsonNumber( f, "write_cmds_per_s", r.writeCmds );
+			jsonNumber( f, "read_bytes_per_s", r.readBytes );
+			jsonNumber( f, "rtt_us_min", r.rttMin );
+			jsonNumber( f, "rtt_us_avg", r.rttAvg );
+			jsonNumber( f, "rtt_us_max", r.rttMax );
+			fprintf( f, "\"sat_rounds\": %u, \"sat_errors\": %u, \"sat_error_rate\": %.4f }",
+					 r.satRounds, r.satErrors, (double)r.satErrors / r.satRounds );
+			first = false;
+		}
+	}
+
+	fprintf( f, "\n  ]" );
+
+	if( fan )
+	{
+		std::vector<uint8_t> nodes;
+		double serial;
+		double queued;
+		uint32_t errors;
+
+		fprintf( f, ",\n  \"fanout\": [\n" );
+		fprintf( stderr, "\nnodes   clock     serial/s     queued/s    gain  errors\n" );
+		first = true;
+
+		if( dev )
+		{
+			std::vector<SlaveInfo> found;
+			BusScanner scanner( i2c );
+
+			scanner.scan( found );
+			for( v=0; v<found.size(); ++v )
+			{
+				if( found[v].type == SCAN_A1C1 )
+					nodes.push_back( found[v].adrs );
+			}
+			if( !nodes.empty() )
+			{
+				fanout( i2c, 0, nodes, ops / 4, serial, queued, errors );
+				fanoutReport( f, first, (uint8_t)nodes.size(), clocks[0], 0, serial, queued, errors );
+			}
+		}
+		else
+		{
+			for( c=0; c<clockCount; ++c )
+			{
+				for( uint8_t n=1; n<=BENCH_FAN_MAX; n <<= 1 )
+				{
+					SimBus sim( clocks[c] );
+					std::vector<SimA1C1Slave*> models;
+
+					nodes.clear();
+					for( uint8_t i=0; i<n; ++i )
+					{
+						models.push_back( new SimA1C1Slave( i, msgUs ) );
+						nodes.push_back( SLAVE_ADRS + i );
+						sim.attach( SLAVE_ADRS + i, models.back() );
+					}
+					fanout( sim, &sim, nodes, ops / 4, serial, queued, errors );
+					fanoutReport( f, first, n, clocks[c], msgUs, serial, queued, errors );
+					for( uint8_t i=0; i<n; ++i )
+						delete models[i];
+				}
+			}
+		}
+		fprintf( f, "\n  ]" );
+	}
+	fprintf( f, "\n}\n" );
+	if( f != stdout )
+		fclose( f );
+	return 0;
+}
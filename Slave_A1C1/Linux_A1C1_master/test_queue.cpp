@@ -0,0 +1,280 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_queue.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * MasterQueue on SimBus with a missing Slave in the combined transaction. GPIO TOGGLE is not
+ * safe to repeat, so a node that got it twice has its pin back where it started.
+ *
+ * revision: 10/17/2026	0.02	ndp		a short reply does not take the next one's bytes.
+ */ 
+
+#include <string.h>
+#include <vector>
+
+#include "host_test.h"
+#include "MasterQueue.h"
+#include "SimA1C1Slave.h"
+#include "SimBus.h"
+
+#define LIVE_A		0x40
+#define LIVE_B		0x41
+#define MISSING		0x42
+#define LIVE_C		0x43
+
+/*
+ * A backend like LinuxI2cBus that can not tell which part failed.
+ */
+class BlindSimBus : public SimBus
+{
+public:
+	virtual uint8_t transfer( SlaveBusMsg* msgs, uint8_t count, uint8_t* done = 0 )
+	{
+		uint8_t status = SimBus::transfer( msgs, count, done );
+
+		if( (status != SB_OK) && done )
+		{
+			*done = SB_DONE_UNKNOWN;
+		}
+		return status;
+	}
+};
+
+/*
+ * A Slave that does nothing with its input until it is let go, so the queue runs its rounds
+ * while the replies are not READY.
+ */
+class HeldSimA1C1Slave : public SimA1C1Slave
+{
+public:
+	HeldSimA1C1Slave() : held(true) {}
+
+	virtual void advance( uint32_t us )
+	{
+		if( !held )
+		{
+			SimA1C1Slave::advance( us );
+		}
+	}
+
+	bool	held;
+};
+
+static void submit( MasterQueue& queue, uint8_t adrs, uint8_t cmd, uint8_t replyLen )
+{
+	MasterRequest req;
+
+	memset( &req, 0, sizeof(req) );
+	req.adrs = adrs;
+	req.mod = DEV_GPIO_ID;
+	req.cmd = cmd;
+	if( cmd == CMD_GPIO_TOGGLE )
+	{
+		req.len = 3;
+		req.data[0] = 0x01;				// PB0
+	}
+	req.replyLen = replyLen;
+	HT_CHECK( queue.submit( req ) );
+}
+
+static const MasterRequest* find( const std::vector<MasterRequest>& done, uint8_t adrs )
+{
+	size_t i;
+
+	for( i=0; i<done.size(); ++i )
+	{
+		if( done[i].adrs == adrs )
+		{
+			return &done[i];
+		}
+	}
+	return 0;
+}
+
+/*
+ * The reported case: a GPIO READ to a live node and one to a missing node.
+ */
+static void queue_readMissing( void )
+{
+	SimBus sim;
+	SimA1C1Slave node;
+	MasterQueue queue( sim );
+	std::vector<MasterRequest> done;
+
+	sim.attach( LIVE_A, &node );
+	submit( queue, LIVE_A, CMD_GPIO_READ, 3 );
+	submit( queue, MISSING, CMD_GPIO_READ, 3 );
+	queue.flush( done );
+
+	HT_EQ( done.size(), 2 );
+	HT_EQ( node.messages(), 1 );
+	HT_EQ( find( done, LIVE_A )->status, SM_OK );
+	HT_EQ( find( done, MISSING )->status, SB_ERR_ADRS_NACK );
+}
+
+/*
+ * Toggles to nodes before and after the missing one each go out once.
+ */
+static void queue_toggleOnce( void )
+{
+	SimBus sim;
+	SimA1C1Slave a, b, c;
+	MasterQueue queue( sim );
+	std::vector<MasterRequest> done;
+
+	sim.attach( LIVE_A, &a );
+	sim.attach( LIVE_B, &b );
+	sim.attach( LIVE_C, &c );
+	submit( queue, LIVE_A, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, LIVE_B, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, MISSING, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, LIVE_C, CMD_GPIO_TOGGLE, 0 );
+	queue.flush( done );
+
+	HT_EQ( done.size(), 4 );
+	HT_EQ( a.messages(), 1 );
+	HT_EQ( b.messages(), 1 );
+	HT_EQ( c.messages(), 1 );
+	HT_EQ( a.port( 0 ), 0x01 );
+	HT_EQ( b.port( 0 ), 0x01 );
+	HT_EQ( c.port( 0 ), 0x01 );
+	HT_EQ( find( done, LIVE_C )->status, SM_OK );
+	HT_EQ( find( done, MISSING )->status, SB_ERR_ADRS_NACK );
+}
+
+/*
+ * The missing node's toggle is retried alone. The others are not sent again.
+ */
+static void queue_retryFailedOnly( void )
+{
+	SimBus sim;
+	SimA1C1Slave a, c;
+	MasterQueue queue( sim );
+	std::vector<MasterRequest> done;
+
+	sim.attach( LIVE_A, &a );
+	sim.attach( LIVE_C, &c );
+	submit( queue, LIVE_A, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, MISSING, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, LIVE_C, CMD_GPIO_TOGGLE, 0 );
+	queue.step( done );
+
+	HT_EQ( done.size(), 2 );						// the missing one is queued again.
+	HT_EQ( sim.transactions(), 2 );					// first try, then the parts after it.
+
+	queue.flush( done );
+	HT_EQ( done.size(), 3 );
+	HT_EQ( a.messages(), 1 );
+	HT_EQ( c.messages(), 1 );
+}
+
+/*
+ * A backend that can not say which part failed. Nothing is sent twice, every part of the failed
+ * transaction ends with MQ_ERR_UNSURE.
+ */
+static void queue_unknownIndex( void )
+{
+	BlindSimBus sim;
+	SimA1C1Slave a, c;
+	MasterQueue queue( sim );
+	std::vector<MasterRequest> done;
+
+	sim.attach( LIVE_A, &a );
+	sim.attach( LIVE_C, &c );
+	submit( queue, LIVE_A, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, MISSING, CMD_GPIO_TOGGLE, 0 );
+	submit( queue, LIVE_C, CMD_GPIO_TOGGLE, 0 );
+	queue.flush( done );
+
+	HT_EQ( done.size(), 3 );
+	HT_EQ( sim.transactions(), 1 );
+	HT_EQ( a.messages(), 1 );
+	HT_EQ( a.port( 0 ), 0x01 );
+	HT_EQ( c.messages(), 0 );
+	HT_EQ( find( done, LIVE_A )->status, MQ_ERR_UNSURE );
+	HT_EQ( find( done, MISSING )->status, MQ_ERR_UNSURE );
+	HT_EQ( find( done, LIVE_C )->status, MQ_ERR_UNSURE );
+}
+
+/*
+ * ADC READ of 5 samples answers only COUNT = 0. The GPIO READ behind it is not sent until that
+ * reply is read, so its bytes can not end up in the ADC reply.
+ */
+static void queue_shortReply( void )
+{
+	SimBus sim;
+	HeldSimA1C1Slave node;
+	MasterQueue queue( sim );
+	std::vector<MasterRequest> done;
+	MasterRequest req;
+
+	sim.attach( LIVE_A, &node );
+	memset( &req, 0, sizeof(req) );
+	req.adrs = LIVE_A;
+	req.mod = DEV_GPIO_ID;
+	req.cmd = CMD_GPIO_SET;
+	req.len = 3;
+	req.data[0] = 0x5A;
+	HT_CHECK( queue.submit( req ) );
+
+	req.mod = DEV_ADC_ID;
+	req.cmd = CMD_ADC_READ;
+	req.len = 1;
+	req.data[0] = 5;
+	req.replyLen = 1 + 2*5;
+	HT_CHECK( queue.submit( req ) );
+
+	submit( queue, LIVE_A, CMD_GPIO_READ, 3 );
+	queue.step( done );
+	queue.step( done );
+	HT_EQ( sim.transactions(), 3 );					// write, read, read. GPIO READ not sent.
+	HT_EQ( node.messages(), 0 );
+
+	node.held = false;
+	sim.wait( 1000 );								// everything written so far is processed.
+	queue.flush( done );
+
+	HT_EQ( done.size(), 3 );
+	HT_EQ( done[1].mod, DEV_ADC_ID );
+	HT_EQ( done[1].status, SM_ERR_SHORT );
+	HT_EQ( done[1].replyCount, 1 );
+	HT_EQ( done[1].reply[0], 0 );
+	HT_EQ( done[2].mod, DEV_GPIO_ID );
+	HT_EQ( done[2].status, SM_OK );
+	HT_EQ( done[2].replyCount, 3 );
+	HT_EQ( done[2].reply[0], 0x5A );
+}
+
+int main( void )
+{
+	HT_RUN( queue_readMissing );
+	HT_RUN( queue_toggleOnce );
+	HT_RUN( queue_retryFailedOnly );
+	HT_RUN( queue_unknownIndex );
+	HT_RUN( queue_shortReply );
+
+	return ht_result();
+}
@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * test_queue.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * MasterQueue on SimBus with a missing Slave in the combined transaction. GPIO TOGGLE is not
+ * safe to repeat, so a node that got it twice has its pin back where it started.
+ * test_scan.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * BusScanner on SimBus with an A1C1, an A1B3 echo Slave and an A1A1 LED Slave. The A1B3 answers
+ * the probe like an idle A1C1, so only the read only scan leaves it untouched.
+ */ 
+
+#include <vector>
+
+#include "host_test.h"
+#include "BusScanner.h"
+#include "SimA1C1Slave.h"
+#include "SimBasicSlaves.h"
+#include "SimBus.h"
+
+#define ADRS_A1C1	0x40
+#define ADRS_ECHO	0x41
+#define ADRS_LED	0x42
+
+static const SlaveInfo* find( const std::vector<SlaveInfo>& found, uint8_t adrs )
+{
+	size_t i;
+
+	for( i=0; i<found.size(); ++i )
+	{
+		if( found[i].adrs == adrs )
+		{
+			return &found[i];
+		}
+	}
+	return 0;
+}
+
+/*
+ * The default scan queries both nodes that look like an A1C1. The A1B3 takes the three
+ * INIT STATUS bytes as commands and the scanner reads the echoes back.
+ */
+static void scan_query( void )
+{
+	SimBus sim;
+	SimA1C1Slave node;
+	SimEchoSlave echo;
+	SimLedSlave led( false );
+	BusScanner scanner( sim );
+	std::vector<SlaveInfo> found;
+
+	sim.attach( ADRS_A1C1, &node );
+	sim.attach( ADRS_ECHO, &echo );
+	sim.attach( ADRS_LED, &led );
+	HT_EQ( scanner.scan( found ), 3 );
+
+	HT_EQ( find( found, ADRS_A1C1 )->type, SCAN_A1C1 );
+	HT_EQ( find( found, ADRS_ECHO )->type, SCAN_OTHER );
+	HT_EQ( find( found, ADRS_LED )->type, SCAN_OTHER );
+	HT_EQ( echo.commands(), 3 );
+	HT_EQ( led.commands(), 0 );
+}
+
+/*
+ * setQuery( false ) writes to no one. Both lookalikes are SCAN_IDLE.
+ */
+static void scan_readOnly( void )
+{
+	SimBus sim;
+	SimA1C1Slave node;
+	SimEchoSlave echo;
+	SimLedSlave led( false );
+	BusScanner scanner( sim );
+	std::vector<SlaveInfo> found;
+
+	sim.attach( ADRS_A1C1, &node );
+	sim.attach( ADRS_ECHO, &echo );
+	sim.attach( ADRS_LED, &led );
+	scanner.setQuery( false );
+	HT_EQ( scanner.scan( found ), 3 );
+
+	HT_EQ( find( found, ADRS_A1C1 )->type, SCAN_IDLE );
+	HT_EQ( find( found, ADRS_ECHO )->type, SCAN_IDLE );
+	HT_EQ( find( found, ADRS_LED )->type, SCAN_OTHER );
+	HT_EQ( node.messages(), 0 );
+	HT_EQ( echo.commands(), 0 );
+}
+
+int main( void )
+{
+	HT_RUN( scan_query );
+	HT_RUN( scan_readOnly );
+
+	return ht_result();
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# gen_ids.py
+#
+# Created: 10/17/2026		0.01	ndp
+#  Author: Chip
+#
+# Builds src/SlaveIds.h from the module headers of Slave_A1C1_CodeDev so the Master uses
+# the same module and command IDs as the Slave. Run it after a header changes.
+#
+#   python3 extras/gen_ids.py
+
+import os
+import re
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SLAVE = os.path.join(HERE, '..', '..', 'Slave_A1C1_CodeDev')
+OUT = os.path.join(HERE, '..', 'src', 'SlaveIds.h')
+
+HEADERS = [
+	'initialize.h', 'dev_led_1.h', 'dev_led_pwm.h', 'dev_led_bam.h', 'dev_seq.h', 'dev_gpio.h',
+	'dev_adc.h', 'dev_sonar.h', 'dev_matrix.h', 'config.h', 'i2c_address.h', 'boot_info.h', 'twiSlave_cfg.h',
+]
+
+# Only the names the Master needs. Pins, ports and sizes stay in the Slave.
+KEEP = re.compile(r'^(\w+_ID|CMD_\w+|SLAVE_ADRS|INIT_BUSY_BYTE|CFG_KEY_\w+|SEQ_OP_\w+|SEQ_STATE_\w+'
+				  r'|ADC_MODE_\w+|DEV_SONAR_(COUNT|NO_ECHO)|DEV_ADC_READ_MAX|IA_UID_SIZE'
+				  r'|BOOT_(REQUEST|DATA_MAX|START|STATE_\w+|ERR_\w+)|TWI_REPLY_STATUS)$')
+DEFINE = re.compile(r'^#define\s+(\w+)\s+(0x[0-9A-Fa-f]+|0b[01]+|\d+)\b(.*)$')
+
+HEAD = '''/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SlaveIds.h
+ *
+ * Module IDs, commands and reply values of the Slave_A1C1 firmware.
+ *
+ * Generated by extras/gen_ids.py from the Slave_A1C1_CodeDev headers. Do not edit.
+ */
+
+
+#ifndef SLAVEIDS_H_
+#define SLAVEIDS_H_
+'''
+
+def main():
+	out = [HEAD]
+	for name in HEADERS:
+		lines = []
+		for line in open(os.path.join(SLAVE, name)):
+			m = DEFINE.match(line.rstrip())
+			if m and KEEP.match(m.group(1)):
+				lines.append('#define %s\t\t%s%s' % (m.group(1), m.group(2), m.group(3)))
+		if lines:
+			out.append('\n// %s\n' % name)
+			out.append('\n'.join(lines) + '\n')
+	out.append('\n#endif /* SLAVEIDS_H_ */\n')
+	open(OUT, 'w').write(''.join(out))
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,111 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SlaveBus.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		add transfer() for combined transactions.
+ * revision: 10/17/2026	0.03	ndp		transfer() reports how many parts were done.
+ *
+ * Bus backend used by SlaveMaster. WireBus is the Arduino one. Other backends (Linux i2c-dev,
+ * a simulator) only have to supply these three functions.
+ */ 
+
+
+#ifndef SLAVEBUS_H_
+#define SLAVEBUS_H_
+
+#include <stdint.h>
+
+// write() return codes. Same as Arduino Wire.endTransmission().
+#define SB_OK				0
+#define SB_ERR_LENGTH		1			// too long for the backend buffer.
+#define SB_ERR_ADRS_NACK	2
+#define SB_ERR_DATA_NACK	3
+#define SB_ERR_OTHER		4
+
+#define SB_READ				0x01		// SlaveBusMsg flags
+
+#define SB_DONE_UNKNOWN		0xFF		// transfer() DONE when the backend can not tell.
+
+/*
+ * One part of a combined transaction. Parts are joined with repeated STARTs.
+ */
+struct SlaveBusMsg
+{
+	uint8_t		adrs;
+	uint8_t		flags;
+	uint8_t		len;			// bytes to write, or to read. A read sets it to the bytes read.
+	uint8_t*	buf;
+};
+
+class SlaveBus
+{
+public:
+	virtual ~SlaveBus() {}
+
+	// Send LEN bytes to the Slave at ADRS in one transaction. Returns SB_OK or an SB_ERR code.
+	virtual uint8_t write( uint8_t adrs, const uint8_t* data, uint8_t len ) = 0;
+
+	// Read up to LEN bytes from the Slave at ADRS. Returns the number of bytes read.
+	virtual uint8_t read( uint8_t adrs, uint8_t* data, uint8_t len ) = 0;
+
+	virtual void delayMs( uint16_t ms ) = 0;
+
+	/*
+	 * Run COUNT messages as one combined transaction. Stops at the first error and returns it.
+	 * DONE, if not 0, gets the number of parts done before the one that failed, so msgs[*DONE]
+	 * is the failed part. A backend that can not tell sets SB_DONE_UNKNOWN.
+	 * This default runs them as separate transactions. Backends that can do repeated STARTs
+	 * (Linux I2C_RDWR) override it.
+	 */
+	virtual uint8_t transfer( SlaveBusMsg* msgs, uint8_t count, uint8_t* done = 0 )
+	{
+		uint8_t status;
+		uint8_t i;
+
+		for( i=0; i<count; ++i )
+		{
+			if( msgs[i].flags & SB_READ )
+			{
+				msgs[i].len = read( msgs[i].adrs, msgs[i].buf, msgs[i].len );
+			}
+			else
+			{
+				status = write( msgs[i].adrs, msgs[i].buf, msgs[i].len );
+				if( status != SB_OK )
+				{
+					break;
+				}
+			}
+		}
+		if( done )
+		{
+			*done = i;
+		}
+		return (i < count) ? status : SB_OK;
+	}
+};
+
+#endif /* SLAVEBUS_H_ */
@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SlaveIds.h
+ *
+ * Module IDs, commands and reply values of the Slave_A1C1 firmware.
+ *
+ * Generated by extras/gen_ids.py from the Slave_A1C1_CodeDev headers. Do not edit.
+ */
+
+
+#ifndef SLAVEIDS_H_
+#define SLAVEIDS_H_
+
+// initialize.h
+#define INIT_ID		0x10
+#define INIT_BUSY_BYTE		0xBB		// read from the Slave while the devices are still starting.
+#define CMD_INIT_STATUS		1			// Returns READY(0:1) DEVICES TWI_L TWI_H DONE_L DONE_H
+#define CMD_INIT_PROFILE		2			// START. Returns COUNT then ID T_L T_H for each device.
+#define CMD_INIT_BOOT		3			// BOOT_REQUEST. RESET into the I2C bootloader.
+
+// dev_led_1.h
+#define DEV_LED_1_ID		0x20
+#define CMD_LED_OFF		1
+#define CMD_LED_ON		2
+#define CMD_LED_BLINK		3			// ON_L ON_H OFF_L OFF_H		(10ms tics)
+#define CMD_LED_PULSE		4			// COUNT ON_L ON_H OFF_L OFF_H
+#define CMD_LED_ONESHOT		5			// TIME_L TIME_H
+
+// dev_led_pwm.h
+#define DEV_LED_PWM_ID		0x30
+#define CMD_LED_PWM_OFF		1
+#define CMD_LED_PWM_ON		2
+#define CMD_LED_PWM_RATE		3
+
+// dev_led_bam.h
+#define DEV_LED_BAM_ID		0x40
+#define CMD_LED_BAM_OFF		1
+#define CMD_LED_BAM_ON		2
+#define CMD_LED_BAM_SET		3		// CHAN LEVEL
+#define CMD_LED_BAM_SET_ALL		4		// CHAN LEVEL0 LEVEL1 ... up to 14 levels
+
+// dev_seq.h
+#define DEV_SEQ_ID		0x50
+#define SEQ_OP_END		0x00
+#define SEQ_OP_SET		0x01
+#define SEQ_OP_FADE		0x02
+#define SEQ_OP_WAIT		0x03
+#define SEQ_OP_LOOP		0x04
+#define SEQ_OP_NEXT		0x05
+#define SEQ_OP_JUMP		0x06
+#define CMD_SEQ_STOP		1
+#define CMD_SEQ_RUN		2			// ADRS
+#define CMD_SEQ_LOAD		3			// ADRS D0 D1 ... up to 14 bytes
+#define CMD_SEQ_SAVE		4			// AUTORUN(0:1)
+#define CMD_SEQ_RESTORE		5
+#define CMD_SEQ_STATUS		6			// returns STATE PC. STATE has SEQ_STATE_SAVING set during a SAVE.
+#define SEQ_STATE_STOP		0
+#define SEQ_STATE_RUN		1
+#define SEQ_STATE_WAIT		2
+#define SEQ_STATE_FADE		3
+#define SEQ_STATE_ERROR		4
+#define SEQ_STATE_SAVING		0x80		// flag. A SAVE is still being written to EEPROM.
+
+// dev_gpio.h
+#define DEV_GPIO_ID		0x60
+#define CMD_GPIO_SET		1			// MB MC MD			PORTx |= Mx
+#define CMD_GPIO_CLEAR		2			// MB MC MD			PORTx &= ~Mx
+#define CMD_GPIO_TOGGLE		3			// MB MC MD			PINx = Mx
+#define CMD_GPIO_OUTPUT		4			// MB MC MD			DDRx |= Mx
+#define CMD_GPIO_INPUT		5			// MB MC MD			DDRx &= ~Mx
+#define CMD_GPIO_WRITE		6			// MB VB MC VC MD VD	PORTx = (PORTx & ~Mx) | (Vx & Mx)
+#define CMD_GPIO_READ		7			// returns PINB PINC PIND
+
+// dev_adc.h
+#define DEV_ADC_ID		0x70
+#define DEV_ADC_READ_MAX		15			// samples per READ. (1 + 2*15) bytes fits the TX FIFO.
+#define ADC_MODE_FREE		0			// free running.
+#define ADC_MODE_TIMER		1			// one sample each 1ms system tic (Timer0 Compare A).
+#define CMD_ADC_STOP		1
+#define CMD_ADC_START		2			// MODE
+#define CMD_ADC_CONFIG		3			// CHAN_MASK OSR(0:3 extra bits, 4^OSR samples each)
+#define CMD_ADC_READ		4			// MAX. Returns COUNT S0_L S0_H ...
+#define CMD_ADC_STATUS		5			// Returns AVAILABLE OVERRUNS
+
+// dev_sonar.h
+#define DEV_SONAR_ID		0x80
+#define DEV_SONAR_COUNT		2
+#define DEV_SONAR_NO_ECHO		255			// cm value for no echo or out of range.
+#define CMD_SONAR_STOP		1
+#define CMD_SONAR_START		2
+#define CMD_SONAR_READ		3			// Returns filtered cm for each sensor.
+#define CMD_SONAR_READ_RAW		4			// Returns last raw cm for each sensor.
+
+// dev_matrix.h
+#define DEV_MATRIX_ID		0x90
+#define CMD_MATRIX_OFF		1
+#define CMD_MATRIX_ON		2
+#define CMD_MATRIX_ICON		3			// INDEX
+#define CMD_MATRIX_FRAME		4			// R0 R1 R2 R3 R4 R5 R6 R7
+#define CMD_MATRIX_ROWS		5			// BITMAP Rn ...	only rows set in BITMAP
+#define CMD_MATRIX_XOR		6			// BITMAP Xn ...	row ^= Xn for rows set in BITMAP
+
+// config.h
+#define CONFIG_ID		0xA0
+#define CFG_KEY_COUNT		16			// keys 0:15
+#define CFG_KEY_GLOW_RATE		0			// dev_led_pwm glow rate
+#define CFG_KEY_I2C_ADRS		1			// assigned I2C address. 0 = not assigned.
+#define CMD_CFG_GET		1			// KEY. Returns VAL_L VAL_H VALID
+#define CMD_CFG_SET		2			// KEY VAL_L VAL_H
+#define CMD_CFG_STATUS		3			// Returns PENDING HEAD
+
+// i2c_address.h
+#define SLAVE_ADRS		0x40		// Default address. Also the shared address used for assignment.
+#define I2C_ADRS_ID		0xB0
+#define IA_UID_SIZE		4
+#define CMD_IA_RESET		1
+#define CMD_IA_PREFIX		2			// N P0 P1 P2 P3
+#define CMD_IA_ASSIGN		3			// U0 U1 U2 U3 ADRS
+#define CMD_IA_UID		4			// Returns U0 U1 U2 U3
+
+// boot_info.h
+#define BOOT_START		0x1800				// byte address of the boot section.
+#define BOOT_REQUEST		0xB7
+#define BOOT_ID		0xF0
+#define BOOT_DATA_MAX		8					// DATA bytes per message. SPM_PAGESIZE must be a multiple of this.
+#define CMD_BOOT_IDENT		1			// Returns VERSION PAGE_SIZE START_L START_H
+#define CMD_BOOT_ADDR		2			// ADRS_L ADRS_H. Page aligned byte address of the next DATA.
+#define CMD_BOOT_DATA		3			// D0..D7. Must not cross a page. A full page is queued to be written.
+#define CMD_BOOT_FLUSH		4			// Write a partial page. Unused bytes are 0xFF.
+#define CMD_BOOT_STATUS		5			// Returns STATE ERROR ADRS_L ADRS_H
+#define CMD_BOOT_CRC		6			// LEN_L LEN_H. Returns CRC_L CRC_H of flash 0:LEN-1
+#define CMD_BOOT_RUN		7			// LEN_L LEN_H CRC_L CRC_H. Save the check values and start the application.
+#define BOOT_STATE_READY		0x01		// DATA can be sent.
+#define BOOT_STATE_BUSY		0x02		// a page is being written.
+#define BOOT_STATE_PENDING		0x04		// a full page is waiting for the write to finish.
+#define BOOT_ERR_FRAME		0x01		// bad LEN or unknown command.
+#define BOOT_ERR_ADRS		0x02		// address not page aligned or in the boot section.
+#define BOOT_ERR_ALIGN		0x04		// DATA crosses a page.
+#define BOOT_ERR_CRC		0x08		// RUN check failed.
+
+// twiSlave_cfg.h
+#define TWI_REPLY_STATUS		1
+
+#endif /* SLAVEIDS_H_ */
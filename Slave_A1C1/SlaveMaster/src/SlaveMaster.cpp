@@ -0,0 +1,734 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SlaveMaster.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		add I2C address assignment.
+ */ 
+
+#include <string.h>
+
+#include "SlaveMaster.h"
+
+#define SM_TRIES			3			// default write and busy read attempts.
+#define SM_RETRY_DELAY		2			// ms before the first retry. Doubles each retry.
+#if TWI_REPLY_STATUS == 1
+#define SM_REPLY_DELAY		0			// READY status says when to read.
+#else
+#define SM_REPLY_DELAY		1			// ms for the Slave to queue a reply.
+#endif
+#define SM_REPLY_POLLS		20			// reads at bus speed while READY is 0.
+
+/*
+ * true if the Slave answered with its start up busy byte instead of a reply.
+ */
+bool SlaveReply::busy() const
+{
+	return (_count != 0) && (_buf[0] == INIT_BUSY_BYTE) && (_buf[_count - 1] == INIT_BUSY_BYTE);
+}
+
+SlaveMaster::SlaveMaster( SlaveBus& bus, uint8_t adrs )
+	: _bus(bus), _adrs(adrs), _tries(SM_TRIES), _retryDelay(SM_RETRY_DELAY),
+	  _replyDelay(SM_REPLY_DELAY), _polls(SM_REPLY_POLLS), _batching(false), _batchLen(0)
+{
+}
+
+/*
+ * Write with retry and backoff.
+ */
+uint8_t SlaveMaster::transmit( const uint8_t* data, uint8_t len )
+{
+	uint8_t status = SB_OK;
+	uint16_t wait = _retryDelay;
+	uint8_t i;
+
+	for( i=0; i<_tries; ++i )
+	{
+		status = _bus.write( _adrs, data, len );
+		if( (status == SB_OK) || (status == SB_ERR_LENGTH) )
+		{
+			break;
+		}
+		_bus.delayMs( wait );
+		wait <<= 1;
+	}
+	return status;
+}
+
+#if TWI_REPLY_STATUS == 1
+/*
+ * Read a reply. The first byte is READY, the number of reply bytes that follow.
+ * Read again at once while it is 0, then with backoff between rounds of polls.
+ */
+uint8_t SlaveMaster::receive( SlaveReply& reply, uint8_t len )
+{
+	uint8_t buf[SM_REPLY_MAX + 1];
+	uint16_t wait = _retryDelay;
+	uint8_t count;
+	uint8_t i;
+	uint8_t j;
+
+	if( len > SM_REPLY_MAX )
+	{
+		len = SM_REPLY_MAX;
+	}
+
+	for( i=0; i<_tries; ++i )
+	{
+		for( j=0; j<_polls; ++j )
+		{
+			count = _bus.read( _adrs, buf, len + 1 );
+			if( (count != 0) && (buf[0] != 0) )
+			{
+				--count;
+				if( count > buf[0] )
+				{
+					count = buf[0];
+				}
+				memcpy( reply._buf, &buf[1], count );
+				reply._count = count;
+				return (count < len) ? SM_ERR_SHORT : SM_OK;
+			}
+		}
+		_bus.delayMs( wait );
+		wait <<= 1;
+	}
+	return SM_ERR_BUSY;
+}
+#else
+/*
+ * Read a reply. Read again with backoff while the Slave is still starting.
+ */
+uint8_t SlaveMaster::receive( SlaveReply& reply, uint8_t len )
+{
+	uint16_t wait = _retryDelay;
+	uint8_t i;
+
+	if( len > SM_REPLY_MAX )
+	{
+		len = SM_REPLY_MAX;
+	}
+
+	for( i=0; i<_tries; ++i )
+	{
+		reply._count = _bus.read( _adrs, reply._buf, len );
+		if( !reply.busy() )
+		{
+			return (reply._count < len) ? SM_ERR_SHORT : SM_OK;
+		}
+		_bus.delayMs( wait );
+		wait <<= 1;
+	}
+	return SM_ERR_BUSY;
+}
+#endif
+
+void SlaveMaster::beginBatch()
+{
+	_batching = true;
+	_batchLen = 0;
+}
+
+/*
+ * Send the commands queued since beginBatch() in one transaction.
+ */
+uint8_t SlaveMaster::endBatch()
+{
+	uint8_t status = SM_OK;
+
+	if( _batchLen != 0 )
+	{
+		status = transmit( _batch, _batchLen );
+	}
+	_batching = false;
+	_batchLen = 0;
+	return status;
+}
+
+/*
+ * Send one command, or add it to the batch.
+ */
+uint8_t SlaveMaster::command( uint8_t mod, uint8_t cmd, const uint8_t* data, uint8_t len )
+{
+	uint8_t msg[3 + SM_DATA_MAX];
+	uint8_t status;
+
+	if( len > SM_DATA_MAX )
+	{
+		return SM_ERR_DATA;
+	}
+
+	if( _batching )
+	{
+		if( _batchLen + 3 + len > SM_BATCH_MAX )
+		{
+			status = endBatch();
+			_batching = true;
+			if( status != SM_OK )
+			{
+				return status;
+			}
+		}
+		_batch[_batchLen++] = makeHeader( len );
+		_batch[_batchLen++] = mod;
+		_batch[_batchLen++] = cmd;
+		if( len != 0 )
+		{
+			memcpy( &_batch[_batchLen], data, len );
+			_batchLen += len;
+		}
+		return SM_OK;
+	}
+
+	msg[0] = makeHeader( len );
+	msg[1] = mod;
+	msg[2] = cmd;
+	if( len != 0 )
+	{
+		memcpy( &msg[3], data, len );
+	}
+	return transmit( msg, 3 + len );
+}
+
+/*
+ * Send a command and read REPLY_LEN bytes back.
+ * A batch in progress is sent first so the reply is for this command.
+ */
+uint8_t SlaveMaster::query( uint8_t mod, uint8_t cmd, const uint8_t* data, uint8_t len,
+							SlaveReply& reply, uint8_t replyLen )
+{
+	bool batching = _batching;
+	uint8_t status;
+
+	reply._count = 0;
+	if( batching )
+	{
+		status = endBatch();
+		if( status != SM_OK )
+		{
+			return status;
+		}
+	}
+
+	status = command( mod, cmd, data, len );
+	_batching = batching;
+	if( status != SM_OK )
+	{
+		return status;
+	}
+
+	if( _replyDelay != 0 )
+	{
+		_bus.delayMs( _replyDelay );
+	}
+	return receive( reply, replyLen );
+}
+
+uint8_t SlaveMaster::send3( uint8_t mod, uint8_t cmd, uint8_t mb, uint8_t mc, uint8_t md )
+{
+	uint8_t data[3] = { mb, mc, md };
+	return command( mod, cmd, data, 3 );
+}
+
+/* *** System *** */
+
+uint8_t SlaveMaster::initStatus( SlaveReply& reply )
+{
+	return query( INIT_ID, CMD_INIT_STATUS, 0, 0, reply, 6 );
+}
+
+uint8_t SlaveMaster::enterBootloader()
+{
+	uint8_t data[1] = { BOOT_REQUEST };
+	return command( INIT_ID, CMD_INIT_BOOT, data, 1 );
+}
+
+/* *** LED-1 *** */
+
+uint8_t SlaveMaster::ledOff()
+{
+	return command( DEV_LED_1_ID, CMD_LED_OFF );
+}
+
+uint8_t SlaveMaster::ledOn()
+{
+	return command( DEV_LED_1_ID, CMD_LED_ON );
+}
+
+uint8_t SlaveMaster::ledBlink( uint16_t on, uint16_t off )
+{
+	uint8_t data[4] = { (uint8_t)on, (uint8_t)(on >> 8), (uint8_t)off, (uint8_t)(off >> 8) };
+	return command( DEV_LED_1_ID, CMD_LED_BLINK, data, 4 );
+}
+
+uint8_t SlaveMaster::ledPulse( uint8_t count, uint16_t on, uint16_t off )
+{
+	uint8_t data[5] = { count, (uint8_t)on, (uint8_t)(on >> 8), (uint8_t)off, (uint8_t)(off >> 8) };
+	return command( DEV_LED_1_ID, CMD_LED_PULSE, data, 5 );
+}
+
+uint8_t SlaveMaster::ledOneShot( uint16_t time )
+{
+	uint8_t data[2] = { (uint8_t)time, (uint8_t)(time >> 8) };
+	return command( DEV_LED_1_ID, CMD_LED_ONESHOT, data, 2 );
+}
+
+/* *** LED-2 PWM glow *** */
+
+uint8_t SlaveMaster::pwmOff()
+{
+	return command( DEV_LED_PWM_ID, CMD_LED_PWM_OFF );
+}
+
+uint8_t SlaveMaster::pwmOn()
+{
+	return command( DEV_LED_PWM_ID, CMD_LED_PWM_ON );
+}
+
+uint8_t SlaveMaster::pwmRate( uint8_t rate )
+{
+	return command( DEV_LED_PWM_ID, CMD_LED_PWM_RATE, &rate, 1 );
+}
+
+/* *** BAM LEDs *** */
+
+uint8_t SlaveMaster::bamOff()
+{
+	return command( DEV_LED_BAM_ID, CMD_LED_BAM_OFF );
+}
+
+uint8_t SlaveMaster::bamOn()
+{
+	return command( DEV_LED_BAM_ID, CMD_LED_BAM_ON );
+}
+
+uint8_t SlaveMaster::bamSet( uint8_t chan, uint8_t level )
+{
+	uint8_t data[2] = { chan, level };
+	return command( DEV_LED_BAM_ID, CMD_LED_BAM_SET, data, 2 );
+}
+
+uint8_t SlaveMaster::bamSetAll( uint8_t chan, const uint8_t* levels, uint8_t count )
+{
+	uint8_t data[SM_DATA_MAX];
+
+	if( count > SM_DATA_MAX - 1 )
+	{
+		return SM_ERR_DATA;
+	}
+	data[0] = chan;
+	memcpy( &data[1], levels, count );
+	return command( DEV_LED_BAM_ID, CMD_LED_BAM_SET_ALL, data, count + 1 );
+}
+
+/* *** Sequencer *** */
+
+uint8_t SlaveMaster::seqStop()
+{
+	return command( DEV_SEQ_ID, CMD_SEQ_STOP );
+}
+
+uint8_t SlaveMaster::seqRun( uint8_t adrs )
+{
+	return command( DEV_SEQ_ID, CMD_SEQ_RUN, &adrs, 1 );
+}
+
+/*
+ * Load a program of any length. It is sent in as many LOAD commands as needed.
+ */
+uint8_t SlaveMaster::seqLoad( uint8_t adrs, const uint8_t* prog, uint8_t count )
+{
+	uint8_t data[SM_DATA_MAX];
+	uint8_t n;
+	uint8_t status = SM_OK;
+
+	while( (count != 0) && (status == SM_OK) )
+	{
+		n = (count > SM_DATA_MAX - 1) ? SM_DATA_MAX - 1 : count;
+		data[0] = adrs;
+		memcpy( &data[1], prog, n );
+		status = command( DEV_SEQ_ID, CMD_SEQ_LOAD, data, n + 1 );
+		adrs += n;
+		prog += n;
+		count -= n;
+	}
+	return status;
+}
+
+uint8_t SlaveMaster::seqSave( bool autorun )
+{
+	uint8_t data[1] = { autorun ? (uint8_t)1 : (uint8_t)0 };
+	return command( DEV_SEQ_ID, CMD_SEQ_SAVE, data, 1 );
+}
+
+uint8_t SlaveMaster::seqRestore()
+{
+	return command( DEV_SEQ_ID, CMD_SEQ_RESTORE );
+}
+
+uint8_t SlaveMaster::seqStatus( uint8_t& state, uint8_t& pc )
+{
+	SlaveReply reply;
+	uint8_t status = query( DEV_SEQ_ID, CMD_SEQ_STATUS, 0, 0, reply, 2 );
+
+	state = reply.u8(0);
+	pc = reply.u8(1);
+	return status;
+}
+
+/* *** GPIO *** */
+
+uint8_t SlaveMaster::gpioSet( uint8_t mb, uint8_t mc, uint8_t md )
+{
+	return send3( DEV_GPIO_ID, CMD_GPIO_SET, mb, mc, md );
+}
+
+uint8_t SlaveMaster::gpioClear( uint8_t mb, uint8_t mc, uint8_t md )
+{
+	return send3( DEV_GPIO_ID, CMD_GPIO_CLEAR, mb, mc, md );
+}
+
+uint8_t SlaveMaster::gpioToggle( uint8_t mb, uint8_t mc, uint8_t md )
+{
+	return send3( DEV_GPIO_ID, CMD_GPIO_TOGGLE, mb, mc, md );
+}
+
+uint8_t SlaveMaster::gpioOutput( uint8_t mb, uint8_t mc, uint8_t md )
+{
+	return send3( DEV_GPIO_ID, CMD_GPIO_OUTPUT, mb, mc, md );
+}
+
+uint8_t SlaveMaster::gpioInput( uint8_t mb, uint8_t mc, uint8_t md )
+{
+	return send3( DEV_GPIO_ID, CMD_GPIO_INPUT, mb, mc, md );
+}
+
+uint8_t SlaveMaster::gpioRead( uint8_t& pinb, uint8_t& pinc, uint8_t& pind )
+{
+	SlaveReply reply;
+	uint8_t status = query( DEV_GPIO_ID, CMD_GPIO_READ, 0, 0, reply, 3 );
+
+	pinb = reply.u8(0);
+	pinc = reply.u8(1);
+	pind = reply.u8(2);
+	return status;
+}
+
+/* *** ADC *** */
+
+uint8_t SlaveMaster::adcStop()
+{
+	return command( DEV_ADC_ID, CMD_ADC_STOP );
+}
+
+uint8_t SlaveMaster::adcStart( uint8_t mode )
+{
+	return command( DEV_ADC_ID, CMD_ADC_START, &mode, 1 );
+}
+
+uint8_t SlaveMaster::adcConfig( uint8_t chanMask, uint8_t osr )
+{
+	uint8_t data[2] = { chanMask, osr };
+	return command( DEV_ADC_ID, CMD_ADC_CONFIG, data, 2 );
+}
+
+/*
+ * Read up to MAX samples. The Slave sends COUNT then its 2 byte samples. Only COUNT are valid.
+ */
+uint8_t SlaveMaster::adcRead( uint16_t* samples, uint8_t max, uint8_t& count )
+{
+	SlaveReply reply;
+	uint8_t status;
+	uint8_t i;
+
+	if( max > DEV_ADC_READ_MAX )
+	{
+		max = DEV_ADC_READ_MAX;
+	}
+
+	count = 0;
+	status = query( DEV_ADC_ID, CMD_ADC_READ, &max, 1, reply, 1 + 2 * max );
+	if( (status != SM_OK) && (status != SM_ERR_SHORT) )
+	{
+		return status;
+	}
+
+	count = reply.u8(0);
+	if( count > max )
+	{
+		count = max;
+	}
+	if( reply.count() < 1 + 2 * count )
+	{
+		count = (reply.count() - 1) / 2;
+		status = SM_ERR_SHORT;
+	}
+	else
+	{
+		status = SM_OK;
+	}
+
+	for( i=0; i<count; ++i )
+	{
+		samples[i] = reply.u16( 1 + 2 * i );
+	}
+	return status;
+}
+
+/* *** Sonar *** */
+
+uint8_t SlaveMaster::sonarStop()
+{
+	return command( DEV_SONAR_ID, CMD_SONAR_STOP );
+}
+
+uint8_t SlaveMaster::sonarStart()
+{
+	return command( DEV_SONAR_ID, CMD_SONAR_START );
+}
+
+uint8_t SlaveMaster::sonarRead( uint8_t* cm )
+{
+	SlaveReply reply;
+	uint8_t status = query( DEV_SONAR_ID, CMD_SONAR_READ, 0, 0, reply, DEV_SONAR_COUNT );
+
+	memcpy( cm, reply.data(), reply.count() );
+	return status;
+}
+
+/* *** LED matrix *** */
+
+uint8_t SlaveMaster::matrixOff()
+{
+	return command( DEV_MATRIX_ID, CMD_MATRIX_OFF );
+}
+
+uint8_t SlaveMaster::matrixOn()
+{
+	return command( DEV_MATRIX_ID, CMD_MATRIX_ON );
+}
+
+uint8_t SlaveMaster::matrixIcon( uint8_t index )
+{
+	return command( DEV_MATRIX_ID, CMD_MATRIX_ICON, &index, 1 );
+}
+
+uint8_t SlaveMaster::matrixFrame( const uint8_t* rows )
+{
+	return command( DEV_MATRIX_ID, CMD_MATRIX_FRAME, rows, 8 );
+}
+
+/* *** Configuration store *** */
+
+uint8_t SlaveMaster::cfgGet( uint8_t key, uint16_t& value )
+{
+	SlaveReply reply;
+	uint8_t status = query( CONFIG_ID, CMD_CFG_GET, &key, 1, reply, 3 );
+
+	value = reply.u16(0);
+	if( (status == SM_OK) && (reply.u8(2) == 0) )
+	{
+		status = SM_ERR_NOT_SET;
+	}
+	return status;
+}
+
+uint8_t SlaveMaster::cfgSet( uint8_t key, uint16_t value )
+{
+	uint8_t data[3] = { key, (uint8_t)value, (uint8_t)(value >> 8) };
+	return command( CONFIG_ID, CMD_CFG_SET, data, 3 );
+}
+
+/* *** I2C address assignment *** */
+
+uint8_t SlaveMaster::iaReset()
+{
+	uint8_t adrs = _adrs;
+	uint8_t status;
+
+	_adrs = 0;
+	status = command( I2C_ADRS_ID, CMD_IA_RESET );
+	_adrs = adrs;
+	return status;
+}
+
+uint8_t SlaveMaster::iaUid( uint8_t* uid )
+{
+	SlaveReply reply;
+	uint8_t status = query( I2C_ADRS_ID, CMD_IA_UID, 0, 0, reply, IA_UID_SIZE );
+
+	memcpy( uid, reply.data(), reply.count() );
+	return status;
+}
+
+/*
+ * Send PREFIX to all nodes and read the search reply U0 ~U0 .. U3 ~U3 from SLAVE_ADRS.
+ * READY is read on its own until it shows the whole reply. It is the wired-AND of every node's
+ * READY, so it is only right when all of them have loaded theirs, and a longer read before
+ * that would take the reply from the nodes that are done.
+ */
+uint8_t SlaveMaster::iaPrefix( uint8_t n, const uint8_t* prefix, uint8_t* reply )
+{
+	uint8_t buf[1 + 2*IA_UID_SIZE];
+	uint8_t data[1 + IA_UID_SIZE];
+	uint8_t adrs = _adrs;
+	uint16_t wait = _retryDelay;
+	uint8_t status;
+	uint8_t i;
+	uint8_t j;
+
+	data[0] = n;
+	memcpy( &data[1], prefix, IA_UID_SIZE );
+	_adrs = 0;
+	status = command( I2C_ADRS_ID, CMD_IA_PREFIX, data, sizeof(data) );
+	_adrs = adrs;
+	if( status != SM_OK )
+	{
+		return status;
+	}
+
+	for( i=0; i<_tries; ++i )
+	{
+		for( j=0; j<_polls; ++j )
+		{
+			if( _bus.read( SLAVE_ADRS, buf, 1 ) == 0 )
+			{
+				return SB_ERR_ADRS_NACK;			// no node left at SLAVE_ADRS.
+			}
+			if( buf[0] == 2*IA_UID_SIZE )
+			{
+				if( _bus.read( SLAVE_ADRS, buf, sizeof(buf) ) != sizeof(buf) )
+				{
+					return SM_ERR_SHORT;
+				}
+				memcpy( reply, &buf[1], 2*IA_UID_SIZE );
+				return SM_OK;
+			}
+		}
+		_bus.delayMs( wait );
+		wait <<= 1;
+	}
+	return SM_ERR_BUSY;
+}
+
+/*
+ * Move the node with UID to ADRS, then read its UID there to be sure it moved.
+ */
+uint8_t SlaveMaster::iaAssign( const uint8_t* uid, uint8_t adrs )
+{
+	uint8_t data[IA_UID_SIZE + 1];
+	uint8_t check[IA_UID_SIZE];
+	uint8_t save = _adrs;
+	uint8_t status;
+
+	memcpy( data, uid, IA_UID_SIZE );
+	data[IA_UID_SIZE] = adrs;
+	_adrs = 0;
+	status = command( I2C_ADRS_ID, CMD_IA_ASSIGN, data, sizeof(data) );
+	if( status == SM_OK )
+	{
+		_adrs = adrs;
+		status = iaUid( check );
+		if( (status == SM_OK) && (memcmp( check, uid, IA_UID_SIZE ) != 0) )
+		{
+			status = SM_ERR_SEARCH;
+		}
+	}
+	_adrs = save;
+	return status;
+}
+
+/*
+ * Give each node at SLAVE_ADRS the next free address from FIRST up, at most MAX of them.
+ * COUNT is the number moved. Returns SM_OK when no node is left at SLAVE_ADRS or MAX is done.
+ */
+uint8_t SlaveMaster::iaAssignAll( uint8_t first, uint8_t max, uint8_t& count )
+{
+	uint8_t prefix[IA_UID_SIZE];
+	uint8_t reply[2*IA_UID_SIZE];
+	uint8_t adrs = first;
+	uint8_t status;
+	uint8_t n;
+	uint8_t bit;
+	uint8_t mask;
+	bool allOne;							// U bit. Wired-AND, so 1 if every node has 1.
+	bool allZero;							// ~U bit.
+
+	count = 0;
+	while( count < max )
+	{
+		if( adrs == SLAVE_ADRS )
+		{
+			++adrs;
+		}
+		if( (adrs < 0x08) || (adrs > 0x77) )
+		{
+			return SM_ERR_DATA;
+		}
+
+		// One pass finds one UID.
+		memset( prefix, 0, sizeof(prefix) );
+		n = 0;
+		while( n < IA_UID_SIZE*8 )
+		{
+			status = iaPrefix( n, prefix, reply );
+			if( status != SM_OK )
+			{
+				return ( (status == SB_ERR_ADRS_NACK) && (n == 0) ) ? SM_OK : status;
+			}
+
+			for( bit = n; bit < IA_UID_SIZE*8; ++bit )
+			{
+				mask = 0x80 >> (bit & 7);
+				allOne = reply[2*(bit >> 3)] & mask;
+				allZero = reply[2*(bit >> 3) + 1] & mask;
+				if( allOne && allZero )
+				{
+					// No node matched the prefix.
+					return (n == 0) ? SM_OK : SM_ERR_SEARCH;
+				}
+				if( allOne )
+				{
+					prefix[bit >> 3] |= mask;
+				}
+				else if( !allZero )
+				{
+					break;							// the nodes differ here. Take the 0 side.
+				}
+			}
+			n = (bit < IA_UID_SIZE*8) ? bit + 1 : bit;
+		}
+
+		status = iaAssign( prefix, adrs );
+		if( status != SM_OK )
+		{
+			return status;
+		}
+		++count;
+		++adrs;
+	}
+	return SM_OK;
+}
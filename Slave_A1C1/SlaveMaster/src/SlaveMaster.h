@@ -0,0 +1,217 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * SlaveMaster.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * I2C Master for the Slave_A1C1 firmware.
+ *
+ * Each command is sent as LEN MOD CMD DATA. The module and command IDs come from SlaveIds.h,
+ * which is generated from the Slave headers.
+ *
+ * Batching
+ *   Between beginBatch() and endBatch() the commands are put in one buffer and sent in one
+ *   transaction. The Slave takes them from its input FIFO one after the other. A batch is sent
+ *   early if the next command does not fit. Queries always send the batch first.
+ *
+ * Retry
+ *   A failed write is tried again up to the retry count. The wait starts at the retry delay
+ *   and doubles each time.
+ *
+ * Replies
+ *   With TWI_REPLY_STATUS the Slave sends a READY byte first in each read, the number of reply
+ *   bytes that follow. While it is 0 the read is done again at once, up to the poll count, so
+ *   the reply is read as soon as it is loaded. Then the retry delay is used between rounds of
+ *   polls, which covers a Slave that is still starting.
+ *   Without it, the reply delay is waited before the read and a reply that reads back as
+ *   INIT_BUSY_BYTE is read again with the retry delay.
+ *   The command is not sent again.
+ *
+ * Address assignment
+ *   iaAssignAll() gives each node still at SLAVE_ADRS its own address, the search described in
+ *   the Slave's i2c_address.c. PREFIX goes to the General Call address and all the nodes that
+ *   match answer the read at SLAVE_ADRS together, so the nodes must be done starting first.
+ *   Each pass follows the 0 branch at every bit where the nodes differ, so it finds the lowest
+ *   UID left. That node is moved and drops out of the search, and the next pass starts over.
+ *   The nodes keep the address after RESET. iaReset() sends them all back to SLAVE_ADRS.
+ *
+ * Example
+ *   WireBus bus;
+ *   SlaveMaster slave( bus );
+ *
+ *   slave.beginBatch();
+ *   slave.pwmOn();
+ *   slave.ledBlink( 100, 100 );
+ *   slave.endBatch();
+ *
+ * revision: 10/17/2026	0.02	ndp		add I2C address assignment.
+ */ 
+
+
+#ifndef SLAVEMASTER_H_
+#define SLAVEMASTER_H_
+
+#include <stdint.h>
+
+#include "SlaveBus.h"
+#include "SlaveIds.h"
+
+#define SM_BATCH_MAX		31			// Slave TWI_RX_BUFFER_SIZE - 1
+#define SM_REPLY_MAX		31			// Slave TWI_TX_BUFFER_SIZE - 1
+#define SM_DATA_MAX			15			// DATA bytes in one command. LEN is 4 bits.
+
+// Return codes. 1:4 are the SB_ERR bus codes.
+#define SM_OK				0
+#define SM_ERR_DATA			0x10		// too much DATA for one command.
+#define SM_ERR_BUSY			0x11		// the reply was not ready after all retries.
+#define SM_ERR_SHORT		0x12		// reply had fewer bytes than asked for.
+#define SM_ERR_NOT_SET		0x13		// cfgGet() key has no saved value.
+#define SM_ERR_SEARCH		0x14		// address search replies did not make sense.
+
+/*
+ * Bytes read back from the Slave. Multi-byte values are LSB first.
+ */
+class SlaveReply
+{
+public:
+	SlaveReply() : _count(0) {}
+
+	uint8_t count() const { return _count; }
+	const uint8_t* data() const { return _buf; }
+	uint8_t u8( uint8_t index ) const { return (index < _count) ? _buf[index] : 0; }
+	uint16_t u16( uint8_t index ) const { return u8(index) | (u8(index + 1) << 8); }
+	bool busy() const;
+
+private:
+	friend class SlaveMaster;
+
+	uint8_t	_buf[SM_REPLY_MAX];
+	uint8_t	_count;
+};
+
+class SlaveMaster
+{
+public:
+	explicit SlaveMaster( SlaveBus& bus, uint8_t adrs = SLAVE_ADRS );
+
+	void	setAddress( uint8_t adrs ) { _adrs = adrs; }
+	uint8_t	address() const { return _adrs; }
+	void	setRetry( uint8_t tries, uint16_t delayMs ) { _tries = tries; _retryDelay = delayMs; }
+	void	setReplyDelay( uint16_t ms ) { _replyDelay = ms; }
+	void	setReplyPolls( uint8_t polls ) { _polls = polls; }
+
+	void	beginBatch();
+	uint8_t	endBatch();
+
+	uint8_t	command( uint8_t mod, uint8_t cmd, const uint8_t* data = 0, uint8_t len = 0 );
+	uint8_t	query( uint8_t mod, uint8_t cmd, const uint8_t* data, uint8_t len,
+				   SlaveReply& reply, uint8_t replyLen );
+
+	static uint8_t makeHeader( uint8_t len ) { return (uint8_t)(((~len) << 4) & 0xF0) | (len & 0x0F); }
+
+	/* *** System *** */
+	uint8_t	initStatus( SlaveReply& reply );				// READY DEVICES TWI_L TWI_H DONE_L DONE_H
+	uint8_t	enterBootloader();
+
+	/* *** LED-1 *** */
+	uint8_t	ledOff();
+	uint8_t	ledOn();
+	uint8_t	ledBlink( uint16_t on, uint16_t off );			// 10ms tics
+	uint8_t	ledPulse( uint8_t count, uint16_t on, uint16_t off );
+	uint8_t	ledOneShot( uint16_t time );
+
+	/* *** LED-2 PWM glow *** */
+	uint8_t	pwmOff();
+	uint8_t	pwmOn();
+	uint8_t	pwmRate( uint8_t rate );
+
+	/* *** BAM LEDs *** */
+	uint8_t	bamOff();
+	uint8_t	bamOn();
+	uint8_t	bamSet( uint8_t chan, uint8_t level );
+	uint8_t	bamSetAll( uint8_t chan, const uint8_t* levels, uint8_t count );
+
+	/* *** Sequencer *** */
+	uint8_t	seqStop();
+	uint8_t	seqRun( uint8_t adrs );
+	uint8_t	seqLoad( uint8_t adrs, const uint8_t* prog, uint8_t count );
+	uint8_t	seqSave( bool autorun );
+	uint8_t	seqRestore();
+	uint8_t	seqStatus( uint8_t& state, uint8_t& pc );
+
+	/* *** GPIO *** */
+	uint8_t	gpioSet( uint8_t mb, uint8_t mc, uint8_t md );
+	uint8_t	gpioClear( uint8_t mb, uint8_t mc, uint8_t md );
+	uint8_t	gpioToggle( uint8_t mb, uint8_t mc, uint8_t md );
+	uint8_t	gpioOutput( uint8_t mb, uint8_t mc, uint8_t md );
+	uint8_t	gpioInput( uint8_t mb, uint8_t mc, uint8_t md );
+	uint8_t	gpioRead( uint8_t& pinb, uint8_t& pinc, uint8_t& pind );
+
+	/* *** ADC *** */
+	uint8_t	adcStop();
+	uint8_t	adcStart( uint8_t mode );
+	uint8_t	adcConfig( uint8_t chanMask, uint8_t osr );
+	uint8_t	adcRead( uint16_t* samples, uint8_t max, uint8_t& count );	// b15:13 = channel
+
+	/* *** Sonar *** */
+	uint8_t	sonarStop();
+	uint8_t	sonarStart();
+	uint8_t	sonarRead( uint8_t* cm );						// DEV_SONAR_COUNT values
+
+	/* *** LED matrix *** */
+	uint8_t	matrixOff();
+	uint8_t	matrixOn();
+	uint8_t	matrixIcon( uint8_t index );
+	uint8_t	matrixFrame( const uint8_t* rows );				// 8 rows
+
+	/* *** Configuration store *** */
+	uint8_t	cfgGet( uint8_t key, uint16_t& value );
+	uint8_t	cfgSet( uint8_t key, uint16_t value );
+
+	/* *** I2C address assignment *** */
+	uint8_t	iaReset();										// General Call
+	uint8_t	iaUid( uint8_t* uid );							// IA_UID_SIZE bytes
+	uint8_t	iaAssignAll( uint8_t first, uint8_t max, uint8_t& count );	// from FIRST up, SLAVE_ADRS skipped.
+
+private:
+	uint8_t	transmit( const uint8_t* data, uint8_t len );
+	uint8_t	receive( SlaveReply& reply, uint8_t len );
+	uint8_t	send3( uint8_t mod, uint8_t cmd, uint8_t mb, uint8_t mc, uint8_t md );
+	uint8_t	iaPrefix( uint8_t n, const uint8_t* prefix, uint8_t* reply );
+	uint8_t	iaAssign( const uint8_t* uid, uint8_t adrs );
+
+	SlaveBus&	_bus;
+	uint8_t		_adrs;
+	uint8_t		_tries;
+	uint16_t	_retryDelay;
+	uint16_t	_replyDelay;
+	uint8_t		_polls;
+
+	bool		_batching;
+	uint8_t		_batchLen;
+	uint8_t		_batch[SM_BATCH_MAX];
+};
+
+#endif /* SLAVEMASTER_H_ */
@@ -0,0 +1,64 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WireBus.cpp
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+#include "WireBus.h"
+
+uint8_t WireBus::write( uint8_t adrs, const uint8_t* data, uint8_t len )
+{
+	_wire.beginTransmission( adrs );
+	if( _wire.write( data, len ) != len )
+	{
+		_wire.endTransmission();
+		return SB_ERR_LENGTH;
+	}
+	return _wire.endTransmission();
+}
+
+uint8_t WireBus::read( uint8_t adrs, uint8_t* data, uint8_t len )
+{
+	uint8_t count = 0;
+
+	_wire.requestFrom( adrs, len );
+	while( _wire.available() && (count < len) )
+	{
+		data[count++] = _wire.read();
+	}
+	return count;
+}
+
+void WireBus::delayMs( uint16_t ms )
+{
+	delay( ms );
+}
+
+#endif /* ARDUINO */
@@ -4,16 +4,32 @@
 
 access.c
 
+config.c
+
+dev_adc.c
+
+dev_gpio.c
+
 dev_led_1.c
 
+dev_led_bam.c
+
 dev_led_pwm.c
 
+dev_matrix.c
+
+dev_seq.c
+
+dev_sonar.c
+
 flash_table.s
 
 function_tables.c
 
 i2c_address.c
 
+icon_table.c
+
 initialize.c
 
 service.c
@@ -22,5 +38,5 @@ Slave_A1C1.c
 
 sysTimer.c
 
-twiSlave.c
+../../Slave_Driver/twiSlave.c
 
@@ -27,6 +27,9 @@
  *  Author: Chip
  *
  * revision: 8/13/2015	0.02	ndp		make getMsgData() global.
+ * revision: 10/17/2026	0.03	ndp		add access_dispatch() for module to module commands.
+ * revision: 10/17/2026	0.04	ndp		hold messages until the devices are set up.
+ * revision: 10/17/2026	0.05	ndp		mark the reply READY after each command.
  *
  * This is the message header processor for I2C messages.
  *
@@ -48,10 +51,12 @@
 #include "function_tables.h"
 #include "twiSlave.h"
 #include "flash_table.h"
+#include "access.h"
+#include "initialize.h"
 
 
-#define ACCESS_MSG_BUFF_SIZE 20
 static uint8_t accMsgBuff[ACCESS_MSG_BUFF_SIZE];		// copy of command string.
+static const uint8_t* accMsgData = accMsgBuff;		// message read by getMsgData(). Changed by access_dispatch().
 static uint8_t accMsgIndex;					// index reset to 0 after command process.
 static uint8_t accMsgSize;						// expected total length of message.
 static MOD_FUNCTION_ENTRY* accFuncTable;		// Command table for Device of current Message.
@@ -62,12 +67,81 @@ static MOD_FUNCTION_ENTRY* accFuncTable;		// Command table for Device of current
 uint8_t getMsgData( uint8_t index )
 {
 	if( index < ACCESS_MSG_BUFF_SIZE ) {
-		return accMsgBuff[index];
+		return accMsgData[index];
 	} else {
 		return(0);					// ERROR
 	}
 }
 
+/*
+ * Find the command table for a module ID.
+ * Returns 0 if the module is not in mod_access_table[].
+ */
+static MOD_FUNCTION_ENTRY* access_findModule( uint8_t mod )
+{
+	uint8_t index = 0;
+	uint8_t id;
+
+	while( (id = flash_get_mod_access_id(index)) != 0 )
+	{
+		if( id == mod )
+		{
+			return flash_get_mod_function_table(index);
+		}
+		++index;
+	}
+	return 0;
+}
+
+/*
+ * Find the function for a command in a module command table.
+ * Returns 0 if the command is not in the table.
+ */
+static void (*access_findCmd( MOD_FUNCTION_ENTRY* table, uint8_t cmd ))()
+{
+	uint8_t index = 0;
+	uint16_t id;
+
+	while( (id = flash_get_access_cmd(index, table)) != 0 )
+	{
+		if( id == cmd )
+		{
+			return (void (*)())flash_get_access_func(index, table);
+		}
+		++index;
+	}
+	return 0;
+}
+
+/*
+ * Run a module command from inside the Slave. Used by modules like the sequencer.
+ * msg[] has the same LEN MOD CMD DATA format as an I2C message and has to be
+ * ACCESS_MSG_BUFF_SIZE bytes long since getMsgData() can read that far.
+ * The called function reads msg[] with getMsgData() as usual. A partial I2C message
+ * in accMsgBuff[] is not disturbed.
+ *
+ * Returns false if the module or command is not found.
+ */
+bool access_dispatch( const uint8_t* msg )
+{
+	MOD_FUNCTION_ENTRY* table;
+	void (*func)();
+
+	table = access_findModule( msg[1] );
+	if( table == 0 )
+		return false;
+
+	func = access_findCmd( table, msg[2] );
+	if( func == 0 )
+		return false;
+
+	accMsgData = msg;
+	func();
+	accMsgData = accMsgBuff;
+
+	return true;
+}
+
 /*
  * Initialize GLOBAL variables use by access_all().
  */
@@ -82,14 +156,14 @@ void access_init()
 void access_all()
 {
 	uint8_t temp;
-	uint8_t index;
-	bool search;
-	uint8_t mod;
-	uint8_t cmd;
-	bool scan;
-	
 	void (*func)() = 0;
 
+	/* Messages wait in the input buffer during a staged start up. */
+	if( !init_ready() )
+	{
+		return;
+	}
+
 	/* Check for I2C message. */
 	if(twiDataInReceiveBuffer())
 	{
@@ -130,50 +204,28 @@ void access_all()
 		if ( accMsgIndex == 3)
 		{
 			// Three bytes received. Should be a LEN MOD CMD. Check for a MOD match.
-			search = true;
-			index = 0;
-			while(search)
+			accFuncTable = access_findModule( accMsgBuff[1] );
+			if( accFuncTable == 0 )
 			{
-				mod = flash_get_mod_access_id(index);
-
-				if ( mod == 0)
-				{
-					// End of list. No match.
-					search = false;
-					accMsgIndex = 0;
-					accMsgSize = 0;
-					accFuncTable = 0;
-				}
-				else if ( mod == accMsgBuff[1] )
-				{
-					search = false;
-					// Get the function table for this module.
-					accFuncTable = flash_get_mod_function_table(index);
-				}
-				++index;
+				// End of list. No match.
+				accMsgIndex = 0;
+				accMsgSize = 0;
 			}
 		} // end if == 3
 
 		// Process command now?
 		if ( (accMsgIndex == accMsgSize) && (accMsgIndex != 0) && (accFuncTable != 0) )
 		{
-			scan = true;
-			index = 0;
-			while(scan)
+			func = access_findCmd( accFuncTable, accMsgBuff[2] );
+			if( func != 0 )
 			{
-				cmd = flash_get_access_cmd(index, accFuncTable);
-				func = (void (*)())flash_get_access_func(index, accFuncTable);
-				
-				if ( accMsgBuff[2] == cmd )
-				{
-					func();
-					accMsgIndex = 0;
-					accMsgSize = 0;
-					accFuncTable = 0;
-					scan = false;
-				}
-				++index;
+				func();
 			}
+			twiTransmitReady();				// reply, if any, can be read now.
+			// Unknown commands are dropped so the next message can sync.
+			accMsgIndex = 0;
+			accMsgSize = 0;
+			accFuncTable = 0;
 		}
 	} // end if recv data
 }
@@ -27,6 +27,7 @@
  *  Author: Chip
  *
  * revision: 8/13/2015	0.02	ndp		make getMsgData() global.
+ * revision: 10/17/2026	0.03	ndp		add access_dispatch().
  *
  */ 
 
@@ -34,7 +35,12 @@
 #ifndef ACCESS_H_
 #define ACCESS_H_
 
+#include <stdbool.h>
+
+#define ACCESS_MSG_BUFF_SIZE 20
+
 uint8_t getMsgData( uint8_t index );
+bool access_dispatch( const uint8_t* msg );
 
 void access_init(void);
 void access_all(void);
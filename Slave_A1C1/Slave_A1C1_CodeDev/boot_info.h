@@ -0,0 +1,86 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * boot_info.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		note the application size limit.
+ *
+ * Shared by the application (Slave_A1C1) and the I2C bootloader (Boot_A1C1).
+ *
+ * Flash (ATmega88A, BOOTSZ = 1024 words, BOOTRST programmed)
+ *   0x0000:0x17FF  Application. RWW section.
+ *   0x1800:0x1FFF  Bootloader. NRWW section, so it keeps running while an application page is written.
+ * The application is linked with __TEXT_REGION_LENGTH__ = BOOT_START (Slave_A1C1.cproj), so an
+ * image that would reach the bootloader fails to link instead of writing over it.
+ *
+ * EEPROM
+ *   The top BOOT_EE_SIZE bytes are used by the bootloader. EEMEM data is placed from 0x000 up
+ *   so the application must keep its EEMEM total below E2END + 1 - BOOT_EE_SIZE.
+ */ 
+
+
+#ifndef BOOT_INFO_H_
+#define BOOT_INFO_H_
+
+#define BOOT_START			0x1800				// byte address of the boot section.
+
+#define BOOT_EE_SIZE		6
+#define BOOT_EE_LEN			(E2END - 5)			// uint16_t application length in bytes. 0xFFFF = not checked.
+#define BOOT_EE_CRC			(E2END - 3)			// uint16_t CRC-16/XMODEM of the application.
+#define BOOT_EE_ADRS		(E2END - 1)			// I2C address to use in the bootloader.
+#define BOOT_EE_REQUEST		(E2END)				// BOOT_REQUEST = stay in the bootloader after RESET.
+
+#define BOOT_REQUEST		0xB7
+
+// Bootloader
+#define BOOT_ID				0xF0
+#define BOOT_VERSION		0x01
+
+#define BOOT_DATA_MAX		8					// DATA bytes per message. SPM_PAGESIZE must be a multiple of this.
+
+/*
+ * DATA messages can be sent to the General Call address to load all nodes at once. Each node is
+ * then checked with STATUS and CRC at its own address.
+ */
+#define CMD_BOOT_IDENT		1			// Returns VERSION PAGE_SIZE START_L START_H
+#define CMD_BOOT_ADDR		2			// ADRS_L ADRS_H. Page aligned byte address of the next DATA.
+#define CMD_BOOT_DATA		3			// D0..D7. Must not cross a page. A full page is queued to be written.
+#define CMD_BOOT_FLUSH		4			// Write a partial page. Unused bytes are 0xFF.
+#define CMD_BOOT_STATUS		5			// Returns STATE ERROR ADRS_L ADRS_H
+#define CMD_BOOT_CRC		6			// LEN_L LEN_H. Returns CRC_L CRC_H of flash 0:LEN-1
+#define CMD_BOOT_RUN		7			// LEN_L LEN_H CRC_L CRC_H. Save the check values and start the application.
+
+// STATUS STATE bits
+#define BOOT_STATE_READY	0x01		// DATA can be sent.
+#define BOOT_STATE_BUSY		0x02		// a page is being written.
+#define BOOT_STATE_PENDING	0x04		// a full page is waiting for the write to finish.
+
+// STATUS ERROR bits. Cleared by ADDR.
+#define BOOT_ERR_FRAME		0x01		// bad LEN or unknown command.
+#define BOOT_ERR_ADRS		0x02		// address not page aligned or in the boot section.
+#define BOOT_ERR_ALIGN		0x04		// DATA crosses a page.
+#define BOOT_ERR_CRC		0x08		// RUN check failed.
+
+#endif /* BOOT_INFO_H_ */
@@ -0,0 +1,286 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * config.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * EEPROM Configuration Store
+ *
+ * Settings are 16 bit values with a key of 0:15. They are kept in EEPROM as a ring of records
+ *   SEQ KEY VAL_L VAL_H CHK			CHK = ~(SEQ + KEY + VAL_L + VAL_H)
+ * Each change is written to the next slot in the ring so the writes are spread over all of
+ * the slots. SEQ goes up by one for each record. The newest record is the one whose next
+ * slot does not have SEQ+1. A record cut off by a power loss fails CHK and is ignored.
+ *
+ * cfg_init() reads the ring once at RESET into cfg_value[] so cfg_get() is just an SRAM read.
+ * It is called by init_all() before the device modules are set up so they can load their
+ * settings.
+ *
+ * cfg_set() only changes SRAM and marks the key. cfg_service() writes one byte each time the
+ * EEPROM is ready, so nothing waits on the 3.4ms write time. Several cfg_set() calls on a key
+ * before it is written make only one record.
+ * Before a slot is used, any key whose newest record is in it is written again so the ring
+ * never loses the only copy of a setting. If power is lost in the few ms that such a record is
+ * being rewritten, that key reads as its default after RESET.
+ */ 
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <stdbool.h>
+
+#include "access.h"
+#include "twiSlave.h"
+
+#include "config.h"
+
+#define CFG_REC_SIZE	5
+#define CFG_NO_SLOT		0xFF
+#define CFG_BIT(key)	((uint16_t)1 << (key))
+
+static uint8_t EEMEM	cfg_ee[CFG_SLOTS * CFG_REC_SIZE];
+
+static uint16_t	cfg_value[CFG_KEY_COUNT];
+static uint8_t	cfg_slot[CFG_KEY_COUNT];		// slot of the newest record for the key. CFG_NO_SLOT if none.
+static uint16_t	cfg_valid;						// keys that have a value. b0 = key 0.
+static uint16_t	cfg_dirty;						// keys to be written.
+
+static uint8_t	cfg_head;						// slot of the newest record.
+static uint8_t	cfg_seq;						// SEQ of the newest record.
+
+// Record being written.
+static uint8_t	cfg_wrBuf[CFG_REC_SIZE];
+static uint8_t	cfg_wrSlot;
+static uint8_t	cfg_wrIndex;					// next byte to write. CFG_REC_SIZE when idle.
+
+/*
+ * Read a record. Returns false if the CHK is bad or the slot is erased.
+ */
+static bool cfg_readRec( uint8_t slot, uint8_t* rec )
+{
+	uint8_t* ee = &cfg_ee[slot * CFG_REC_SIZE];
+	uint8_t i;
+
+	for( i=0; i<CFG_REC_SIZE; ++i )
+	{
+		rec[i] = eeprom_read_byte( ee + i );
+	}
+
+	return ( rec[1] < CFG_KEY_COUNT ) && ( (uint8_t)~(rec[0] + rec[1] + rec[2] + rec[3]) == rec[4] );
+}
+
+static uint8_t cfg_next( uint8_t slot )
+{
+	return ( slot + 1 < CFG_SLOTS ) ? slot + 1 : 0;
+}
+
+/*
+ * Build the index from the EEPROM ring.
+ */
+void cfg_init()
+{
+	uint8_t rec[CFG_REC_SIZE];
+	uint8_t next[CFG_REC_SIZE];
+	uint8_t slot;
+	uint8_t i;
+	bool found = false;
+
+	for( i=0; i<CFG_KEY_COUNT; ++i )
+	{
+		cfg_value[i] = 0;
+		cfg_slot[i] = CFG_NO_SLOT;
+	}
+	cfg_valid = 0;
+	cfg_dirty = 0;
+	cfg_wrIndex = CFG_REC_SIZE;
+
+	// Find the newest record.
+	cfg_head = CFG_SLOTS - 1;
+	cfg_seq = 0xFF;
+	for( slot=0; slot<CFG_SLOTS; ++slot )
+	{
+		if( !cfg_readRec(slot, rec) )
+			continue;
+		if( !cfg_readRec(cfg_next(slot), next) || ( next[0] != (uint8_t)(rec[0] + 1) ) )
+		{
+			cfg_head = slot;
+			cfg_seq = rec[0];
+			found = true;
+			break;
+		}
+	}
+
+	if( !found )
+		return;								// empty store.
+
+	// Replay from the oldest so the newest record for each key wins.
+	slot = cfg_head;
+	for( i=0; i<CFG_SLOTS; ++i )
+	{
+		slot = cfg_next(slot);
+		if( cfg_readRec(slot, rec) )
+		{
+			cfg_value[rec[1]] = rec[2] | (rec[3] << 8);
+			cfg_slot[rec[1]] = slot;
+			cfg_valid |= CFG_BIT(rec[1]);
+		}
+	}
+}
+
+/*
+ * Get a setting. Returns def if it has never been set.
+ */
+uint16_t cfg_get( uint8_t key, uint16_t def )
+{
+	if( (key < CFG_KEY_COUNT) && (cfg_valid & CFG_BIT(key)) )
+		return cfg_value[key];
+	return def;
+}
+
+/*
+ * Change a setting. It is written to EEPROM by cfg_service().
+ */
+void cfg_set( uint8_t key, uint16_t value )
+{
+	if( key >= CFG_KEY_COUNT )
+		return;
+
+	if( (cfg_valid & CFG_BIT(key)) && (cfg_value[key] == value) )
+		return;								// no change.
+
+	cfg_value[key] = value;
+	cfg_valid |= CFG_BIT(key);
+	cfg_dirty |= CFG_BIT(key);
+}
+
+/*
+ * true while changes are waiting to be written.
+ */
+bool cfg_busy()
+{
+	return ( cfg_dirty != 0 ) || ( cfg_wrIndex < CFG_REC_SIZE );
+}
+
+/*
+ * Set up cfg_wrBuf[] for key in the next slot.
+ */
+static void cfg_startRec( uint8_t key )
+{
+	uint16_t value = cfg_value[key];
+
+	cfg_wrSlot = cfg_next(cfg_head);
+	cfg_wrBuf[0] = cfg_seq + 1;
+	cfg_wrBuf[1] = key;
+	cfg_wrBuf[2] = value;
+	cfg_wrBuf[3] = value >> 8;
+	cfg_wrBuf[4] = ~(cfg_wrBuf[0] + cfg_wrBuf[1] + cfg_wrBuf[2] + cfg_wrBuf[3]);
+	cfg_wrIndex = 0;
+	cfg_dirty &= ~CFG_BIT(key);				// set again if changed before the record is done.
+}
+
+/*
+ * Called continuously.
+ * Writes one byte when the EEPROM is ready.
+ */
+void cfg_service()
+{
+	uint8_t key;
+	uint8_t next;
+
+	if( EECR & (1<<EEPE) )
+		return;								// EEPROM busy.
+
+	if( cfg_wrIndex < CFG_REC_SIZE )
+	{
+		eeprom_update_byte( &cfg_ee[cfg_wrSlot * CFG_REC_SIZE + cfg_wrIndex], cfg_wrBuf[cfg_wrIndex] );
+		if( ++cfg_wrIndex == CFG_REC_SIZE )
+		{
+			// Record done.
+			cfg_head = cfg_wrSlot;
+			cfg_seq = cfg_wrBuf[0];
+			cfg_slot[cfg_wrBuf[1]] = cfg_wrSlot;
+		}
+		return;
+	}
+
+	if( cfg_dirty == 0 )
+		return;
+
+	// Keep the newest record of a key that is in the slot to be used.
+	next = cfg_next(cfg_head);
+	for( key=0; key<CFG_KEY_COUNT; ++key )
+	{
+		if( cfg_slot[key] == next )
+		{
+			cfg_slot[key] = CFG_NO_SLOT;		// being moved. cfg_value[] is still good.
+			cfg_startRec( key );
+			return;
+		}
+	}
+
+	for( key=0; key<CFG_KEY_COUNT; ++key )
+	{
+		if( cfg_dirty & CFG_BIT(key) )
+		{
+			cfg_startRec( key );
+			return;
+		}
+	}
+}
+
+/*
+ * Get a setting
+ * CMD: E1 DEV 01 KEY
+ * Returns: VAL_L VAL_H VALID(0:1)
+ */
+void cfg_cmdGet()
+{
+	uint8_t key = getMsgData(3);
+	bool valid = ( key < CFG_KEY_COUNT ) && ( cfg_valid & CFG_BIT(key) );
+	uint16_t value = valid ? cfg_value[key] : 0;
+
+	twiTransmitByte( value );
+	twiTransmitByte( value >> 8 );
+	twiTransmitByte( valid );
+}
+
+/*
+ * Change a setting
+ * CMD: C3 DEV 02 KEY VAL_L VAL_H
+ */
+void cfg_cmdSet()
+{
+	cfg_set( getMsgData(3), getMsgData(4) | (getMsgData(5) << 8) );
+}
+
+/*
+ * Report write state
+ * CMD: F0 DEV 03
+ * Returns: PENDING(0:1) HEAD
+ */
+void cfg_cmdStatus()
+{
+	twiTransmitByte( cfg_busy() );
+	twiTransmitByte( cfg_head );
+}
@@ -0,0 +1,63 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * config.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include <stdbool.h>
+
+// Configuration Store
+#define CONFIG_ID			0xA0
+
+#define CFG_SLOTS			48			// records in the EEPROM ring. 5 bytes each.
+#define CFG_KEY_COUNT		16			// keys 0:15
+
+// Keys. Add new settings here.
+#define CFG_KEY_GLOW_RATE	0			// dev_led_pwm glow rate
+#define CFG_KEY_I2C_ADRS	1			// assigned I2C address. 0 = not assigned.
+//							2:15
+
+#define CMD_CFG_GET			1			// KEY. Returns VAL_L VAL_H VALID
+#define CMD_CFG_SET			2			// KEY VAL_L VAL_H
+#define CMD_CFG_STATUS		3			// Returns PENDING HEAD
+
+
+void cfg_init();
+uint16_t cfg_get( uint8_t key, uint16_t def );
+void cfg_set( uint8_t key, uint16_t value );
+bool cfg_busy();
+
+void cfg_service();
+
+void cfg_cmdGet();
+void cfg_cmdSet();
+void cfg_cmdStatus();
+
+#endif /* CONFIG_H_ */
@@ -0,0 +1,239 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_adc.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026		0.02	ndp		sample ring indices use the ring.h acquire and release.
+ *
+ * Continuous ADC sampling over a list of channels with oversampling.
+ *
+ * The ADC runs free or is triggered by the 1ms system tic (Timer0 Compare A). The ADC ISR adds
+ * each result into a sum. After 4^OSR samples the sum is decimated by OSR bits for OSR extra
+ * bits of resolution, put into the sample ring, and the next channel is selected.
+ * The ISR does a fixed amount of work per sample.
+ *
+ * The Master reads the ring in bulk with READ. The ISR is the only writer of dad_head and the
+ * main loop is the only writer of dad_tail. The 16 bit samples are ordered by the ring.h
+ * acquire and release of the indices, so main never reads a sample the ISR is writing.
+ */ 
+
+#include <avr/io.h>
+#include <stdbool.h>
+#include <avr/interrupt.h>
+
+#include "access.h"
+#include "twiSlave.h"
+#include "ring.h"
+
+#include "dev_adc.h"
+
+static uint8_t	dad_chan[8];					// channel list.
+static uint8_t	dad_chanCount;
+static uint8_t	dad_osr;						// extra bits from oversampling.
+static bool		dad_freeRun;					// next conversion starts before the ISR runs.
+
+// Used by the ISR only.
+static uint8_t	dad_chanIndex;
+static uint16_t	dad_sum;						// 64 x 1023 max fits in 16 bits.
+static uint8_t	dad_count;						// samples left for this result.
+static bool		dad_skip;						// drop the first result after a MUX change.
+
+static uint16_t			dad_ring[DEV_ADC_RING_SIZE];
+static volatile uint8_t	dad_head;
+static volatile uint8_t	dad_tail;
+static volatile uint8_t	dad_overrun;			// results lost to a full ring. Stops at 255.
+
+/*
+ * Select the current channel. AVcc reference.
+ * When free running, the conversion after a channel change has already started on the old
+ * channel so its result is dropped.
+ */
+static void dad_setMux( bool skip )
+{
+	ADMUX = (1<<REFS0) | dad_chan[dad_chanIndex];
+	dad_skip = skip;
+	dad_count = 1 << (2*dad_osr);
+	dad_sum = 0;
+}
+
+void dev_adc_init()
+{
+	dad_chan[0] = 0;
+	dad_chanCount = 1;
+	dad_osr = 0;
+	dad_freeRun = false;
+	dad_chanIndex = 0;
+	dad_head = 0;
+	dad_tail = 0;
+	dad_overrun = 0;
+
+	ADCSRA = DEV_ADC_PRESCALE;					// ADC off until START.
+	return;
+}
+
+/*
+ * Stop sampling. Data in the ring can still be read.
+ * CMD: F0 DEV 01
+ */
+void dev_adc_stop()
+{
+	ADCSRA = DEV_ADC_PRESCALE;
+	ADCSRA |= (1<<ADIF);						// clear any pending intr.
+}
+
+/*
+ * Start sampling from the first channel in the list.
+ * CMD: E1 DEV 02 MODE
+ */
+void dev_adc_start()
+{
+	dev_adc_stop();
+
+	dad_chanIndex = 0;
+	dad_setMux( false );
+	dad_freeRun = ( getMsgData(3) != ADC_MODE_TIMER );
+
+	if( !dad_freeRun )
+	{
+		ADCSRB = (0<<ADTS2)|(1<<ADTS1)|(1<<ADTS0);		// Timer0 Compare Match A
+		ADCSRA = (1<<ADEN)|(1<<ADATE)|(1<<ADIE)|DEV_ADC_PRESCALE;
+	}
+	else
+	{
+		ADCSRB = 0;										// Free Running
+		ADCSRA = (1<<ADEN)|(1<<ADSC)|(1<<ADATE)|(1<<ADIE)|DEV_ADC_PRESCALE;
+	}
+}
+
+/*
+ * Set the channel list and oversampling. Stops sampling and empties the ring.
+ * CMD: D2 DEV 03 CHAN_MASK OSR
+ */
+void dev_adc_config()
+{
+	uint8_t mask = getMsgData(3) & DEV_ADC_CHAN_MASK;
+	uint8_t i;
+
+	dev_adc_stop();
+
+	dad_chanCount = 0;
+	for( i=0; i<8; ++i )
+	{
+		if( mask & (1<<i) )
+		{
+			dad_chan[dad_chanCount++] = i;
+		}
+	}
+	if( dad_chanCount == 0 )
+	{
+		dad_chan[0] = 0;
+		dad_chanCount = 1;
+		mask = 0x01;
+	}
+
+	DIDR0 = mask & 0x3F;						// digital input off for analog pins. ADC6:7 have none.
+
+	dad_osr = getMsgData(4);
+	if( dad_osr > 3 )
+		dad_osr = 3;
+
+	ringStore( &dad_tail, ringLoad( &dad_head ) );
+	dad_overrun = 0;
+}
+
+/*
+ * Move up to MAX samples from the ring into the TX FIFO.
+ * CMD: E1 DEV 04 MAX
+ * Returns: COUNT S0_L S0_H S1_L S1_H ...
+ */
+void dev_adc_read()
+{
+	uint8_t max = getMsgData(3);
+	uint8_t avail;
+	uint8_t tail;
+	uint16_t sample;
+
+	if( max > DEV_ADC_READ_MAX )
+		max = DEV_ADC_READ_MAX;
+
+	tail = dad_tail;
+	avail = (ringLoad( &dad_head ) - tail) & DEV_ADC_RING_MASK;
+	if( avail > max )
+		avail = max;
+
+	twiTransmitByte( avail );
+	while( avail-- )
+	{
+		tail = (tail + 1) & DEV_ADC_RING_MASK;
+		sample = dad_ring[tail];
+		twiTransmitByte( sample );
+		twiTransmitByte( sample >> 8 );
+	}
+	ringStore( &dad_tail, tail );				// free the slots after they are copied.
+}
+
+/*
+ * Report ring state
+ * CMD: F0 DEV 05
+ * Returns: AVAILABLE OVERRUNS
+ */
+void dev_adc_status()
+{
+	twiTransmitByte( (ringLoad( &dad_head ) - dad_tail) & DEV_ADC_RING_MASK );
+	twiTransmitByte( dad_overrun );
+}
+
+/*
+ * ADC Conversion Complete interrupt service.
+ */
+ISR( ADC_vect )
+{
+	uint8_t head;
+
+	if( dad_skip )
+	{
+		dad_skip = false;						// result is from the prior MUX setting.
+		return;
+	}
+
+	dad_sum += ADC;
+	if( --dad_count != 0 )
+		return;
+
+	head = (dad_head + 1) & DEV_ADC_RING_MASK;
+	if( head != ringLoad( &dad_tail ) )
+	{
+		dad_ring[head] = ((uint16_t)dad_chanIndex << 13) | (dad_sum >> dad_osr);
+		ringStore( &dad_head, head );
+	}
+	else if( dad_overrun != 255 )
+	{
+		++dad_overrun;
+	}
+
+	if( ++dad_chanIndex >= dad_chanCount )
+		dad_chanIndex = 0;
+	dad_setMux( dad_freeRun && (dad_chanCount > 1) );
+}
@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_adc.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+
+#ifndef DEV_ADC_H_
+#define DEV_ADC_H_
+
+// Analog Input
+#define DEV_ADC_ID			0x70
+
+// Change as needed to match hardware.
+#define DEV_ADC_CHAN_MASK	0xCF		// ADC0:3, ADC6:7. ADC4:5 are SDA/SCL. ADC6:7 are TQFP/MLF only.
+#define DEV_ADC_PRESCALE	0b110		// CPU div 64 = 125kHz ADC clock at 8MHz. ~9.6k samples/sec free running.
+
+// Sample ring. Must be a power of 2.
+#define DEV_ADC_RING_SIZE	32
+#define DEV_ADC_RING_MASK	( DEV_ADC_RING_SIZE - 1 )
+
+#if ( DEV_ADC_RING_SIZE & DEV_ADC_RING_MASK )
+#  error DEV_ADC_RING_SIZE is not a power of 2
+#endif
+
+#define DEV_ADC_READ_MAX	15			// samples per READ. (1 + 2*15) bytes fits the TX FIFO.
+
+// START modes
+#define ADC_MODE_FREE		0			// free running.
+#define ADC_MODE_TIMER		1			// one sample each 1ms system tic (Timer0 Compare A).
+
+/*
+ * Each sample is 16 bits, sent LSB first.
+ *   b15:13 = index of the channel in the channel list (0 = lowest channel in CHAN_MASK)
+ *   b12:0  = result. 10 bits plus OSR extra bits.
+ */
+#define CMD_ADC_STOP		1
+#define CMD_ADC_START		2			// MODE
+#define CMD_ADC_CONFIG		3			// CHAN_MASK OSR(0:3 extra bits, 4^OSR samples each)
+#define CMD_ADC_READ		4			// MAX. Returns COUNT S0_L S0_H ...
+#define CMD_ADC_STATUS		5			// Returns AVAILABLE OVERRUNS
+
+
+void dev_adc_init();
+void dev_adc_stop();
+void dev_adc_start();
+void dev_adc_config();
+void dev_adc_read();
+void dev_adc_status();
+
+#endif /* DEV_ADC_H_ */
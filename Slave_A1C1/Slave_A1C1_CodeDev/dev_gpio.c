@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_gpio.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Mask based GPIO control for ports B, C, and D.
+ * One command changes any number of pins on all three ports, so a bank of LEDs or relays
+ * costs one I2C message instead of one per pin.
+ *
+ * The read-modify-write updates are done with interrupts off since ISRs (like dev_led_bam)
+ * may also be writing other pins on the same port. TOGGLE uses the PINx write feature, which
+ * is a single write and does not need this.
+ */ 
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#include "access.h"
+#include "twiSlave.h"
+
+#include "dev_gpio.h"
+
+/*
+ * Nothing to set up. All pins stay as they are until commanded.
+ */
+void dev_gpio_init()
+{
+	return;
+}
+
+/*
+ * Set pins HIGH
+ * CMD: C3 DEV 01 MB MC MD
+ */
+void dev_gpio_set()
+{
+	uint8_t mb = getMsgData(3) & DEV_GPIO_MASK_B;
+	uint8_t mc = getMsgData(4) & DEV_GPIO_MASK_C;
+	uint8_t md = getMsgData(5) & DEV_GPIO_MASK_D;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		PORTB |= mb;
+		PORTC |= mc;
+		PORTD |= md;
+	}
+}
+
+/*
+ * Set pins LOW
+ * CMD: C3 DEV 02 MB MC MD
+ */
+void dev_gpio_clear()
+{
+	uint8_t mb = getMsgData(3) & DEV_GPIO_MASK_B;
+	uint8_t mc = getMsgData(4) & DEV_GPIO_MASK_C;
+	uint8_t md = getMsgData(5) & DEV_GPIO_MASK_D;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		PORTB &= ~mb;
+		PORTC &= ~mc;
+		PORTD &= ~md;
+	}
+}
+
+/*
+ * Toggle pins
+ * Writing a 1 to a PINx bit toggles the PORTx bit in one cycle.
+ * CMD: C3 DEV 03 MB MC MD
+ */
+void dev_gpio_toggle()
+{
+	PINB = getMsgData(3) & DEV_GPIO_MASK_B;
+	PINC = getMsgData(4) & DEV_GPIO_MASK_C;
+	PIND = getMsgData(5) & DEV_GPIO_MASK_D;
+}
+
+/*
+ * Set pins as OUTPUT
+ * CMD: C3 DEV 04 MB MC MD
+ */
+void dev_gpio_output()
+{
+	uint8_t mb = getMsgData(3) & DEV_GPIO_MASK_B;
+	uint8_t mc = getMsgData(4) & DEV_GPIO_MASK_C;
+	uint8_t md = getMsgData(5) & DEV_GPIO_MASK_D;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		DDRB |= mb;
+		DDRC |= mc;
+		DDRD |= md;
+	}
+}
+
+/*
+ * Set pins as INPUT
+ * CMD: C3 DEV 05 MB MC MD
+ */
+void dev_gpio_input()
+{
+	uint8_t mb = getMsgData(3) & DEV_GPIO_MASK_B;
+	uint8_t mc = getMsgData(4) & DEV_GPIO_MASK_C;
+	uint8_t md = getMsgData(5) & DEV_GPIO_MASK_D;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		DDRB &= ~mb;
+		DDRC &= ~mc;
+		DDRD &= ~md;
+	}
+}
+
+/*
+ * Write masked values to all ports at once
+ * CMD: 96 DEV 06 MB VB MC VC MD VD
+ */
+void dev_gpio_write()
+{
+	uint8_t mb = getMsgData(3) & DEV_GPIO_MASK_B;
+	uint8_t vb = getMsgData(4) & mb;
+	uint8_t mc = getMsgData(5) & DEV_GPIO_MASK_C;
+	uint8_t vc = getMsgData(6) & mc;
+	uint8_t md = getMsgData(7) & DEV_GPIO_MASK_D;
+	uint8_t vd = getMsgData(8) & md;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		PORTB = (PORTB & ~mb) | vb;
+		PORTC = (PORTC & ~mc) | vc;
+		PORTD = (PORTD & ~md) | vd;
+	}
+}
+
+/*
+ * Read all ports
+ * The three ports are read back to back so the snapshot is as close together as possible.
+ * CMD: F0 DEV 07
+ * Returns: PINB PINC PIND
+ */
+void dev_gpio_read()
+{
+	uint8_t pb = PINB;
+	uint8_t pc = PINC;
+	uint8_t pd = PIND;
+
+	twiTransmitByte( pb );
+	twiTransmitByte( pc );
+	twiTransmitByte( pd );
+}
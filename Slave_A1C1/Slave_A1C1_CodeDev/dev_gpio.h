@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_gpio.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		leave the pins of the enabled modules out of the masks.
+ */ 
+
+
+#ifndef DEV_GPIO_H_
+#define DEV_GPIO_H_
+
+#include "function_tables.h"
+#include "dev_led_1.h"
+#include "dev_led_pwm.h"
+#include "dev_led_bam.h"
+#include "dev_matrix.h"
+#include "dev_sonar.h"
+
+// General Purpose I/O
+#define DEV_GPIO_ID			0x60
+
+// Change as needed to match hardware. The pins brought out for general use.
+#define DEV_GPIO_BOARD_B	0xFF
+#define DEV_GPIO_BOARD_C	0x0F		// PC4:5 are SDA/SCL and PC6 is RESET.
+#define DEV_GPIO_BOARD_D	0xFF
+
+/*
+ * Only the pins in the MASKs can be changed by the GPIO commands. The pins of the modules in
+ * the build are taken out, so a GPIO command can not stop one of them:
+ *   PD0					LED-1
+ *   PB1					LED PWM (OC1A)
+ *   PB2:5					MATRIX SPI and LATCH. PB4 (MISO) is held by the SPI too.
+ *   PD2:7 PB0 PB6:7		LED BAM planes (USE_DEV_LED_BAM)
+ *   PD2:3 PD4:5			SONAR TRIG and ECHO (USE_DEV_SONAR)
+ *   PC0:3					ADC inputs. Only the channels set by ADC CONFIG (DIDR0), at run time.
+ * With BAM and no SONAR that leaves PD1, and PC0:3 while they are not ADC inputs.
+ */
+#define DEV_GPIO_USED_MATRIX	( (1<<DEV_MATRIX_LATCH) | (1<<DEV_MATRIX_MOSI) | (1<<PB4) | (1<<DEV_MATRIX_SCK) )
+
+#if USE_DEV_LED_BAM
+#  define DEV_GPIO_USED_BAM_B	DEV_LED_BAM_MASK1
+#  define DEV_GPIO_USED_BAM_D	DEV_LED_BAM_MASK0
+#else
+#  define DEV_GPIO_USED_BAM_B	0
+#  define DEV_GPIO_USED_BAM_D	0
+#endif
+
+#if USE_DEV_SONAR
+#  define DEV_GPIO_USED_SONAR_D	( (((1<<DEV_SONAR_COUNT) - 1) << DEV_SONAR_TRIG0) | (((1<<DEV_SONAR_COUNT) - 1) << DEV_SONAR_ECHO0) )
+#else
+#  define DEV_GPIO_USED_SONAR_D	0
+#endif
+
+#define DEV_GPIO_MASK_B		( DEV_GPIO_BOARD_B & ~( (1<<DEV_LED_PWM_P) | DEV_GPIO_USED_MATRIX | DEV_GPIO_USED_BAM_B ) & 0xFF )
+#define DEV_GPIO_MASK_C		( DEV_GPIO_BOARD_C & ~DIDR0 )
+#define DEV_GPIO_MASK_D		( DEV_GPIO_BOARD_D & ~( (1<<DEV_LED_OUT_PIN) | DEV_GPIO_USED_BAM_D | DEV_GPIO_USED_SONAR_D ) & 0xFF )
+
+/*
+ * All commands except READ take one mask byte for each port in B C D order.
+ * WRITE takes a MASK VALUE pair for each port.
+ */
+#define CMD_GPIO_SET		1			// MB MC MD			PORTx |= Mx
+#define CMD_GPIO_CLEAR		2			// MB MC MD			PORTx &= ~Mx
+#define CMD_GPIO_TOGGLE		3			// MB MC MD			PINx = Mx
+#define CMD_GPIO_OUTPUT		4			// MB MC MD			DDRx |= Mx
+#define CMD_GPIO_INPUT		5			// MB MC MD			DDRx &= ~Mx
+#define CMD_GPIO_WRITE		6			// MB VB MC VC MD VD	PORTx = (PORTx & ~Mx) | (Vx & Mx)
+#define CMD_GPIO_READ		7			// returns PINB PINC PIND
+
+
+void dev_gpio_init();
+void dev_gpio_set();
+void dev_gpio_clear();
+void dev_gpio_toggle();
+void dev_gpio_output();
+void dev_gpio_input();
+void dev_gpio_write();
+void dev_gpio_read();
+
+#endif /* DEV_GPIO_H_ */
@@ -25,18 +25,84 @@
  *
  * Created: 5/18/2015 8:59:27 PM
  *  Author: Chip
+ * revision: 10/17/2026		0.02	ndp		add BLINK, PULSE, and ONESHOT timed modes.
+ *
+ * The timed modes are run by dev_led_1_service() from the 10ms tic so the Master only
+ * sends one command to start a pattern. OFF or ON stops any timed mode.
+ * All times are in 10ms tics. A time of 0 is used as 1.
  */ 
 
 #include <avr/io.h>
+#include <stdbool.h>
+
+#include "sysTimer.h"
+#include "access.h"
 
 #include "dev_led_1.h"
 
 #define DEMO_BOARD	0					// Use for testing. Set to 0 for proto-board set up.
 
+static bool		dl1_timed;				// true when a timed mode is running.
+static bool		dl1_lit;				// LED state for the timed mode.
+static uint8_t	dl1_count;				// pulses left. 0 = forever.
+static uint16_t	dl1_onTime;
+static uint16_t	dl1_offTime;
+static uint16_t	dl1_tics;				// tics left in this ON or OFF time.
+
+/*
+ * Set the LED pin for ON (true) or OFF (false).
+ */
+static void dl1_write( bool on )
+{
+#if DEMO_BOARD == 0
+	if( on ) {
+		DEV_LED_PORT |= (1<<DEV_LED_OUT_PIN);		// set HIGH
+	} else {
+		DEV_LED_PORT &= ~(1<<DEV_LED_OUT_PIN);		// set LOW
+	}
+#else
+	// Reverse logic for demo board use.
+	if( on ) {
+		DEV_LED_PORT &= ~(1<<DEV_LED_OUT_PIN);		// set LOW
+	} else {
+		DEV_LED_PORT |= (1<<DEV_LED_OUT_PIN);		// set HIGH
+	}
+#endif
+	dl1_lit = on;
+}
+
+/*
+ * Get a 16 bit time from message data L H at index.
+ */
+static uint16_t dl1_getTime( uint8_t index )
+{
+	uint16_t time = getMsgData(index) | (getMsgData(index+1) << 8);
+
+	if( time == 0 )
+		time = 1;
+	return time;
+}
+
+/*
+ * Start a timed mode with the LED ON.
+ */
+static void dl1_start( uint8_t count, uint16_t onTime, uint16_t offTime )
+{
+	dl1_count = count;
+	dl1_onTime = onTime;
+	dl1_offTime = offTime;
+	dl1_tics = onTime;
+	dl1_timed = true;
+	dl1_write( true );
+}
+
 void dev_led_1_init()
 {
 	DEV_LED_DDR |= (1<<DEV_LED_OUT_PIN);			// set HIGH for output
 
+	dl1_timed = false;
+	dl1_lit = false;
+
 #if DEMO_BOARD == 1
 	// Extras for demo board use.
 	DDRB |= (1<<PB0);					// use Port B B0 as output
@@ -51,12 +117,8 @@ void dev_led_1_init()
  */
 void dev_led_1_off()
 {
-#if DEMO_BOARD == 0
-	DEV_LED_PORT &= ~(1<<DEV_LED_OUT_PIN);			// set LOW
-#else
-	// Reverse logic for demo board use.
-	DEV_LED_PORT |= (1<<DEV_LED_OUT_PIN);			// set HIGH
-#endif
+	dl1_timed = false;
+	dl1_write( false );
 	return;
 }
 
@@ -66,11 +128,67 @@ void dev_led_1_off()
  */
 void dev_led_1_on()
 {
-#if DEMO_BOARD == 0
-	DEV_LED_PORT |= (1<<DEV_LED_OUT_PIN);			// set HIGH
-#else
-	// Reverse logic for demo board use.
-	DEV_LED_PORT &= ~(1<<DEV_LED_OUT_PIN);			// set LOW
-#endif
+	dl1_timed = false;
+	dl1_write( true );
 	return;
 }
+
+/*
+ * Blink LED until OFF or ON
+ * CMD: B4 DEV 03 ON_L ON_H OFF_L OFF_H
+ */
+void dev_led_1_blink()
+{
+	dl1_start( 0, dl1_getTime(3), dl1_getTime(5) );
+}
+
+/*
+ * Blink LED COUNT times then leave it OFF. COUNT of 0 is the same as BLINK.
+ * CMD: A5 DEV 04 COUNT ON_L ON_H OFF_L OFF_H
+ */
+void dev_led_1_pulse()
+{
+	dl1_start( getMsgData(3), dl1_getTime(4), dl1_getTime(6) );
+}
+
+/*
+ * Turn LED ON for TIME then OFF.
+ * CMD: D2 DEV 05 TIME_L TIME_H
+ */
+void dev_led_1_oneShot()
+{
+	uint16_t time = dl1_getTime(3);
+
+	dl1_start( 1, time, time );
+}
+
+/*
+ * Called continuously.
+ * Runs the timed modes on the 10ms tic.
+ */
+void dev_led_1_service()
+{
+	if( GPIOR0 & (1<<LED1_10MS_TIC) )
+	{
+		GPIOR0 &= ~(1<<LED1_10MS_TIC);
+
+		if( !dl1_timed || (--dl1_tics != 0) )
+			return;
+
+		if( dl1_lit )
+		{
+			dl1_write( false );
+			if( (dl1_count != 0) && (--dl1_count == 0) )
+			{
+				dl1_timed = false;			// done.
+				return;
+			}
+			dl1_tics = dl1_offTime;
+		}
+		else
+		{
+			dl1_write( true );
+			dl1_tics = dl1_onTime;
+		}
+	}
+}
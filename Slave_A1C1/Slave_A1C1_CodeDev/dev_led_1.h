@@ -25,6 +25,7 @@
  *
  * Created: 5/19/2015 1:09:53 PM
  *  Author: Chip
+ * revision: 10/17/2026		0.02	ndp		add timed modes.
  */ 
 
 
@@ -40,11 +41,19 @@
 
 #define CMD_LED_OFF			1
 #define CMD_LED_ON			2
+#define CMD_LED_BLINK		3			// ON_L ON_H OFF_L OFF_H		(10ms tics)
+#define CMD_LED_PULSE		4			// COUNT ON_L ON_H OFF_L OFF_H
+#define CMD_LED_ONESHOT		5			// TIME_L TIME_H
 
 
 void dev_led_1_init();
 void dev_led_1_off();
 void dev_led_1_on();
+void dev_led_1_blink();
+void dev_led_1_pulse();
+void dev_led_1_oneShot();
+
+void dev_led_1_service();
 
 
 #endif /* DEV_LED_1_H_ */
\ No newline at end of file
@@ -0,0 +1,239 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_led_bam.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Bit Angle Modulation (BAM) software PWM for up to 16 LEDs on plain GPIO pins.
+ *
+ * Each channel has an 8-bit level. The levels are converted into eight bit planes, one for each
+ * bit weight, where each plane holds the port value for all channels. The ISR just writes the
+ * next plane to the ports and schedules the next interrupt 2^bit LSB times later, so the cost
+ * per interrupt is the same for 1 or 16 channels.
+ *
+ * The planes are double buffered. The service builds a new set in the back buffer and the ISR
+ * swaps them at the start of a frame so an update never tears.
+ *
+ * Uses Timer2 in Normal mode with the OCR2B compare interrupt. The OCR2B value is advanced by
+ * the slot length each interrupt, so ISR latency does not add up over a frame.
+ * NOTE: Timer2 is also used by st_init_tmr2() for the sonar cm-counter. Only one can be used.
+ */ 
+
+#include <avr/io.h>
+#include <stdbool.h>
+#include <avr/interrupt.h>
+
+#include "access.h"
+
+#include "dev_led_bam.h"
+
+#define PROFILE_ISR		0					// Set to 1 to pulse PD1 HIGH during the ISR for scope timing.
+
+static uint8_t	dlb_level[DEV_LED_BAM_CHANNELS];	// 0:255 brightness for each channel.
+static uint8_t	dlb_plane[2][8][2];					// [buffer][bit][port] port values for each bit weight.
+
+static volatile uint8_t	dlb_front;					// plane buffer used by the ISR.
+static volatile bool	dlb_swap;					// back buffer ready. Cleared by ISR at frame start.
+static bool				dlb_dirty;					// levels changed. Rebuild back buffer.
+
+static uint8_t	dlb_bit;							// ISR: bit plane being output.
+static uint8_t	dlb_slot;							// ISR: 1<<dlb_bit. Number of LSB counts for this plane.
+
+void dev_led_bam_init()
+{
+	uint8_t i;
+
+	for( i=0; i<DEV_LED_BAM_CHANNELS; ++i )
+	{
+		dlb_level[i] = 0;
+	}
+	for( i=0; i<8; ++i )
+	{
+		dlb_plane[0][i][0] = 0;
+		dlb_plane[0][i][1] = 0;
+		dlb_plane[1][i][0] = 0;
+		dlb_plane[1][i][1] = 0;
+	}
+	dlb_front = 0;
+	dlb_swap = false;
+	dlb_dirty = false;
+	dlb_bit = 0;
+	dlb_slot = 1;
+
+	DEV_LED_BAM_PORT0 &= ~DEV_LED_BAM_MASK0;		// all OFF
+	DEV_LED_BAM_PORT1 &= ~DEV_LED_BAM_MASK1;
+	DEV_LED_BAM_DDR0 |= DEV_LED_BAM_MASK0;			// set HIGH for output
+	DEV_LED_BAM_DDR1 |= DEV_LED_BAM_MASK1;
+
+#if PROFILE_ISR == 1
+	DDRD |= (1<<PD1);
+#endif
+
+	// Set up Timer 2
+	TCCR2A = 0;										// Normal mode, no pin outputs.
+	TCCR2B = DEV_LED_BAM_CS;
+	OCR2B = TCNT2 + 1;
+	TIFR2 = (1<<OCF2B);								// clear any old match.
+	TIMSK2 |= (1<<OCIE2B);
+
+	return;
+}
+
+/*
+ * Turn all BAM LEDs OFF
+ * Stops the interrupt and leaves the levels as they are.
+ * CMD: F0 DEV 01
+ */
+void dev_led_bam_off()
+{
+	TIMSK2 &= ~(1<<OCIE2B);
+	DEV_LED_BAM_PORT0 &= ~DEV_LED_BAM_MASK0;		// set LOW
+	DEV_LED_BAM_PORT1 &= ~DEV_LED_BAM_MASK1;
+	return;
+}
+
+/*
+ * Turn BAM LEDs back ON at their current levels.
+ * CMD: F0 DEV 02
+ */
+void dev_led_bam_on()
+{
+	if( !(TIMSK2 & (1<<OCIE2B)) )
+	{
+		OCR2B = TCNT2 + 1;
+		TIFR2 = (1<<OCF2B);
+		TIMSK2 |= (1<<OCIE2B);
+	}
+	return;
+}
+
+/*
+ * Set one channel level
+ * CMD: D2 DEV 03 CHAN LEVEL
+ */
+void dev_led_bam_set()
+{
+	uint8_t chan = getMsgData(3);
+
+	if( chan < DEV_LED_BAM_CHANNELS )
+	{
+		dlb_level[chan] = getMsgData(4);
+		dlb_dirty = true;
+	}
+}
+
+/*
+ * Set consecutive channel levels starting at CHAN
+ * CMD: LEN DEV 04 CHAN LEVEL0 LEVEL1 ...
+ */
+void dev_led_bam_setAll()
+{
+	uint8_t chan = getMsgData(3);
+	uint8_t count = (getMsgData(0) & 0x0F) - 1;		// number of LEVEL bytes.
+	uint8_t i;
+
+	for( i=0; (i<count) && (chan<DEV_LED_BAM_CHANNELS); ++i, ++chan )
+	{
+		dlb_level[chan] = getMsgData(4+i);
+	}
+	dlb_dirty = true;
+}
+
+/*
+ * Called continuously.
+ * Rebuild the back buffer bit planes after a level change. Wait for the ISR to take the
+ * prior buffer before writing over it.
+ */
+void dev_led_bam_service()
+{
+	uint8_t back;
+	uint8_t bit;
+	uint8_t mask;
+	uint8_t chan;
+	uint8_t p0;
+	uint8_t p1;
+
+	if( !dlb_dirty || dlb_swap )
+		return;
+
+	dlb_dirty = false;
+	back = dlb_front ^ 1;
+	mask = 1;
+
+	for( bit=0; bit<8; ++bit )
+	{
+		p0 = 0;
+		p1 = 0;
+		for( chan=0; chan<8; ++chan )
+		{
+			if( dlb_level[chan] & mask )
+				p0 |= (1<<chan);
+			if( dlb_level[chan+8] & mask )
+				p1 |= (1<<chan);
+		}
+		dlb_plane[back][bit][0] = p0 & DEV_LED_BAM_MASK0;
+		dlb_plane[back][bit][1] = p1 & DEV_LED_BAM_MASK1;
+		mask <<= 1;
+	}
+
+	dlb_swap = true;								// ISR uses it at the next frame.
+}
+
+/*
+ * Timer2 Compare B interrupt service.
+ * Output the next bit plane and schedule the next one dlb_slot LSB counts later.
+ * A frame is 1+2+4+...+128 = 255 counts.
+ */
+ISR( TIMER2_COMPB_vect )
+{
+	const uint8_t* plane;
+
+#if PROFILE_ISR == 1
+	PORTD |= (1<<PD1);
+#endif
+
+	if( (dlb_bit == 0) && dlb_swap )
+	{
+		dlb_front ^= 1;
+		dlb_swap = false;
+	}
+
+	plane = dlb_plane[dlb_front][dlb_bit];
+	DEV_LED_BAM_PORT0 = (DEV_LED_BAM_PORT0 & ~DEV_LED_BAM_MASK0) | plane[0];
+	DEV_LED_BAM_PORT1 = (DEV_LED_BAM_PORT1 & ~DEV_LED_BAM_MASK1) | plane[1];
+
+	OCR2B += dlb_slot;
+
+	dlb_slot <<= 1;
+	if( ++dlb_bit == 8 )
+	{
+		dlb_bit = 0;
+		dlb_slot = 1;
+	}
+
+#if PROFILE_ISR == 1
+	PORTD &= ~(1<<PD1);
+#endif
+}
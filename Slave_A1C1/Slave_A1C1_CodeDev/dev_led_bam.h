@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_led_bam.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		take the guessed ISR load out of the Timer2 table.
+ * revision: 10/17/2026	0.03	ndp		add the hand count of the ISR, its load and the TWI delay.
+ */ 
+
+
+#ifndef DEV_LED_BAM_H_
+#define DEV_LED_BAM_H_
+
+// Bit Angle Modulation LED bank
+#define DEV_LED_BAM_ID		0x40
+
+// Change as needed to match hardware.
+// Channel 0:7 are bits 0:7 of PORT0 and channel 8:15 are bits 0:7 of PORT1.
+// Only the pins set in the MASK are driven. All others are left alone.
+#define DEV_LED_BAM_DDR0		DDRD
+#define DEV_LED_BAM_PORT0		PORTD
+#define DEV_LED_BAM_MASK0		0xFC		// PD2:7 (PD0 is LED-1)
+
+#define DEV_LED_BAM_DDR1		DDRB
+#define DEV_LED_BAM_PORT1		PORTB
+#define DEV_LED_BAM_MASK1		0xC1		// PB0, PB6:7 (PB1 is OC1A glow. PB2:5 is the dev_matrix SPI)
+
+#define DEV_LED_BAM_CHANNELS	16
+
+/*
+ * Timer2 clock select. The frame is 255 Timer2 counts long so this sets the refresh rate.
+ * 8 interrupts per frame regardless of channel count (Host_A1C1 test_bam checks this).
+ *
+ *   CS2  div    LSB time   refresh   intr/sec
+ *   100  64      8.0us      490Hz     3922
+ *   101  128    16.0us      245Hz     1961
+ *   110  256    32.0us      123Hz      980
+ *
+ * ISR cycles. Hand count of TIMER2_COMPB_vect from dev_led_bam.c for avr-gcc -Os, with a
+ * prologue that saves r0, r1, SREG and six work registers. It is not from an avr-objdump
+ * listing. Simavr_I2C avr_cycles (t2_compb in cycles_report.json) replaces it once run.
+ *
+ *   part                                        cycles
+ *   vector response + RJMP                        6
+ *   prologue / epilogue incl. RETI               43
+ *   body, bit 1:6                                46
+ *   body, bit 7 (wrap to bit 0)                  51
+ *   body, bit 0 with a swap                      57
+ *   whole ISR                                   95 to 106, 96 avg per frame
+ *
+ * ISR load = 96 cycles * intr/sec / F_CPU. At 8MHz:
+ *
+ *   CS2  div    load
+ *   100  64     4.7%
+ *   101  128    2.4%
+ *   110  256    1.2%
+ *
+ * TWI delay. A TWI event just after the BAM ISR starts waits for the rest of it, then one
+ * main loop instruction. That is 106 + 4 = 110 cycles, 13.8us at 8MHz, for every prescaler.
+ * The prescaler only changes how often it can happen. SCL is held low for that time, so a
+ * 100kHz byte (90us) can take up to 104us.
+ *
+ * Short slot. OCR2B is written about 62 cycles (7.8us) after the match, or 73 cycles (9.1us)
+ * at bit 0 with a swap. The next match is 1 LSB after, so the LSB time has to be longer than
+ * that plus any TWI_vect run just before, or the slot is missed for a full Timer2 wrap.
+ * div 64 (8.0us) misses it on every swap. div 128 (16us) leaves about 55 cycles for TWI_vect.
+ */
+#define DEV_LED_BAM_CS		0b101		// CPU div 128
+
+#define CMD_LED_BAM_OFF			1
+#define CMD_LED_BAM_ON			2
+#define CMD_LED_BAM_SET			3		// CHAN LEVEL
+#define CMD_LED_BAM_SET_ALL		4		// CHAN LEVEL0 LEVEL1 ... up to 14 levels
+
+
+void dev_led_bam_init();
+void dev_led_bam_off();
+void dev_led_bam_on();
+void dev_led_bam_set();
+void dev_led_bam_setAll();
+
+void dev_led_bam_service();
+
+#endif /* DEV_LED_BAM_H_ */
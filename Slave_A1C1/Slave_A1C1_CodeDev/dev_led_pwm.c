@@ -25,28 +25,33 @@
  *
  * Created: 2/24/2016		0.01	ndp
  *  Author: Chip
+ * revision: 10/17/2026		0.02	ndp		write OCR1A from the service only on change. No Timer1 interrupt.
+ * revision: 10/17/2026		0.03	ndp		keep the glow rate in the configuration store.
+ *
+ * OCR1A is double buffered by the hardware in Fast PWM mode and is only loaded at TOP, so it
+ * can be written from the service at any time without a glitch.
  */ 
 
 #include <avr/io.h>
 #include <stdbool.h>
-#include <avr/interrupt.h>
 
 #include "sysTimer.h"
 #include "access.h"
+#include "config.h"
 
 #include "dev_led_pwm.h"
 
 #define DEMO_BOARD	0					// Use for testing. Set to 0 for proto-board set up.
 
-bool	dlp_state;
-int		dlp_rate;
-int		dlp_rateAdjust;					// Controls how fast the glow cycles.
+bool		dlp_state;
+uint16_t	dlp_rate;					// Glow level. 0:0x03FF
+uint16_t	dlp_rateAdjust;				// Controls how fast the glow cycles.
 
 void dev_led_pwm_init()
 {
 	dlp_state = false;
 	dlp_rate = 0;
-	dlp_rateAdjust = 4;
+	dlp_rateAdjust = cfg_get( CFG_KEY_GLOW_RATE, 4 );
 	
 	DEV_LED_PWM_DDR |= (1<<DEV_LED_PWM_P);			// set HIGH for output
 
@@ -59,8 +64,7 @@ void dev_led_pwm_init()
 	// Set up Timer 1
 	TCCR1A |= (1<<COM1A1)|(0<<COM1A0)|(0<<COM1B1)|(0<<COM1B0)|(1<<WGM11)|(1<<WGM10);	// Use OC1A pin for PWM
 	TCCR1B |= (0<<WGM13)|(1<<WGM12)|(0<<CS12)|(1<<CS11)|(1<<CS10);						// WGM = 0111 for 0x03FF as TOP..CPU div 1 = 0.050us
-	OCR1A = 0x0200;			// 50%
-	TIMSK1 |= (1<<TOIE1);					// OV bit intr
+	OCR1A = 0;				// Matches dlp_rate. Updated by dev_led_pwm_service().
 
 	return;
 }
@@ -88,30 +92,36 @@ void dev_led_pwm_on()
 }
 
 /*
- * Set glow rate
- * CMD: F0 DEV 03 RATE
+ * Set glow rate. Saved in EEPROM.
+ * CMD: E1 DEV 03 RATE
  */
 void dev_led_pwm_setRate()
 {
 	dlp_rateAdjust = getMsgData(3) & 0x03FF;				// Limit to max count of Timer1
+	cfg_set( CFG_KEY_GLOW_RATE, dlp_rateAdjust );
 }
 
 /*
  * Called continuously.
+ * OCR1A is only written when the glow level changes. No ISR uses Timer1, so the 16-bit
+ * write does not need to be protected.
  */
 void dev_led_pwm_service()
 {
+	uint16_t rate;
+
 	if( GPIOR0 & (1<<DEV_10MS_TIC) )
 	{
 		GPIOR0 &= ~(1<<DEV_10MS_TIC);
 
-		dlp_rate += dlp_rateAdjust;
-		if( dlp_rate > 0x03FF )
-			dlp_rate = 0;		
-	}
-}
+		rate = dlp_rate + dlp_rateAdjust;
+		if( rate > 0x03FF )
+			rate = 0;
 
-ISR( TIMER1_OVF_vect )
-{
-	OCR1A = dlp_rate;
+		if( rate != dlp_rate )
+		{
+			dlp_rate = rate;
+			OCR1A = rate;				// Loaded by the hardware at the next TOP.
+		}
+	}
 }
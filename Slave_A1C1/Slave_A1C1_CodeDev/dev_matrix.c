@@ -0,0 +1,288 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_matrix.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026		0.02	ndp		add ROWS and XOR partial updates.
+ * revision: 10/17/2026		0.03	ndp		ROWS and XOR need one data byte per BITMAP bit.
+ *
+ * Multiplexed 8x8 LED Matrix
+ *
+ * One row is shown for each 1ms system tic using the Timer0 Compare B interrupt, so the whole
+ * display refreshes at 125Hz with no extra timer. Timer0 runs in CTC mode with OCR0A as TOP,
+ * so OCR0B just has to be below OCR0A to get one interrupt per tic.
+ *
+ * The frame is double buffered. Commands write the back buffer and request a swap, which the
+ * ISR does before row 0 so a new image never tears.
+ * Icons are copied from icon_table[] in FLASH with flash_copy8().
+ *
+ * ROWS and XOR only send the rows that change. A BITMAP byte tells which rows follow, b0 for
+ * row 0. The changes are made to a copy of the newest frame in the back buffer and swapped
+ * in like a full frame. A message whose data bytes do not match the bits set in BITMAP is
+ * dropped, so a short message can not fill rows with bytes left from an older one.
+ */ 
+
+#include <avr/io.h>
+#include <stdbool.h>
+#include <avr/interrupt.h>
+
+#include "sysdefs.h"
+#include "access.h"
+#include "flash_table.h"
+#include "icon_table.h"
+
+#include "dev_matrix.h"
+
+static uint8_t			dmx_frame[2][8];		// [buffer][row]
+static volatile uint8_t	dmx_front;				// buffer shown by the ISR.
+static volatile bool	dmx_swap;				// back buffer ready. Cleared by ISR before row 0.
+static uint8_t			dmx_newest;				// buffer with the newest frame. Shown or waiting.
+
+static uint8_t	dmx_row;						// ISR: row being shown.
+static uint8_t	dmx_rowBit;						// ISR: 1<<dmx_row.
+
+/*
+ * Get the back buffer to change.
+ * Any swap not yet taken is canceled so the ISR can not show a half written frame.
+ * If keep is true, the back buffer is made a copy of the newest frame for partial updates.
+ */
+static uint8_t* dmx_back( bool keep )
+{
+	uint8_t back;
+	uint8_t i;
+
+	dmx_swap = false;
+	back = dmx_front ^ 1;
+
+	if( keep && (dmx_newest != back) )
+	{
+		// The ISR has taken the newest frame. Start from it.
+		for( i=0; i<8; ++i )
+		{
+			dmx_frame[back][i] = dmx_frame[dmx_front][i];
+		}
+	}
+	dmx_newest = back;
+
+	return dmx_frame[back];
+}
+
+/*
+ * true if the message has one data byte after BITMAP for each bit set in it.
+ */
+static bool dmx_mapOk( uint8_t map )
+{
+	uint8_t count = 0;
+
+	for( ; map != 0; map >>= 1 )
+	{
+		count += map & 0x01;
+	}
+	return ( count == (getMsgData(0) & 0x0F) - 1 );
+}
+
+/*
+ * Send one byte out the SPI. ~16 CPU clocks at fosc/2.
+ */
+static inline void dmx_spi( uint8_t data )
+{
+	SPDR = data;
+	while( !(SPSR & (1<<SPIF)) );
+}
+
+void dev_matrix_init()
+{
+	uint8_t i;
+
+	for( i=0; i<8; ++i )
+	{
+		dmx_frame[0][i] = 0;
+		dmx_frame[1][i] = 0;
+	}
+	dmx_front = 0;
+	dmx_swap = false;
+	dmx_newest = 0;
+	dmx_row = 0;
+	dmx_rowBit = 1;
+
+	DEV_MATRIX_DDR |= (1<<DEV_MATRIX_MOSI)|(1<<DEV_MATRIX_SCK)|(1<<DEV_MATRIX_LATCH);
+
+	// SPI Master, MSB first, mode 0, fosc/2
+	SPCR = (1<<SPE)|(1<<MSTR);
+	SPSR = (1<<SPI2X);
+
+	OCR0B = 30;							// any value below OCR0A.
+	TIMSK0 |= (1<<OCIE0B);
+
+	return;
+}
+
+/*
+ * Turn the display OFF. The frame is kept.
+ * CMD: F0 DEV 01
+ */
+void dev_matrix_off()
+{
+	TIMSK0 &= ~(1<<OCIE0B);
+
+	// All rows off.
+#if DEV_MATRIX_ROW_ON == 0
+	dmx_spi( 0xFF );
+#else
+	dmx_spi( 0x00 );
+#endif
+	dmx_spi( 0x00 );
+	DEV_MATRIX_PORT |= (1<<DEV_MATRIX_LATCH);
+	DEV_MATRIX_PORT &= ~(1<<DEV_MATRIX_LATCH);
+}
+
+/*
+ * Turn the display ON.
+ * CMD: F0 DEV 02
+ */
+void dev_matrix_on()
+{
+	TIMSK0 |= (1<<OCIE0B);
+}
+
+/*
+ * Show an icon from icon_table[]
+ * CMD: E1 DEV 03 INDEX
+ */
+void dev_matrix_icon()
+{
+	uint8_t index = getMsgData(3);
+
+	if( index < ICON_COUNT )
+	{
+		flash_copy8( index, icon_table, dmx_back(false) );
+		dmx_swap = true;
+	}
+}
+
+/*
+ * Show a full frame
+ * CMD: 78 DEV 04 R0 R1 R2 R3 R4 R5 R6 R7
+ */
+void dev_matrix_frame()
+{
+	uint8_t* back = dmx_back(false);
+	uint8_t i;
+
+	for( i=0; i<8; ++i )
+	{
+		back[i] = getMsgData(3+i);
+	}
+	dmx_swap = true;
+}
+
+/*
+ * Replace the rows set in BITMAP. One data byte for each bit set, lowest row first.
+ * Dropped if LEN-1 is not the number of bits set.
+ * CMD: LEN DEV 05 BITMAP Rn ...
+ */
+void dev_matrix_rows()
+{
+	uint8_t* back;
+	uint8_t map = getMsgData(3);
+	uint8_t index = 4;
+	uint8_t row;
+
+	if( !dmx_mapOk(map) )
+		return;
+
+	back = dmx_back(true);
+	for( row=0; row<8; ++row, map >>= 1 )
+	{
+		if( map & 0x01 )
+		{
+			back[row] = getMsgData(index++);
+		}
+	}
+	dmx_swap = true;
+}
+
+/*
+ * Toggle pixels in the rows set in BITMAP. One XOR byte for each bit set, lowest row first.
+ * Dropped if LEN-1 is not the number of bits set.
+ * CMD: LEN DEV 06 BITMAP Xn ...
+ */
+void dev_matrix_xor()
+{
+	uint8_t* back;
+	uint8_t map = getMsgData(3);
+	uint8_t index = 4;
+	uint8_t row;
+
+	if( !dmx_mapOk(map) )
+		return;
+
+	back = dmx_back(true);
+	for( row=0; row<8; ++row, map >>= 1 )
+	{
+		if( map & 0x01 )
+		{
+			back[row] ^= getMsgData(index++);
+		}
+	}
+	dmx_swap = true;
+}
+
+/*
+ * Timer0 Compare B interrupt service.
+ * Called each 1ms. Shows the next row.
+ */
+ISR( TIMER0_COMPB_vect )
+{
+	uint8_t cols;
+
+	if( (dmx_row == 0) && dmx_swap )
+	{
+		dmx_front ^= 1;
+		dmx_swap = false;
+	}
+
+	cols = dmx_frame[dmx_front][dmx_row];
+
+#if DEV_MATRIX_ROW_ON == 0
+	dmx_spi( ~dmx_rowBit );
+#else
+	dmx_spi( dmx_rowBit );
+#endif
+#if DEV_MATRIX_COL_ON == 0
+	dmx_spi( ~cols );
+#else
+	dmx_spi( cols );
+#endif
+	DEV_MATRIX_PORT |= (1<<DEV_MATRIX_LATCH);		// outputs change on the rising edge.
+	DEV_MATRIX_PORT &= ~(1<<DEV_MATRIX_LATCH);
+
+	dmx_rowBit <<= 1;
+	if( ++dmx_row == 8 )
+	{
+		dmx_row = 0;
+		dmx_rowBit = 1;
+	}
+}
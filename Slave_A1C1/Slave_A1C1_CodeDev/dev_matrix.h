@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_matrix.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+
+#ifndef DEV_MATRIX_H_
+#define DEV_MATRIX_H_
+
+// 8x8 LED Matrix
+#define DEV_MATRIX_ID		0x90
+
+/*
+ * Change as needed to match hardware.
+ * The matrix is driven through two 74HC595 shift registers on the SPI pins. The ROW byte is
+ * sent first, then the COLUMN byte, then LATCH is pulsed.
+ *   MOSI PB3 -> SER, SCK PB5 -> SRCLK, PB2 (SS) -> RCLK
+ */
+#define DEV_MATRIX_DDR		DDRB
+#define DEV_MATRIX_PORT		PORTB
+#define DEV_MATRIX_MOSI		PB3
+#define DEV_MATRIX_SCK		PB5
+#define DEV_MATRIX_LATCH	PB2
+
+#define DEV_MATRIX_ROW_ON	0			// level of the active ROW output. 0 for sink drivers.
+#define DEV_MATRIX_COL_ON	1			// level of a lit COLUMN output.
+
+#define CMD_MATRIX_OFF		1
+#define CMD_MATRIX_ON		2
+#define CMD_MATRIX_ICON		3			// INDEX
+#define CMD_MATRIX_FRAME	4			// R0 R1 R2 R3 R4 R5 R6 R7
+#define CMD_MATRIX_ROWS		5			// BITMAP Rn ...	only rows set in BITMAP
+#define CMD_MATRIX_XOR		6			// BITMAP Xn ...	row ^= Xn for rows set in BITMAP
+
+
+void dev_matrix_init();
+void dev_matrix_off();
+void dev_matrix_on();
+void dev_matrix_icon();
+void dev_matrix_frame();
+void dev_matrix_rows();
+void dev_matrix_xor();
+
+#endif /* DEV_MATRIX_H_ */
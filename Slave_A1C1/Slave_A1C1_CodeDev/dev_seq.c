@@ -0,0 +1,416 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_seq.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		SAVE is written one byte per service pass like config.c.
+ *
+ * Pattern Sequencer
+ *
+ * Runs a small byte code program so the Master can upload an LED pattern once instead of
+ * sending a command for every change. Each SET or FADE step is sent to a module through
+ * access_dispatch() using the same LEN MOD CMD DATA format as an I2C message, so any
+ * module in mod_access_table[] can be used.
+ *
+ * The program is kept in SRAM and can be saved to EEPROM. If saved with AUTORUN set, it
+ * is loaded and started after RESET. A SAVE only starts the copy. dev_seq_service() writes
+ * one byte each time the EEPROM is ready, so the main loop is never held for the ~3.4ms of
+ * each byte write, and STATUS reports SEQ_STATE_SAVING until AUTORUN, the last byte, is done.
+ * See dev_seq.h for the op codes.
+ */ 
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <stdbool.h>
+
+#include "sysTimer.h"
+#include "access.h"
+#include "twiSlave.h"
+
+#include "dev_seq.h"
+
+static uint8_t	dsq_prog[SEQ_PROG_SIZE];
+static uint8_t	dsq_state;
+static uint8_t	dsq_pc;
+static uint16_t	dsq_wait;							// 10ms tics left in a WAIT or FADE step.
+
+static uint8_t	dsq_loopPc[SEQ_LOOP_DEPTH];			// address after the LOOP.
+static uint8_t	dsq_loopCount[SEQ_LOOP_DEPTH];		// passes left. 0 = forever.
+static uint8_t	dsq_loopSp;
+
+static uint8_t	dsq_fadeN;							// data bytes before the FADE value.
+static uint8_t	dsq_fadeValue;
+
+static uint8_t	dsq_msg[ACCESS_MSG_BUFF_SIZE];		// LEN MOD CMD DATA for access_dispatch().
+
+static uint8_t	dsq_saveIndex;						// next byte to save. SEQ_PROG_SIZE = AUTORUN.
+static uint8_t	dsq_saveAutorun;
+
+#define DSQ_SAVE_DONE	(SEQ_PROG_SIZE + 1)
+
+static uint8_t EEMEM	dsq_eeProg[SEQ_PROG_SIZE];
+static uint8_t EEMEM	dsq_eeAutorun;
+
+/*
+ * Get a program byte. Reading past the end returns END.
+ */
+static uint8_t dsq_get( uint8_t adrs )
+{
+	if( adrs < SEQ_PROG_SIZE ) {
+		return dsq_prog[adrs];
+	} else {
+		return SEQ_OP_END;
+	}
+}
+
+static void dsq_reset( uint8_t adrs )
+{
+	dsq_pc = adrs;
+	dsq_loopSp = 0;
+	dsq_wait = 0;
+}
+
+/*
+ * Build dsq_msg[] from the N MOD CMD D0..Dn-1 part of a SET or FADE at dsq_pc.
+ * extra is the number of bytes that will be added after D0..Dn-1.
+ * Returns false for a bad N or a command to the sequencer itself.
+ */
+static bool dsq_buildMsg( uint8_t extra )
+{
+	uint8_t n = dsq_get(dsq_pc+1);
+	uint8_t len;
+	uint8_t i;
+
+	if( (n + extra) > 15 )
+		return false;
+	if( dsq_get(dsq_pc+2) == DEV_SEQ_ID )
+		return false;
+
+	len = n + extra;
+	dsq_msg[0] = ((~len) << 4) | len;				// same as Master makeHeader()
+	dsq_msg[1] = dsq_get(dsq_pc+2);
+	dsq_msg[2] = dsq_get(dsq_pc+3);
+	for( i=0; i<n; ++i )
+	{
+		dsq_msg[3+i] = dsq_get(dsq_pc+4+i);
+	}
+	return true;
+}
+
+/*
+ * Send the current fade value and move it one STEP toward TO.
+ * Returns true when TO has been sent.
+ */
+static bool dsq_fadeStep()
+{
+	uint8_t base = dsq_pc + 4 + dsq_fadeN;		// FROM
+	uint8_t to = dsq_get(base+1);
+	uint8_t step = dsq_get(base+2);
+
+	dsq_msg[3+dsq_fadeN] = dsq_fadeValue;
+	if( !access_dispatch(dsq_msg) )
+	{
+		dsq_state = SEQ_STATE_ERROR;
+		return true;
+	}
+
+	if( dsq_fadeValue == to )
+		return true;
+
+	if( step == 0 )
+		step = 1;
+
+	if( dsq_fadeValue < to )
+	{
+		dsq_fadeValue = ( (uint8_t)(to - dsq_fadeValue) > step ) ? dsq_fadeValue + step : to;
+	}
+	else
+	{
+		dsq_fadeValue = ( (uint8_t)(dsq_fadeValue - to) > step ) ? dsq_fadeValue - step : to;
+	}
+
+	dsq_wait = dsq_get(base+3);
+	if( dsq_wait == 0 )
+		dsq_wait = 1;
+
+	return false;
+}
+
+/*
+ * Run one instruction at dsq_pc.
+ */
+static void dsq_exec()
+{
+	uint8_t n;
+
+	switch( dsq_get(dsq_pc) )
+	{
+		case SEQ_OP_SET:
+			if( dsq_buildMsg(0) && access_dispatch(dsq_msg) )
+			{
+				dsq_pc += 4 + dsq_get(dsq_pc+1);
+			}
+			else
+			{
+				dsq_state = SEQ_STATE_ERROR;
+			}
+			break;
+
+		case SEQ_OP_FADE:
+			if( !dsq_buildMsg(1) )
+			{
+				dsq_state = SEQ_STATE_ERROR;
+				break;
+			}
+			dsq_fadeN = dsq_get(dsq_pc+1);
+			dsq_fadeValue = dsq_get(dsq_pc+4+dsq_fadeN);
+			if( dsq_fadeStep() )
+			{
+				if( dsq_state != SEQ_STATE_ERROR )
+					dsq_pc += 8 + dsq_fadeN;
+			}
+			else
+			{
+				dsq_state = SEQ_STATE_FADE;
+			}
+			break;
+
+		case SEQ_OP_WAIT:
+			dsq_wait = dsq_get(dsq_pc+1) | (dsq_get(dsq_pc+2) << 8);
+			dsq_pc += 3;
+			if( dsq_wait != 0 )
+				dsq_state = SEQ_STATE_WAIT;
+			break;
+
+		case SEQ_OP_LOOP:
+			if( dsq_loopSp >= SEQ_LOOP_DEPTH )
+			{
+				dsq_state = SEQ_STATE_ERROR;
+				break;
+			}
+			dsq_loopCount[dsq_loopSp] = dsq_get(dsq_pc+1);
+			dsq_pc += 2;
+			dsq_loopPc[dsq_loopSp] = dsq_pc;
+			++dsq_loopSp;
+			break;
+
+		case SEQ_OP_NEXT:
+			if( dsq_loopSp == 0 )
+			{
+				dsq_state = SEQ_STATE_ERROR;
+				break;
+			}
+			n = dsq_loopSp - 1;
+			if( (dsq_loopCount[n] == 0) || (--dsq_loopCount[n] != 0) )
+			{
+				dsq_pc = dsq_loopPc[n];
+			}
+			else
+			{
+				dsq_loopSp = n;
+				++dsq_pc;
+			}
+			break;
+
+		case SEQ_OP_JUMP:
+			dsq_pc = dsq_get(dsq_pc+1);
+			break;
+
+		case SEQ_OP_END:
+		case 0xFF:
+			dsq_state = SEQ_STATE_STOP;
+			break;
+
+		default:
+			dsq_state = SEQ_STATE_ERROR;
+			break;
+	}
+}
+
+void dev_seq_init()
+{
+	dsq_state = SEQ_STATE_STOP;
+	dsq_reset(0);
+	dsq_saveIndex = DSQ_SAVE_DONE;
+
+	eeprom_read_block( dsq_prog, dsq_eeProg, SEQ_PROG_SIZE );
+	if( eeprom_read_byte(&dsq_eeAutorun) == 1 )
+	{
+		dsq_state = SEQ_STATE_RUN;
+	}
+	return;
+}
+
+/*
+ * Stop the program
+ * CMD: F0 DEV 01
+ */
+void dev_seq_stop()
+{
+	dsq_state = SEQ_STATE_STOP;
+}
+
+/*
+ * Start the program at ADRS
+ * CMD: E1 DEV 02 ADRS
+ */
+void dev_seq_run()
+{
+	dsq_reset( getMsgData(3) );
+	dsq_state = SEQ_STATE_RUN;
+}
+
+/*
+ * Load program bytes starting at ADRS. Stops the program.
+ * CMD: LEN DEV 03 ADRS D0 D1 ...
+ */
+void dev_seq_load()
+{
+	uint8_t adrs = getMsgData(3);
+	uint8_t count = (getMsgData(0) & 0x0F) - 1;		// number of D bytes.
+	uint8_t i;
+
+	dsq_state = SEQ_STATE_STOP;
+
+	// A SAVE under way has to write the new bytes too.
+	if( adrs < dsq_saveIndex )
+		dsq_saveIndex = adrs;
+
+	for( i=0; (i<count) && (adrs<SEQ_PROG_SIZE); ++i, ++adrs )
+	{
+		dsq_prog[adrs] = getMsgData(4+i);
+	}
+}
+
+/*
+ * Save the program to EEPROM. Set AUTORUN to 1 to run it after RESET.
+ * Only starts the save. dev_seq_service() writes it. A SAVE during a save starts it again.
+ * CMD: E1 DEV 04 AUTORUN
+ */
+void dev_seq_save()
+{
+	dsq_saveAutorun = getMsgData(3);
+	dsq_saveIndex = 0;
+}
+
+/*
+ * Reload the program from EEPROM. Stops the program.
+ * During a save SRAM already holds what is being written, so it is kept.
+ * CMD: F0 DEV 05
+ */
+void dev_seq_restore()
+{
+	dsq_state = SEQ_STATE_STOP;
+	if( dsq_saveIndex == DSQ_SAVE_DONE )
+	{
+		eeprom_read_block( dsq_prog, dsq_eeProg, SEQ_PROG_SIZE );
+	}
+}
+
+/*
+ * Report state
+ * CMD: F0 DEV 06
+ * Returns: STATE PC
+ *   STATE has SEQ_STATE_SAVING set until a SAVE is written.
+ */
+void dev_seq_status()
+{
+	if( dsq_saveIndex != DSQ_SAVE_DONE ) {
+		twiTransmitByte( dsq_state | SEQ_STATE_SAVING );
+	} else {
+		twiTransmitByte( dsq_state );
+	}
+	twiTransmitByte( dsq_pc );
+}
+
+/*
+ * Write the next byte of a SAVE when the EEPROM is ready.
+ */
+static void dsq_saveByte()
+{
+	if( dsq_saveIndex == DSQ_SAVE_DONE )
+		return;
+	if( EECR & (1<<EEPE) )
+		return;								// EEPROM busy.
+
+	if( dsq_saveIndex < SEQ_PROG_SIZE ) {
+		eeprom_update_byte( &dsq_eeProg[dsq_saveIndex], dsq_prog[dsq_saveIndex] );
+	} else {
+		eeprom_update_byte( &dsq_eeAutorun, dsq_saveAutorun );
+	}
+	++dsq_saveIndex;
+}
+
+/*
+ * Called continuously.
+ * Writes one byte of a SAVE, then runs up to SEQ_MAX_STEPS instructions per call so a program without a WAIT can not
+ * stall the other services.
+ */
+void dev_seq_service()
+{
+	uint8_t steps;
+	bool tic = false;
+
+	dsq_saveByte();
+
+	if( GPIOR0 & (1<<SEQ_10MS_TIC) )
+	{
+		GPIOR0 &= ~(1<<SEQ_10MS_TIC);
+		tic = true;
+	}
+
+	switch( dsq_state )
+	{
+		case SEQ_STATE_WAIT:
+			if( !tic || (--dsq_wait != 0) )
+				return;
+			dsq_state = SEQ_STATE_RUN;
+			break;
+
+		case SEQ_STATE_FADE:
+			if( !tic || (--dsq_wait != 0) )
+				return;
+			if( dsq_fadeStep() )
+			{
+				if( dsq_state == SEQ_STATE_ERROR )
+					return;
+				dsq_pc += 8 + dsq_fadeN;
+				dsq_state = SEQ_STATE_RUN;
+			}
+			break;
+
+		case SEQ_STATE_RUN:
+			break;
+
+		default:
+			return;
+	}
+
+	for( steps=0; (steps<SEQ_MAX_STEPS) && (dsq_state == SEQ_STATE_RUN); ++steps )
+	{
+		dsq_exec();
+	}
+}
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_seq.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * revision: 10/17/2026	0.02	ndp		SAVE is written one byte per service pass. STATUS shows it.
+ */ 
+
+
+#ifndef DEV_SEQ_H_
+#define DEV_SEQ_H_
+
+// Pattern Sequencer
+#define DEV_SEQ_ID			0x50
+
+#define SEQ_PROG_SIZE		64			// bytes of program space in SRAM and EEPROM.
+#define SEQ_LOOP_DEPTH		4			// nested LOOP/NEXT levels.
+#define SEQ_MAX_STEPS		8			// instructions run per service call without a WAIT.
+
+/*
+ * Op codes
+ *   END                                         Stop. 0xFF (erased EEPROM) is also END.
+ *   SET   N MOD CMD D0..Dn-1                    Run MOD CMD with N (0:14) data bytes.
+ *   FADE  N MOD CMD D0..Dn-1 FROM TO STEP TICS  Run MOD CMD D0..Dn-1 VALUE for VALUE = FROM to TO
+ *                                               changing by STEP every TICS x 10ms.
+ *   WAIT  TICS_L TICS_H                         Wait TICS x 10ms.
+ *   LOOP  COUNT                                 Repeat the code up to NEXT COUNT times.
+ *   NEXT                                        End of LOOP.
+ *   JUMP  ADRS                                  Continue at program address ADRS.
+ */
+#define SEQ_OP_END			0x00
+#define SEQ_OP_SET			0x01
+#define SEQ_OP_FADE			0x02
+#define SEQ_OP_WAIT			0x03
+#define SEQ_OP_LOOP			0x04
+#define SEQ_OP_NEXT			0x05
+#define SEQ_OP_JUMP			0x06
+
+#define CMD_SEQ_STOP		1
+#define CMD_SEQ_RUN			2			// ADRS
+#define CMD_SEQ_LOAD		3			// ADRS D0 D1 ... up to 14 bytes
+#define CMD_SEQ_SAVE		4			// AUTORUN(0:1)
+#define CMD_SEQ_RESTORE		5
+#define CMD_SEQ_STATUS		6			// returns STATE PC. STATE has SEQ_STATE_SAVING set during a SAVE.
+
+// Status STATE values
+#define SEQ_STATE_STOP		0
+#define SEQ_STATE_RUN		1
+#define SEQ_STATE_WAIT		2
+#define SEQ_STATE_FADE		3
+#define SEQ_STATE_ERROR		4
+#define SEQ_STATE_SAVING	0x80		// flag. A SAVE is still being written to EEPROM.
+
+
+void dev_seq_init();
+void dev_seq_stop();
+void dev_seq_run();
+void dev_seq_load();
+void dev_seq_save();
+void dev_seq_restore();
+void dev_seq_status();
+
+void dev_seq_service();
+
+#endif /* DEV_SEQ_H_ */
@@ -0,0 +1,237 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_sonar.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ * revision: 10/17/2026		0.02	ndp		F_CPU only when the build does not set it.
+ *
+ * Sonar Ranging
+ *
+ * Uses the Timer2 cm counter from sysTimer.c. Each sensor gets a DEV_SONAR_SLOT ms time slot.
+ * At the start of its slot the sensor is triggered. The Pin Change interrupt clears the cm
+ * counter on the rising edge of ECHO and saves the count on the falling edge.
+ * At the end of the slot the reading is filtered with a median of the last three so one bad
+ * echo does not show up in the output. The Master reads the latest values at any time
+ * without waiting for a measurement.
+ */ 
+
+#ifndef F_CPU
+#  define F_CPU	8000000UL					// for _delay_us(). Builds that set -DF_CPU keep theirs.
+#endif
+
+#include <avr/io.h>
+#include <stdbool.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+
+#include "sysTimer.h"
+#include "twiSlave.h"
+
+#include "dev_sonar.h"
+
+static bool		dso_run;
+static uint8_t	dso_sensor;						// sensor in the current slot.
+static uint8_t	dso_slotTime;					// ms left in the slot.
+
+static uint8_t	dso_raw[DEV_SONAR_COUNT][3];	// last three readings. [0] is newest.
+static uint8_t	dso_dist[DEV_SONAR_COUNT];		// filtered cm.
+
+static volatile bool	dso_echoStarted;
+static volatile bool	dso_echoDone;
+static volatile uint8_t	dso_echo;				// cm count at the falling edge.
+
+/*
+ * Median of three.
+ */
+static uint8_t dso_median( uint8_t a, uint8_t b, uint8_t c )
+{
+	if( a > b ) {
+		if( b > c )
+			return b;
+		return ( a > c ) ? c : a;
+	} else {
+		if( a > c )
+			return a;
+		return ( b > c ) ? c : b;
+	}
+}
+
+/*
+ * Start a measurement on dso_sensor.
+ */
+static void dso_trigger()
+{
+	dso_echoStarted = false;
+	dso_echoDone = false;
+	DEV_SONAR_PCMSK = (1<<(DEV_SONAR_ECHO0 + dso_sensor));
+
+	DEV_SONAR_TRIG_PORT |= (1<<(DEV_SONAR_TRIG0 + dso_sensor));
+	_delay_us(10);
+	DEV_SONAR_TRIG_PORT &= ~(1<<(DEV_SONAR_TRIG0 + dso_sensor));
+}
+
+/*
+ * Save the reading for dso_sensor and update its filtered value.
+ */
+static void dso_save()
+{
+	uint8_t* raw = dso_raw[dso_sensor];
+
+	DEV_SONAR_PCMSK = 0;
+
+	raw[2] = raw[1];
+	raw[1] = raw[0];
+	raw[0] = dso_echoDone ? dso_echo : DEV_SONAR_NO_ECHO;
+
+	dso_dist[dso_sensor] = dso_median( raw[0], raw[1], raw[2] );
+}
+
+void dev_sonar_init()
+{
+	uint8_t i;
+
+	for( i=0; i<DEV_SONAR_COUNT; ++i )
+	{
+		DEV_SONAR_TRIG_DDR |= (1<<(DEV_SONAR_TRIG0 + i));		// TRIG output LOW. ECHO stays input.
+		dso_raw[i][0] = DEV_SONAR_NO_ECHO;
+		dso_raw[i][1] = DEV_SONAR_NO_ECHO;
+		dso_raw[i][2] = DEV_SONAR_NO_ECHO;
+		dso_dist[i] = DEV_SONAR_NO_ECHO;
+	}
+
+	dso_run = false;
+	dso_sensor = 0;
+	dso_slotTime = 0;
+
+	DEV_SONAR_PCMSK = 0;
+	PCICR |= (1<<DEV_SONAR_PCIE);
+
+	st_init_tmr2();
+	return;
+}
+
+/*
+ * Stop ranging. The last values can still be read.
+ * CMD: F0 DEV 01
+ */
+void dev_sonar_stop()
+{
+	dso_run = false;
+	DEV_SONAR_PCMSK = 0;
+}
+
+/*
+ * Start ranging all sensors in turn.
+ * CMD: F0 DEV 02
+ */
+void dev_sonar_start()
+{
+	if( !dso_run )
+	{
+		dso_sensor = 0;
+		dso_slotTime = 0;						// trigger on the next tic.
+		dso_run = true;
+	}
+}
+
+/*
+ * Read filtered distances
+ * CMD: F0 DEV 03
+ * Returns: one cm byte for each sensor. 255 = no echo.
+ */
+void dev_sonar_read()
+{
+	uint8_t i;
+
+	for( i=0; i<DEV_SONAR_COUNT; ++i )
+	{
+		twiTransmitByte( dso_dist[i] );
+	}
+}
+
+/*
+ * Read the newest unfiltered distances
+ * CMD: F0 DEV 04
+ */
+void dev_sonar_readRaw()
+{
+	uint8_t i;
+
+	for( i=0; i<DEV_SONAR_COUNT; ++i )
+	{
+		twiTransmitByte( dso_raw[i][0] );
+	}
+}
+
+/*
+ * Called continuously.
+ * Runs the sensor time slots on the 1ms tic.
+ */
+void dev_sonar_service()
+{
+	if( GPIOR0 & (1<<SONAR_1MS_TIC) )
+	{
+		GPIOR0 &= ~(1<<SONAR_1MS_TIC);
+
+		if( !dso_run )
+			return;
+
+		if( dso_slotTime != 0 )
+		{
+			if( --dso_slotTime != 0 )
+				return;
+
+			// End of slot. Save and move to the next sensor.
+			dso_save();
+			if( ++dso_sensor >= DEV_SONAR_COUNT )
+				dso_sensor = 0;
+		}
+
+		dso_trigger();
+		dso_slotTime = DEV_SONAR_SLOT;
+	}
+}
+
+/*
+ * Pin Change interrupt service for the ECHO pins.
+ * Only the ECHO pin of the sensor being measured is enabled.
+ */
+ISR( DEV_SONAR_PCINT_vect )
+{
+	if( DEV_SONAR_ECHO_PIN & (1<<(DEV_SONAR_ECHO0 + dso_sensor)) )
+	{
+		// Rising edge. Start counting.
+		st_tmr2_clr();
+		tmr2_clrCount();
+		dso_echoStarted = true;
+	}
+	else if( dso_echoStarted )
+	{
+		// Falling edge. 1 count per cm.
+		dso_echo = tmr2_getCount();
+		dso_echoDone = true;
+		DEV_SONAR_PCMSK = 0;
+	}
+}
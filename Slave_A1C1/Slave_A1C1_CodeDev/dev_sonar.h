@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * dev_sonar.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ */ 
+
+
+#ifndef DEV_SONAR_H_
+#define DEV_SONAR_H_
+
+// Sonar Ranging (HC-SR04 style)
+#define DEV_SONAR_ID		0x80
+
+// Change as needed to match hardware.
+// Sensor N uses TRIG bit DEV_SONAR_TRIG0+N and ECHO bit DEV_SONAR_ECHO0+N.
+#define DEV_SONAR_COUNT		2
+
+#define DEV_SONAR_TRIG_DDR	DDRD
+#define DEV_SONAR_TRIG_PORT	PORTD
+#define DEV_SONAR_TRIG0		PD2
+
+#define DEV_SONAR_ECHO_PIN	PIND
+#define DEV_SONAR_ECHO0		PD4
+#define DEV_SONAR_PCMSK		PCMSK2		// Pin Change mask and enable for the ECHO port.
+#define DEV_SONAR_PCIE		PCIE2
+#define DEV_SONAR_PCINT_vect	PCINT2_vect
+
+#define DEV_SONAR_SLOT		50			// ms per sensor. Allows ~4m of echo time plus settling.
+#define DEV_SONAR_NO_ECHO	255			// cm value for no echo or out of range.
+
+#define CMD_SONAR_STOP		1
+#define CMD_SONAR_START		2
+#define CMD_SONAR_READ		3			// Returns filtered cm for each sensor.
+#define CMD_SONAR_READ_RAW	4			// Returns last raw cm for each sensor.
+
+
+void dev_sonar_init();
+void dev_sonar_stop();
+void dev_sonar_start();
+void dev_sonar_read();
+void dev_sonar_readRaw();
+
+void dev_sonar_service();
+
+#endif /* DEV_SONAR_H_ */
@@ -27,6 +27,7 @@
  *  Author: Chip
  *
  * revision: 01/13/2016	0.02	ndp		Add copy table to SRAM.
+ * revision: 10/17/2026	0.03	ndp		Return a function pointer from flash_get_access_func().
  */ 
 
 
@@ -39,7 +40,7 @@ uint8_t flash_get_mod_access_id(uint8_t index);
 MOD_FUNCTION_ENTRY* flash_get_mod_function_table(uint8_t index);
 
 uint16_t flash_get_access_cmd(uint8_t index, MOD_FUNCTION_ENTRY* table);
-uint16_t flash_get_access_func(uint8_t index, MOD_FUNCTION_ENTRY* table);
+void (*flash_get_access_func(uint8_t index, MOD_FUNCTION_ENTRY* table))();
 
 void flash_copy8(uint16_t index, const ICON_DATA* table, uint8_t* sram);
 
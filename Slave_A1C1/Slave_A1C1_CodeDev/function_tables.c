@@ -26,6 +26,19 @@
  * org: 08/08/2015					0.01	ndp
  * author: Nels "Chip" Pearson
  * revision: 02/23/2016				0.02	ndp		A1C1 mods
+ * revision: 10/17/2026				0.03	ndp		add dev_led_bam
+ * revision: 10/17/2026				0.04	ndp		add dev_seq
+ * revision: 10/17/2026				0.05	ndp		add dev_gpio
+ * revision: 10/17/2026				0.06	ndp		add dev_led_1 timed modes and service
+ * revision: 10/17/2026				0.07	ndp		add dev_adc
+ * revision: 10/17/2026				0.08	ndp		add dev_sonar. USE_ switches for Timer2 users.
+ * revision: 10/17/2026				0.09	ndp		add dev_matrix and icon_table
+ * revision: 10/17/2026				0.10	ndp		add dev_matrix ROWS and XOR
+ * revision: 10/17/2026				0.11	ndp		add config store service and access
+ * revision: 10/17/2026				0.12	ndp		add I2C address assignment access
+ * revision: 10/17/2026				0.13	ndp		add system start up status and profile
+ * revision: 10/17/2026				0.14	ndp		add system RESET to bootloader
+ * revision: 10/17/2026				0.15	ndp		USE_ switches moved to function_tables.h for dev_gpio.
  *
  * Dependent on:
  *	module function files
@@ -39,6 +52,16 @@
 // Device prototypes
 #include "dev_led_1.h"
 #include "dev_led_pwm.h"
+#include "dev_led_bam.h"
+#include "dev_seq.h"
+#include "dev_gpio.h"
+#include "dev_adc.h"
+#include "dev_sonar.h"
+#include "dev_matrix.h"
+#include "initialize.h"
+#include "i2c_address.h"
+#include "config.h"
+#include "function_tables.h"
 
 
 /* *** Call Tables for INIT, SERVICE, and ACCESS *** */
@@ -55,6 +78,16 @@ const MOD_FUNCTION_ENTRY mod_init_table[] PROGMEM =
 {
 	{ DEV_LED_1_ID, dev_led_1_init },
 	{ DEV_LED_PWM_ID, dev_led_pwm_init },
+#if USE_DEV_LED_BAM
+	{ DEV_LED_BAM_ID, dev_led_bam_init },
+#endif
+	{ DEV_SEQ_ID, dev_seq_init },
+	{ DEV_GPIO_ID, dev_gpio_init },
+	{ DEV_ADC_ID, dev_adc_init },
+#if USE_DEV_SONAR
+	{ DEV_SONAR_ID, dev_sonar_init },
+#endif
+	{ DEV_MATRIX_ID, dev_matrix_init },
 	{ 0, 0}
 };
 
@@ -63,8 +96,16 @@ const MOD_FUNCTION_ENTRY mod_init_table[] PROGMEM =
  */
 const MOD_FUNCTION_ENTRY mod_service_table[] PROGMEM =
 {
-	// No LED service
+	{ DEV_LED_1_ID, dev_led_1_service },
 	{ DEV_LED_PWM_ID, dev_led_pwm_service },
+#if USE_DEV_LED_BAM
+	{ DEV_LED_BAM_ID, dev_led_bam_service },
+#endif
+	{ DEV_SEQ_ID, dev_seq_service },
+#if USE_DEV_SONAR
+	{ DEV_SONAR_ID, dev_sonar_service },
+#endif
+	{ CONFIG_ID, cfg_service },
 	{ 0, 0}
 };
 
@@ -77,6 +118,9 @@ const MOD_FUNCTION_ENTRY dev_led_1_access[] PROGMEM =
 {
 	{ CMD_LED_OFF, dev_led_1_off },
 	{ CMD_LED_ON, dev_led_1_on },
+	{ CMD_LED_BLINK, dev_led_1_blink },
+	{ CMD_LED_PULSE, dev_led_1_pulse },
+	{ CMD_LED_ONESHOT, dev_led_1_oneShot },
 	{ 0, 0 }
 };
 
@@ -93,6 +137,142 @@ const MOD_FUNCTION_ENTRY dev_led_pwm_access[] PROGMEM =
 	{ 0, 0 }
 };
 
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+#if USE_DEV_LED_BAM
+const MOD_FUNCTION_ENTRY dev_led_bam_access[] PROGMEM =
+{
+	{ CMD_LED_BAM_OFF, dev_led_bam_off },
+	{ CMD_LED_BAM_ON, dev_led_bam_on },
+	{ CMD_LED_BAM_SET, dev_led_bam_set },
+	{ CMD_LED_BAM_SET_ALL, dev_led_bam_setAll },
+	{ 0, 0 }
+};
+#endif
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY dev_seq_access[] PROGMEM =
+{
+	{ CMD_SEQ_STOP, dev_seq_stop },
+	{ CMD_SEQ_RUN, dev_seq_run },
+	{ CMD_SEQ_LOAD, dev_seq_load },
+	{ CMD_SEQ_SAVE, dev_seq_save },
+	{ CMD_SEQ_RESTORE, dev_seq_restore },
+	{ CMD_SEQ_STATUS, dev_seq_status },
+	{ 0, 0 }
+};
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY dev_gpio_access[] PROGMEM =
+{
+	{ CMD_GPIO_SET, dev_gpio_set },
+	{ CMD_GPIO_CLEAR, dev_gpio_clear },
+	{ CMD_GPIO_TOGGLE, dev_gpio_toggle },
+	{ CMD_GPIO_OUTPUT, dev_gpio_output },
+	{ CMD_GPIO_INPUT, dev_gpio_input },
+	{ CMD_GPIO_WRITE, dev_gpio_write },
+	{ CMD_GPIO_READ, dev_gpio_read },
+	{ 0, 0 }
+};
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY dev_adc_access[] PROGMEM =
+{
+	{ CMD_ADC_STOP, dev_adc_stop },
+	{ CMD_ADC_START, dev_adc_start },
+	{ CMD_ADC_CONFIG, dev_adc_config },
+	{ CMD_ADC_READ, dev_adc_read },
+	{ CMD_ADC_STATUS, dev_adc_status },
+	{ 0, 0 }
+};
+
+#if USE_DEV_SONAR
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY dev_sonar_access[] PROGMEM =
+{
+	{ CMD_SONAR_STOP, dev_sonar_stop },
+	{ CMD_SONAR_START, dev_sonar_start },
+	{ CMD_SONAR_READ, dev_sonar_read },
+	{ CMD_SONAR_READ_RAW, dev_sonar_readRaw },
+	{ 0, 0 }
+};
+#endif
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY dev_matrix_access[] PROGMEM =
+{
+	{ CMD_MATRIX_OFF, dev_matrix_off },
+	{ CMD_MATRIX_ON, dev_matrix_on },
+	{ CMD_MATRIX_ICON, dev_matrix_icon },
+	{ CMD_MATRIX_FRAME, dev_matrix_frame },
+	{ CMD_MATRIX_ROWS, dev_matrix_rows },
+	{ CMD_MATRIX_XOR, dev_matrix_xor },
+	{ 0, 0 }
+};
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY config_access[] PROGMEM =
+{
+	{ CMD_CFG_GET, cfg_cmdGet },
+	{ CMD_CFG_SET, cfg_cmdSet },
+	{ CMD_CFG_STATUS, cfg_cmdStatus },
+	{ 0, 0 }
+};
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY ia_access[] PROGMEM =
+{
+	{ CMD_IA_RESET, ia_reset },
+	{ CMD_IA_PREFIX, ia_prefix },
+	{ CMD_IA_ASSIGN, ia_assign },
+	{ CMD_IA_UID, ia_uid },
+	{ 0, 0 }
+};
+
+/*
+ * Used by access.c :: access_all() for access functions specific to this device.
+ * Returned by mod_access_table[] for access functions specific to this device.
+ * NOTE: This array has to be before the access table.
+ */
+const MOD_FUNCTION_ENTRY init_access[] PROGMEM =
+{
+	{ CMD_INIT_STATUS, init_status },
+	{ CMD_INIT_PROFILE, init_profile },
+	{ CMD_INIT_BOOT, init_boot },
+	{ 0, 0 }
+};
+
 /*
  * Used by access.c :: access_all()
  */
@@ -100,5 +280,18 @@ const MOD_ACCESS_ENTRY mod_access_table[] PROGMEM =
 {
 	{ DEV_LED_1_ID, dev_led_1_access },			// table to all functions supported by dev_led_1.
 	{ DEV_LED_PWM_ID, dev_led_pwm_access },		// table to all functions supported by dev_led_pwm.
+#if USE_DEV_LED_BAM
+	{ DEV_LED_BAM_ID, dev_led_bam_access },		// table to all functions supported by dev_led_bam.
+#endif
+	{ DEV_SEQ_ID, dev_seq_access },		// table to all functions supported by dev_seq.
+	{ DEV_GPIO_ID, dev_gpio_access },		// table to all functions supported by dev_gpio.
+	{ DEV_ADC_ID, dev_adc_access },		// table to all functions supported by dev_adc.
+#if USE_DEV_SONAR
+	{ DEV_SONAR_ID, dev_sonar_access },		// table to all functions supported by dev_sonar.
+#endif
+	{ DEV_MATRIX_ID, dev_matrix_access },		// table to all functions supported by dev_matrix.
+	{ CONFIG_ID, config_access },			// table to all functions supported by config.
+	{ I2C_ADRS_ID, ia_access },			// table to all functions supported by i2c_address.
+	{ INIT_ID, init_access },		// table to all functions supported by init.
 	{ 0, 0 }
 };
@@ -26,6 +26,7 @@
  * Created: 8/08/2015	0.01	ndp
  *  Author: Chip
  *
+ * revision: 10/17/2026	0.02	ndp		USE_ switches here so dev_gpio can see them.
  */ 
 
 
@@ -35,6 +36,17 @@
 #include "sysdefs.h"
 // MOD_FUNCTION_ENTRY,
 
+/*
+ * Timer2 is used by dev_led_bam for the BAM slots and by dev_sonar for the cm counter.
+ * Only one of them can be used. Set to 1 to put the module into the tables.
+ */
+#define USE_DEV_LED_BAM		1
+#define USE_DEV_SONAR		0
+
+#if USE_DEV_LED_BAM && USE_DEV_SONAR
+#  error dev_led_bam and dev_sonar both use Timer2
+#endif
+
 extern const MOD_FUNCTION_ENTRY mod_init_table[];
 extern const MOD_FUNCTION_ENTRY mod_service_table[];
 extern const MOD_ACCESS_ENTRY mod_access_table[];
@@ -1,18 +1,18 @@
 /*
  * The MIT License (MIT)
- *
+ * 
  * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
- *
+ * 
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
  * in the Software without restriction, including without limitation the rights
  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
  * copies of the Software, and to permit persons to whom the Software is
  * furnished to do so, subject to the following conditions:
- *
+ * 
  * The above copyright notice and this permission notice shall be included in all
  * copies or substantial portions of the Software.
- *
+ * 
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
@@ -26,13 +26,30 @@
  * Created: 1/17/2016	0.01	ndp
  *  Author: Chip
  * revised: 2/23/2016	0.02	ndp		add conditional compile
+ * revised: 10/17/2026	0.03	ndp		add address assignment. Use the saved address if there is one.
  *
  * This module supports external jumpers to adjust the I2C address.
+ *
+ * It also lets a Master give each node its own address at run time, so a bus of identical
+ * nodes does not need a build or jumpers for each node. This works like SMBus ARP:
+ *   Each node has a 4 byte unique ID (UID) in EEPROM.
+ *   Nodes without an address all answer at SLAVE_ADRS.
+ *   The Master sends PREFIX to the General Call address and reads 8 bytes from SLAVE_ADRS.
+ *   All nodes that match send their UID bytes and the complements at the same time. SDA is
+ *   wired-AND, so a bit where both the UID and complement read 0 shows nodes that differ.
+ *   The Master adds that bit to the prefix and tries again, one bit at a time, until only one
+ *   node answers. Then it sends ASSIGN with that UID. This is the same search as 1-Wire.
+ * The assigned address is kept in the configuration store and used by twiSlaveInit() after RESET.
  */ 
 
 #include <avr/io.h>
+#include <avr/eeprom.h>
+#include <stdbool.h>
 
 #include "i2c_address.h"
+#include "access.h"
+#include "config.h"
+#include "twiSlave.h"
 
 // Change as needed to match hardware.
 #define I2C_ADRS_DDR	DDRC
@@ -44,15 +61,94 @@
 #define I2C_ADRS_D2		PORTC2
 #define I2C_ADRS_D3		PORTC3
 
+// Program a unique value into each node's .eep file. If it is erased one is made at RESET.
+uint8_t EEMEM	ia_eeUid[IA_UID_SIZE];
+
+static uint8_t	ia_uidCopy[IA_UID_SIZE];
+static bool		ia_assigned;
+
+/*
+ * Load the UID. If the EEPROM is erased, make one from ADC noise and Timer0 jitter and save it.
+ * NOTE: This is a weak random number. A programmed UID is better.
+ */
+static void ia_loadUid()
+{
+	uint8_t i;
+	uint8_t erased = 0xFF;
+	uint8_t mix;
+
+	for( i=0; i<IA_UID_SIZE; ++i )
+	{
+		ia_uidCopy[i] = eeprom_read_byte( &ia_eeUid[i] );
+		erased &= ia_uidCopy[i];
+	}
+	if( erased != 0xFF )
+		return;
+
+	// ADC on the 1.1V band gap, CPU div 2 for the most noise.
+	ADMUX = (1<<REFS0)|0x0E;
+	ADCSRA = (1<<ADEN);
+	mix = 0;
+	for( i=0; i<(IA_UID_SIZE*8); ++i )
+	{
+		ADCSRA |= (1<<ADSC);
+		while( ADCSRA & (1<<ADSC) );
+		mix = (mix << 1) | (mix >> 7);
+		mix ^= ADCL ^ TCNT0;
+		(void)ADCH;
+		ia_uidCopy[i & (IA_UID_SIZE-1)] ^= mix;
+	}
+	ADCSRA = 0;
+
+	eeprom_update_block( ia_uidCopy, ia_eeUid, IA_UID_SIZE );
+}
+
+/*
+ * true if the first n bits of the UID (MSB of U0 first) match prefix.
+ */
+static bool ia_match( uint8_t n, uint8_t index )
+{
+	uint8_t i;
+	uint8_t mask;
+
+	for( i=0; (i<IA_UID_SIZE) && (n!=0); ++i, ++index )
+	{
+		mask = ( n >= 8 ) ? 0xFF : (uint8_t)(0xFF << (8 - n));
+		if( (ia_uidCopy[i] ^ getMsgData(index)) & mask )
+			return false;
+		n = ( n >= 8 ) ? n - 8 : 0;
+	}
+	return true;
+}
+
+/*
+ * Change to a new address now.
+ */
+static void ia_setAddress( uint8_t adrs )
+{
+	twiSlaveInit( adrs );
+	twiSlaveEnable();
+}
 
 /*
  * This function returns the I2C address modified by the jumpers.
+ * An address given by ASSIGN is used first. cfg_init() has to be called before this.
  */
 uint8_t ia_getAddress()
 {
-#if 0
 	uint8_t adrs;
-	
+
+	ia_loadUid();
+
+	adrs = cfg_get( CFG_KEY_I2C_ADRS, 0 );
+	if( (adrs >= 0x08) && (adrs <= 0x77) )
+	{
+		ia_assigned = true;
+		return( adrs );
+	}
+	ia_assigned = false;
+
+#if 0
 	// Default is INPUT
 	// Set Pull-Ups and wait for a bit to stabilize
 	for(adrs = 0; adrs<20; ++adrs)
@@ -68,8 +164,83 @@ uint8_t ia_getAddress()
 	//  Mask to match pins used.
 	adrs &= (1<<I2C_ADRS_D3)|(1<<I2C_ADRS_D2)|(1<<I2C_ADRS_D1)|(1<<I2C_ADRS_D0);
 		
-	return( SLAVE_ADRS + adrs );	// TODO: Pull this from EEPROM someday.
+	return( SLAVE_ADRS + adrs );
 #else
 	return( SLAVE_ADRS );	// No jumpers, just return base.
 #endif
 }
+
+/*
+ * Forget the assigned address.
+ * CMD: F0 DEV 01		(General Call)
+ */
+void ia_reset()
+{
+	cfg_set( CFG_KEY_I2C_ADRS, 0 );
+	if( ia_assigned )
+	{
+		ia_assigned = false;
+		ia_setAddress( SLAVE_ADRS );
+	}
+}
+
+/*
+ * Load the search reply.
+ * CMD: A5 DEV 02 N P0 P1 P2 P3		(General Call)
+ */
+void ia_prefix()
+{
+	uint8_t i;
+	bool match;
+
+	if( ia_assigned )
+		return;
+
+	match = ia_match( getMsgData(3), 4 );
+
+	twiClearOutput();
+	for( i=0; i<IA_UID_SIZE; ++i )
+	{
+		if( match ) {
+			twiTransmitByte( ia_uidCopy[i] );
+			twiTransmitByte( ~ia_uidCopy[i] );
+		} else {
+			twiTransmitByte( 0xFF );
+			twiTransmitByte( 0xFF );
+		}
+	}
+}
+
+/*
+ * Take ADRS if the UID matches.
+ * CMD: A5 DEV 03 U0 U1 U2 U3 ADRS		(General Call)
+ */
+void ia_assign()
+{
+	uint8_t adrs = getMsgData(7);
+
+	if( !ia_match( IA_UID_SIZE*8, 3 ) )
+		return;
+	if( (adrs < 0x08) || (adrs > 0x77) )
+		return;
+
+	twiClearOutput();					// drop any search reply.
+	cfg_set( CFG_KEY_I2C_ADRS, adrs );
+	ia_assigned = true;
+	ia_setAddress( adrs );
+}
+
+/*
+ * Report the UID
+ * CMD: F0 DEV 04
+ * Returns: U0 U1 U2 U3
+ */
+void ia_uid()
+{
+	uint8_t i;
+
+	for( i=0; i<IA_UID_SIZE; ++i )
+	{
+		twiTransmitByte( ia_uidCopy[i] );
+	}
+}
@@ -1,18 +1,18 @@
 /*
  * The MIT License (MIT)
- *
+ * 
  * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
- *
+ * 
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
  * in the Software without restriction, including without limitation the rights
  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
  * copies of the Software, and to permit persons to whom the Software is
  * furnished to do so, subject to the following conditions:
- *
+ * 
  * The above copyright notice and this permission notice shall be included in all
  * copies or substantial portions of the Software.
- *
+ * 
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
@@ -25,14 +25,40 @@
  *
  * Created: 1/17/2016 10:07:57 AM
  *  Author: Chip
+ * revised: 10/17/2026	0.03	ndp		add address assignment commands.
  */ 
 
 
 #ifndef I2C_ADDRESS_H_
 #define I2C_ADDRESS_H_
 
-#define SLAVE_ADRS	0x40
+#define SLAVE_ADRS	0x40		// Default address. Also the shared address used for assignment.
+
+// I2C Address Assignment
+#define I2C_ADRS_ID			0xB0
+
+#define IA_UID_SIZE			4
+
+/*
+ * Sent to the General Call address (0x00) so all nodes get them.
+ *   RESET    Forget the assigned address and go back to SLAVE_ADRS.
+ *   PREFIX   Nodes at SLAVE_ADRS whose UID starts with the first N bits of P0:3 load
+ *            U0 ~U0 U1 ~U1 U2 ~U2 U3 ~U3 to be read from SLAVE_ADRS. All other nodes at
+ *            SLAVE_ADRS load 0xFF so they do not pull SDA low.
+ *   ASSIGN   The node with UID U0:3 moves to ADRS and saves it.
+ * Sent to one node.
+ *   UID      Returns U0 U1 U2 U3.
+ */
+#define CMD_IA_RESET		1
+#define CMD_IA_PREFIX		2			// N P0 P1 P2 P3
+#define CMD_IA_ASSIGN		3			// U0 U1 U2 U3 ADRS
+#define CMD_IA_UID			4			// Returns U0 U1 U2 U3
 
 uint8_t ia_getAddress();
 
-#endif /* I2C_ADDRESS_H_ */
\ No newline at end of file
+void ia_reset();
+void ia_prefix();
+void ia_assign();
+void ia_uid();
+
+#endif /* I2C_ADDRESS_H_ */
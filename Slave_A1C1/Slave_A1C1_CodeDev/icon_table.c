@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * icon_table.c
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * 8x8 icon images in FLASH for dev_matrix. Copied to SRAM with flash_copy8().
+ * Each entry is 8 rows, top row first. b7 is the left column.
+ */ 
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include "icon_table.h"
+
+const ICON_DATA icon_table[] PROGMEM =
+{
+	// ICON_BLANK
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	// ICON_FULL
+	{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+	// ICON_SMILE
+	{ 0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99, 0x42, 0x3C },
+	// ICON_FROWN
+	{ 0x3C, 0x42, 0xA5, 0x81, 0x99, 0xA5, 0x42, 0x3C },
+	// ICON_HEART
+	{ 0x00, 0x66, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C, 0x18 },
+	// ICON_ARROW_UP
+	{ 0x18, 0x3C, 0x7E, 0xDB, 0x18, 0x18, 0x18, 0x18 },
+	// ICON_ARROW_DOWN
+	{ 0x18, 0x18, 0x18, 0x18, 0xDB, 0x7E, 0x3C, 0x18 },
+	// ICON_CHECK
+	{ 0x00, 0x01, 0x03, 0x06, 0x8C, 0xD8, 0x70, 0x20 }
+};
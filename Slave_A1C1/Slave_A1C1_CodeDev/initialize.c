@@ -28,11 +28,28 @@
  *
  * revision: 1/13/2016	0.02	ndp		add ATmega48P -> 328P reset code.
  * revision: 1/17/2016	0.03	ndp		get SLAVE_ADRS from ia_getAddress()
+ * revision: 10/17/2026	0.04	ndp		load the configuration store before the devices.
+ * revision: 10/17/2026	0.05	ndp		add staged start up and boot profile.
+ * revision: 10/17/2026	0.06	ndp		add CMD_INIT_BOOT to start the I2C bootloader.
+ *
+ * Boot Profile
+ *   The time of each step is measured with st_getTime() in Timer0 counts (8us) and can be read
+ *   with CMD_INIT_PROFILE. Interrupts are enabled before the devices are set up so the time
+ *   keeps counting.
+ *
+ * Staged Start Up (INIT_STAGED = 1)
+ *   The I2C Slave is enabled as soon as the core is set up. The device init functions are then
+ *   called one per pass by service_all(). Until they are all done, messages are held in the
+ *   input buffer and a read returns INIT_BUSY_BYTE, so the Master sees the node right away
+ *   and can poll for it to be ready.
  */ 
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+#include <avr/wdt.h>
+#include <stdbool.h>
 
 #include "initialize.h"
 #include "sysdefs.h"
@@ -40,16 +57,24 @@
 #include "sysTimer.h"
 #include "function_tables.h"
 #include "access.h"
+#include "config.h"
+#include "boot_info.h"
 
 #include "twiSlave.h"
 #include "flash_table.h"
 
+#define INIT_STAGED		1				// Set to 0 to set up all devices before the Slave is enabled.
+
+static uint8_t	init_index;						// next mod_init_table[] entry.
+static bool		init_done;
+
+static uint16_t	init_twiTime;					// time the Slave was enabled.
+static uint16_t	init_doneTime;					// time the last device was set up.
+static uint8_t	init_profileId[INIT_PROFILE_SIZE];
+static uint16_t	init_profileTime[INIT_PROFILE_SIZE];
+
 void init_all()
 {
-	int	index;
-	uint16_t deviceID;
-	void (*func)();
-	
 	/* *** Core initialization operations that are part of every build. *** */
 #if defined(__AVR_ATtiny24__) | defined(__AVR_ATtiny44__) | defined(__AVR_ATtiny84__) \
 	| defined(__AVR_ATtiny24A__) | defined(__AVR_ATtiny44A__) | defined(__AVR_ATtiny84A__)
@@ -61,27 +86,137 @@ void init_all()
 	PORTC |= (1<<PC6);			// enable RESET line pull-up.
 #endif
 // TODO: Add ATmega164P RESET pull-up code.
+
+	MCUSR = 0;
+	wdt_disable();			// still ON after a watchdog RESET from init_boot().
 	
 	st_init_tmr0();
+	cfg_init();				// settings are ready for the device init functions.
 	twiSlaveInit( ia_getAddress() );
 	access_init();
 
-	/* *** Device initialization based on command_tables auto-generated based on devices used. *** */
-	index = 0;
-	while(1) {
-		deviceID = flash_get_access_cmd(index, (MOD_FUNCTION_ENTRY*)mod_init_table);
-		func = (void (*)())flash_get_access_func(index, (MOD_FUNCTION_ENTRY*)mod_init_table);
-		if(deviceID != 0) {
-			func();
-		} else {
-			break;
-		}
-		++index;
-	}
+	init_index = 0;
+	init_done = false;
 
 	sei();					// Enable Interrupts.
-	
+
+#if INIT_STAGED == 1
+	twiSetUnderrunByte( INIT_BUSY_BYTE );
 	twiSlaveEnable();		// Enable I2C Slave interface.
+	init_twiTime = st_getTime();
+	// service_all() calls init_step() for the devices.
+#else
+	/* *** Device initialization based on command_tables auto-generated based on devices used. *** */
+	while( !init_step() );
+
+	twiSlaveEnable();		// Enable I2C Slave interface.
+	init_twiTime = st_getTime();
+#endif
 
 	return;
 }
+
+/*
+ * true when all of the devices have been set up.
+ */
+bool init_ready()
+{
+	return init_done;
+}
+
+/*
+ * Call the next device init function in mod_init_table[] and save its time.
+ * Returns true when all are done.
+ */
+bool init_step()
+{
+	uint16_t deviceID;
+	void (*func)();
+	uint16_t start;
+
+	if( init_done )
+		return true;
+
+	deviceID = flash_get_access_cmd(init_index, (MOD_FUNCTION_ENTRY*)mod_init_table);
+	func = (void (*)())flash_get_access_func(init_index, (MOD_FUNCTION_ENTRY*)mod_init_table);
+
+	if( deviceID == 0 )
+	{
+		init_done = true;
+		init_doneTime = st_getTime();
+		twiSetUnderrunByte( TWI_UNDERRUN_BYTE );
+		return true;
+	}
+
+	start = st_getTime();
+	func();
+	if( init_index < INIT_PROFILE_SIZE )
+	{
+		init_profileId[init_index] = deviceID;
+		init_profileTime[init_index] = st_getTime() - start;
+	}
+	++init_index;
+
+	return false;
+}
+
+/*
+ * Report start up state and times (Timer0 counts since RESET).
+ * CMD: F0 DEV 01
+ * Returns: READY DEVICES TWI_L TWI_H DONE_L DONE_H
+ */
+void init_status()
+{
+	twiTransmitByte( init_done );
+	twiTransmitByte( init_index );
+	twiTransmitByte( init_twiTime );
+	twiTransmitByte( init_twiTime >> 8 );
+	twiTransmitByte( init_doneTime );
+	twiTransmitByte( init_doneTime >> 8 );
+}
+
+/*
+ * Report device init times (Timer0 counts) starting at entry START. Up to 10 entries.
+ * CMD: E1 DEV 02 START
+ * Returns: COUNT then ID T_L T_H for each entry
+ */
+void init_profile()
+{
+	uint8_t index = getMsgData(3);
+	uint8_t count = 0;
+	uint8_t i;
+
+	while( (index + count < init_index) && (index + count < INIT_PROFILE_SIZE) && (count < 10) )
+	{
+		++count;
+	}
+
+	twiTransmitByte( count );
+	for( i=index; i<index+count; ++i )
+	{
+		twiTransmitByte( init_profileId[i] );
+		twiTransmitByte( init_profileTime[i] );
+		twiTransmitByte( init_profileTime[i] >> 8 );
+	}
+}
+
+/*
+ * RESET into the I2C bootloader. It uses the current I2C address.
+ * The data byte has to be BOOT_REQUEST so a stray message can not do this.
+ * CMD: E1 DEV 03 B7
+ */
+void init_boot()
+{
+	if( getMsgData(3) != BOOT_REQUEST )
+	{
+		return;
+	}
+
+	eeprom_update_byte( (uint8_t*)BOOT_EE_ADRS, TWAR >> 1 );
+	eeprom_update_byte( (uint8_t*)BOOT_EE_REQUEST, BOOT_REQUEST );
+	eeprom_busy_wait();
+
+	cli();
+	wdt_enable( WDTO_15MS );
+	while(1);
+}
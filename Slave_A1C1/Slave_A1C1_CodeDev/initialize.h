@@ -25,13 +25,33 @@
  *
  * Created: 8/08/2015	0.01	ndp
  *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		add staged start up and boot profile.
+ * revision: 10/17/2026	0.03	ndp		add CMD_INIT_BOOT.
  */ 
 
 
 #ifndef INITIALIZE_H_
 #define INITIALIZE_H_
 
+#include <stdbool.h>
+
+// System / Start up
+#define INIT_ID				0x10
+
+#define INIT_PROFILE_SIZE	16			// device init times kept.
+#define INIT_BUSY_BYTE		0xBB		// read from the Slave while the devices are still starting.
+
+#define CMD_INIT_STATUS		1			// Returns READY(0:1) DEVICES TWI_L TWI_H DONE_L DONE_H
+#define CMD_INIT_PROFILE	2			// START. Returns COUNT then ID T_L T_H for each device.
+#define CMD_INIT_BOOT		3			// BOOT_REQUEST. RESET into the I2C bootloader.
+
 void init_all();
 
+bool init_ready();
+bool init_step();
+
+void init_status();
+void init_profile();
+void init_boot();
 
-#endif /* INITIALIZE_H_ */
\ No newline at end of file
+#endif /* INITIALIZE_H_ */
@@ -26,11 +26,14 @@
  * Created: 8/08/2015	0.01	ndp
  *  Author: Chip
  *
+ * revision: 10/17/2026	0.02	ndp		run staged device init before the services.
+ *
  */ 
 
 #include <avr/io.h>
 
 #include "function_tables.h"
+#include "initialize.h"
 
 #include "flash_table.h"
 
@@ -38,6 +41,7 @@
  * Calls each service using a look-up branch table.
  * The service checks its associated TIC bit and calls its service function if its bit is set.
  * The TIC bits are defined in the sysTimer.h file.
+ * Until all devices are set up, one device init function is called per pass instead.
  */
 
 void service_all()
@@ -46,6 +50,12 @@ void service_all()
 	uint16_t deviceID;
 	void (*func)();
 
+	if( !init_ready() )
+	{
+		init_step();
+		return;
+	}
+
 	while(1) {
 		deviceID = flash_get_access_cmd(index, (MOD_FUNCTION_ENTRY*)mod_service_table);
 		func = (void (*)())flash_get_access_func(index, (MOD_FUNCTION_ENTRY*)mod_service_table);
@@ -29,6 +29,9 @@
  * Author: Chip
  *
  * revision:	01/19/2016	0.02	ndp		set to use 8MHz clock
+ * revision:	10/17/2026	0.03	ndp		set Timer2 cm count for 8MHz clock
+ * revision:	10/17/2026	0.04	ndp		add st_getTime() for profiling
+ * revision:	10/17/2026	0.05	ndp		st_tics is a seqlock. st_getTime() leaves interrupts on.
  *
  */ 
 
@@ -36,10 +39,12 @@
 #include <avr/interrupt.h>
 
 #include "sysTimer.h"
+#include "isrShared.h"
 
 #define SLOW_TIC		10			// 1ms * N for the slow tic
 
 uint8_t	st_cnt_10ms;				// secondary timer counter.
+SHARED_SEQ16 st_tics;				// Timer0 tics since RESET. Used by st_getTime().
 
 volatile uint8_t st_tmr2_count;
 
@@ -66,12 +71,42 @@ void st_init_tmr0()
 	TCCR0B =  0b011;			// CPU div 64
 	
 	st_cnt_10ms = SLOW_TIC;
+	seqWrite16( &st_tics, 0 );
 
 	GPIOR0 = 0;					// clear all tic flags
 
 	return;
 }
 
+/*
+ * Get the time since RESET in Timer0 counts (8us with CPU div 64 at 8MHz).
+ * Wraps after 65536 counts. Good for timing things up to ~0.5 sec.
+ * Needs interrupts ON to count past one tic.
+ *
+ * st_tics and TCNT0 are read as a seqlock read, so interrupts stay on. If the Timer0 ISR runs
+ * during the read they are read again.
+ */
+uint16_t st_getTime()
+{
+	uint16_t tics;
+	uint8_t count;
+	uint8_t seq;
+
+	do {
+		seq = st_tics.seq;
+		SHARED_FENCE();
+		tics = st_tics.value;
+		count = TCNT0;
+		if( (TIFR0 & (1<<OCF0A)) && (count < (OCR0A / 2)) )
+		{
+			++tics;					// wrapped after the read of st_tics. ISR still pending.
+		}
+		SHARED_FENCE();
+	} while( (seq & 1) || seq != st_tics.seq );
+
+	return tics * (OCR0A + 1) + count;
+}
+
 /*
  * Timer0 CTC (compare) interrupt service.
  * Called each 1ms
@@ -91,6 +126,8 @@ ISR(TIMER0_COMPA_vect)
 	GPIOR0 |= (1 << 2);
 	GPIOR0 |= (1 << 3);
 
+	seqAdd16( &st_tics, 1 );
+
 	if( --st_cnt_10ms == 0 )
 	{
 		GPIOR0 |= (1 << 4);
@@ -102,22 +139,23 @@ ISR(TIMER0_COMPA_vect)
 }
 
 /*
- * Set up Timer2 to generate 56.4us interrupt for Sonar Time (1cm) using 20MHz CPU clock
+ * Set up Timer2 to generate 58us interrupt for Sonar Time (1cm) using 8MHz CPU clock
  * Call this once after RESET.
  *
- * Modifies: OCR0A, TCCR0A, TIMSK0, TCCR0B, and GPIOR0
+ * Modifies: OCR2A, TCCR2A, TIMSK2, TCCR2B
  *
  * input reg:	none
  * output reg:	none
  * resources:	R16
  *
- * NOTE: Rate set for 56.4us
+ * NOTE: Rate set for 58us. Sound takes 58.3us to go 1cm and back.
+ * NOTE: Timer2 is also used by dev_led_bam. Only one can be used.
  */
 void st_init_tmr2()
 {
-	OCR2A = 140;
+	OCR2A = 57;					// 58us = 8000000 / 8 / (1 + OCR2A)
 
-	TCCR2A = (1 << WGM01);		// reset on CTC match
+	TCCR2A = (1 << WGM21);		// reset on CTC match
 
 	TCCR2B = 0x02;				// CPU div 8
 
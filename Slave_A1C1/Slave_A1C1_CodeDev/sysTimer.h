@@ -36,16 +36,17 @@
 
 // 1ms tic flags
 #define DEV_1MS_TIC		0			// Device service tic
-//#define				1
+#define SONAR_1MS_TIC	1			// Sonar slot tic
 //#define				2
 //#define				3
 // 10ms tic flags
 #define	DEV_10MS_TIC	4
-//#define				5
-//#define				6
+#define	SEQ_10MS_TIC	5			// Sequencer wait tic
+#define	LED1_10MS_TIC	6			// LED-1 timed mode tic
 //#define				7
 
 void st_init_tmr0();
+uint16_t st_getTime();
 
 void st_init_tmr2();
 uint8_t tmr2_getCount();
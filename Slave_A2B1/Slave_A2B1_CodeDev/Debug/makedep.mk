@@ -4,5 +4,5 @@
 
 Slave_A2B1.c
 
-usiTwiSlave.c
+../../Slave_Driver/usiTwiSlave.c
 
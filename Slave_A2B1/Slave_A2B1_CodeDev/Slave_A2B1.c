@@ -25,6 +25,7 @@
  *
  * Created: 1/28/2016	0.01	ndp
  *  Author: Chip
+ * revision: 10/17/2026	0.02	ndp		Shared usiTwiSlave driver. Enable is usiTwiSlaveEnable().
  *
  * Demo code for Slave_A2B1 project.
  * Target: ATmega85 (by sure to set Project > Properties > Device to this AVR chip)
@@ -60,7 +61,7 @@ int main(void)
 	
 	sei();							// Enable interrupts.
 	
-	twiSlaveEnable();				// Enable the TWI interface to receive data.
+	usiTwiSlaveEnable();			// Enable the TWI interface to receive data.
 	
     while(1)
     {
@@ -0,0 +1,236 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * isrShared.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Variables wider than 8 bits shared by an ISR and the main loop. The AVR reads and writes
+ * them a byte at a time, so without care one side can see half of an old value and half of a
+ * new one. There are three ways, by who writes and what the access may cost.
+ *
+ *   sharedRead16/32()  sharedWrite16/32()
+ *		Copy with the ISR held off (ATOMIC_BLOCK). Either direction. The fewest cycles for main,
+ *		but interrupts wait for the copy.
+ *   SHARED_SEQ16/32: seqWrite..() and seqAdd..() in the ISR, seqRead..() in main.
+ *		Seqlock. The ISR makes seq odd, writes the value and makes seq even again. Main reads
+ *		seq, the value and seq, and reads again if seq was odd or moved. Interrupts are never
+ *		held off. For counters and results the ISR updates.
+ *   SHARED_DBUF16/32: dbufWrite..() in main, dbufRead..() in the ISR.
+ *		Double buffer. Main writes the slot the ISR is not reading and then flips the one byte
+ *		index. The ISR always reads a whole value and never waits. For settings main gives an
+ *		ISR. Only one side may write.
+ *
+ * Interrupts are already off in an ISR, so the ISR side of a plain variable needs no helper.
+ * Only main does.
+ *
+ * On the AVR the fences are empty asm memory barriers that only stop the compiler moving the
+ * accesses, so they cost no cycles. On the host they are C11 style fences, so the seqlock is
+ * also correct with the writer and reader on two threads.
+ */ 
+
+
+#ifndef ISRSHARED_H_
+#define ISRSHARED_H_
+
+#include <stdint.h>
+#include <util/atomic.h>
+
+#define SHARED_INLINE	static inline __attribute__((always_inline))
+
+#ifdef __AVR__
+#  define SHARED_FENCE()	__asm__ __volatile__( "" ::: "memory" )
+#else
+#  define SHARED_FENCE()	__atomic_thread_fence( __ATOMIC_SEQ_CST )
+#endif
+
+typedef struct {
+	volatile uint8_t	seq;		// odd while the ISR is writing.
+	volatile uint16_t	value;
+} SHARED_SEQ16;
+
+typedef struct {
+	volatile uint8_t	seq;		// odd while the ISR is writing.
+	volatile uint32_t	value;
+} SHARED_SEQ32;
+
+typedef struct {
+	volatile uint16_t	value[2];
+	volatile uint8_t	cur;		// slot the ISR reads.
+} SHARED_DBUF16;
+
+typedef struct {
+	volatile uint32_t	value[2];
+	volatile uint8_t	cur;		// slot the ISR reads.
+} SHARED_DBUF32;
+
+/* *** Copy with the ISR held off *** */
+
+SHARED_INLINE uint16_t
+sharedRead16( const volatile uint16_t* p )
+{
+	uint16_t v;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		v = *p;
+	}
+	return v;
+}
+
+SHARED_INLINE void
+sharedWrite16( volatile uint16_t* p, uint16_t v )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		*p = v;
+	}
+}
+
+SHARED_INLINE uint32_t
+sharedRead32( const volatile uint32_t* p )
+{
+	uint32_t v;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		v = *p;
+	}
+	return v;
+}
+
+SHARED_INLINE void
+sharedWrite32( volatile uint32_t* p, uint32_t v )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		*p = v;
+	}
+}
+
+/* *** Seqlock. ISR writes, main reads. *** */
+
+SHARED_INLINE void
+seqWrite16( SHARED_SEQ16* s, uint16_t v )
+{
+	s->seq = s->seq + 1;
+	SHARED_FENCE();
+	s->value = v;
+	SHARED_FENCE();
+	s->seq = s->seq + 1;
+}
+
+SHARED_INLINE void
+seqAdd16( SHARED_SEQ16* s, uint16_t n )
+{
+	seqWrite16( s, s->value + n );
+}
+
+SHARED_INLINE uint16_t
+seqRead16( const SHARED_SEQ16* s )
+{
+	uint8_t seq;
+	uint16_t v;
+
+	do {
+		seq = s->seq;
+		SHARED_FENCE();
+		v = s->value;
+		SHARED_FENCE();
+	} while( (seq & 1) || seq != s->seq );
+	return v;
+}
+
+SHARED_INLINE void
+seqWrite32( SHARED_SEQ32* s, uint32_t v )
+{
+	s->seq = s->seq + 1;
+	SHARED_FENCE();
+	s->value = v;
+	SHARED_FENCE();
+	s->seq = s->seq + 1;
+}
+
+SHARED_INLINE void
+seqAdd32( SHARED_SEQ32* s, uint32_t n )
+{
+	seqWrite32( s, s->value + n );
+}
+
+SHARED_INLINE uint32_t
+seqRead32( const SHARED_SEQ32* s )
+{
+	uint8_t seq;
+	uint32_t v;
+
+	do {
+		seq = s->seq;
+		SHARED_FENCE();
+		v = s->value;
+		SHARED_FENCE();
+	} while( (seq & 1) || seq != s->seq );
+	return v;
+}
+
+/* *** Double buffer. Main writes, ISR reads. *** */
+
+SHARED_INLINE void
+dbufWrite16( SHARED_DBUF16* d, uint16_t v )
+{
+	uint8_t next = d->cur ^ 1;
+
+	d->value[next] = v;
+	SHARED_FENCE();
+	d->cur = next;
+}
+
+SHARED_INLINE uint16_t
+dbufRead16( const SHARED_DBUF16* d )
+{
+	uint8_t cur = d->cur;
+
+	SHARED_FENCE();
+	return d->value[cur];
+}
+
+SHARED_INLINE void
+dbufWrite32( SHARED_DBUF32* d, uint32_t v )
+{
+	uint8_t next = d->cur ^ 1;
+
+	d->value[next] = v;
+	SHARED_FENCE();
+	d->cur = next;
+}
+
+SHARED_INLINE uint32_t
+dbufRead32( const SHARED_DBUF32* d )
+{
+	uint8_t cur = d->cur;
+
+	SHARED_FENCE();
+	return d->value[cur];
+}
+
+#endif /* ISRSHARED_H_ */
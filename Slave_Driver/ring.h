@@ -0,0 +1,189 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ring.h
+ *
+ * Created: 10/17/2026		0.01	ndp
+ *  Author: Chip
+ *
+ * Single producer, single consumer byte FIFO shared by an ISR and the main loop. The driver
+ * keeps the buffer and passes it with its mask (size - 1, size 2^n up to 256) on each call,
+ * so with a constant mask each call inlines to the same few instructions as open coded
+ * head/tail code. One slot is always left empty, so a ring holds size - 1 bytes.
+ *
+ *   head	index of the last byte put. Only the producer writes it.
+ *   tail	index of the last byte taken. Only the consumer writes it.
+ *
+ * Ordering. The producer stores the byte and then publishes it with a release store of head.
+ * The consumer loads head with acquire before it reads the byte, and releases the slot with a
+ * release store of tail after the read, so the producer never writes a slot still being read.
+ * The producer loads tail with acquire before it reuses a slot. Any other index published
+ * with the data (e.g. txReady) is stored with ringStore() after head.
+ *
+ * On the AVR a uint8_t load or store is one instruction and there is one core, so acquire and
+ * release only have to stop the compiler moving buffer accesses across the index access. They
+ * are empty asm memory barriers and cost no cycles. On the host they are C11 style atomics, so
+ * the same code is correct with the producer and consumer on two threads.
+ *
+ * Clearing. Resetting head and tail while the other side may be using them is the one
+ * operation that needs both indices, so it is done with the ISR held off (RING_ATOMIC).
+ *   ringDrop()		tail = head. From the consumer, or inside RING_ATOMIC.
+ *   ringClear()	ringDrop() inside RING_ATOMIC. From either side.
+ * RING_ATOMIC defaults to ATOMIC_BLOCK(ATOMIC_RESTORESTATE). A host test can set it first.
+ */ 
+
+
+#ifndef RING_H_
+#define RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef RING_ATOMIC
+#  include <util/atomic.h>
+#  define RING_ATOMIC		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#endif
+
+#define RING_INLINE		static inline __attribute__((always_inline))
+
+typedef struct {
+	volatile uint8_t	head;		// last byte put. Producer only.
+	volatile uint8_t	tail;		// last byte taken. Consumer only.
+} RING;
+
+#ifdef __AVR__
+#  define RING_BARRIER()	__asm__ __volatile__( "" ::: "memory" )
+
+RING_INLINE uint8_t
+ringLoad( volatile uint8_t* idx )
+{
+	uint8_t v = *idx;
+
+	RING_BARRIER();
+	return v;
+}
+
+RING_INLINE void
+ringStore( volatile uint8_t* idx, uint8_t v )
+{
+	RING_BARRIER();
+	*idx = v;
+}
+#else
+RING_INLINE uint8_t
+ringLoad( volatile uint8_t* idx )
+{
+	return __atomic_load_n( idx, __ATOMIC_ACQUIRE );
+}
+
+RING_INLINE void
+ringStore( volatile uint8_t* idx, uint8_t v )
+{
+	__atomic_store_n( idx, v, __ATOMIC_RELEASE );
+}
+#endif
+
+/*
+ * Empty. Only while neither side is running, e.g. before the interrupt is enabled.
+ */
+RING_INLINE void
+ringInit( RING* r )
+{
+	r->head = 0;
+	r->tail = 0;
+}
+
+/*
+ * Producer. Put a byte. false if the ring is full and the byte was not put.
+ */
+RING_INLINE bool
+ringPut( RING* r, uint8_t* buf, uint8_t mask, uint8_t data )
+{
+	uint8_t next = ( r->head + 1 ) & mask;
+
+	if ( next == ringLoad( &r->tail ) )
+	{
+		return false;
+	}
+	buf[ next ] = data;
+	ringStore( &r->head, next );
+	return true;
+}
+
+/*
+ * Consumer. Take a byte. The caller has checked the ring is not empty (ringEmpty() or a count).
+ */
+RING_INLINE uint8_t
+ringTake( RING* r, const uint8_t* buf, uint8_t mask )
+{
+	uint8_t next = ( r->tail + 1 ) & mask;
+	uint8_t data = buf[ next ];
+
+	ringStore( &r->tail, next );
+	return data;
+}
+
+/*
+ * Either side. true if there is nothing to take. Acquire, so the consumer can take after it.
+ */
+RING_INLINE bool
+ringEmpty( RING* r )
+{
+	return ringLoad( &r->head ) == ringLoad( &r->tail );
+}
+
+/*
+ * Either side. Bytes in the ring. Exact for the side that runs with the other held off,
+ * a lower bound of what can be taken for the consumer and of the free space for the producer.
+ */
+RING_INLINE uint8_t
+ringCount( RING* r, uint8_t mask )
+{
+	return ( ringLoad( &r->head ) - ringLoad( &r->tail ) ) & mask;
+}
+
+/*
+ * Drop everything: tail = head. From the consumer, or inside RING_ATOMIC. Returns the new tail.
+ */
+RING_INLINE uint8_t
+ringDrop( RING* r )
+{
+	uint8_t head = ringLoad( &r->head );
+
+	ringStore( &r->tail, head );
+	return head;
+}
+
+/*
+ * Drop everything from either side.
+ */
+RING_INLINE void
+ringClear( RING* r )
+{
+	RING_ATOMIC
+	{
+		(void)ringDrop( r );
+	}
+}
+
+#endif /* RING_H_ */
@@ -26,6 +26,13 @@
  * Created: 8/10/2015	0.01	ndp
  *  Author: Chip
  * revision: 1/29/2016	0.02	ndp	 Add TxBuf[] test to support single read example.
+ * revision: 10/17/2026	0.03	ndp	 Enable General Call address.
+ * revision: 10/17/2026	0.04	ndp	 Settable underrun byte. Used to report BUSY during start up.
+ * revision: 10/17/2026	0.05	ndp	 Add READY status byte first in each read and twiTransmitReady().
+ * revision: 10/17/2026	0.06	ndp	 Shared driver. General Call, stats and ISR hooks set in twiSlave_cfg.h.
+ * revision: 10/17/2026	0.07	ndp	 RX high and TX low watermark events.
+ * revision: 10/17/2026	0.08	ndp	 FIFOs use ring.h. twiClearOutput() is safe during a read.
+ * revision: 10/17/2026	0.09	ndp	 A read never sends past its READY count. Drop streaming.
  *
  * Based on the Atmel App Note AVR311 and enhanced to support FIFO data buffers for 
  * input and output.
@@ -45,15 +52,25 @@
  *								Read request is received to show that all of the prior data has been sent.
  *								If the buffer is not empty, call twiClearOutput() to recover.
  * twiClearOutput()				Reset the output buffer to empty. Used recover from sync errors.
+ * twiTransmitReady()			Mark the data in the output buffer as a complete reply.
  *
  * twiStuffRxBuf( data )		Allows manual input into input buffer for testing.
+ *
+ * twiRxCount()					Bytes in the input buffer.
+ * twiTxCount()					Bytes in the output buffer.
+ * twiGetEvents()				Read and clear the watermark events.
+ *
+ * twiGetStats( &stats )		Copy the TWI_STATS counts. Only with TWI_USE_STATS.
+ * twiClearStats()				Zero the TWI_STATS counts. Only with TWI_USE_STATS.
  * 
  */ 
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 
 #include "twiSlave.h"
+#include "ring.h"
 
 void flushTwiBuffers( void );
 
@@ -83,36 +100,63 @@ void flushTwiBuffers( void );
 
 /* *** Local variables *** */
 static uint8_t          rxBuf[ TWI_RX_BUFFER_SIZE ];
-static volatile uint8_t rxHead;
-static volatile uint8_t rxTail;
+static RING             rxRing;						// ISR puts, main takes.
 
 static uint8_t          txBuf[ TWI_TX_BUFFER_SIZE ];
-static volatile uint8_t txHead;
-static volatile uint8_t txTail;
+static RING             txRing;						// main puts, ISR takes.
+static volatile uint8_t txReady;					// txRing.head at the end of the last complete reply.
+static volatile uint8_t txSending;					// reply bytes left in this read.
+static volatile uint8_t txUnderrun = TWI_UNDERRUN_BYTE;
+
+static volatile uint8_t twiEvents;					// TWI_EVENT_ bits.
+
+#if TWI_USE_STATS == 1
+static TWI_STATS twiStats;
+#  define TWI_COUNT(field)	++twiStats.field
+#else
+#  define TWI_COUNT(field)
+#endif
 
 /* *** Local Functions *** */
+/*
+ * Called by the ISR after a byte is taken from the output buffer.
+ */
+static inline void
+twiTxTaken( void )
+{
+	TWI_COUNT( txBytes );
+#ifdef TWI_TX_LOW_WATER
+	if ( ringCount( &txRing, TWI_TX_BUFFER_MASK ) == TWI_TX_LOW_WATER )
+	{
+		twiEvents |= TWI_EVENT_TX_LOW;
+		TWI_HOOK_TX_LOW();
+	}
+#endif
+}
+
 /*
  * Reset TWI buffers pointers so that the FIFOs will show empty.
  */
 void
 flushTwiBuffers( void )
 {
-	rxTail = 0;
-	rxHead = 0;
-	txTail = 0;
-	txHead = 0;
+	ringInit( &rxRing );
+	ringInit( &txRing );
+	txReady = 0;
+	twiEvents = 0;
 }
 
 /* *** Public Functions *** */
 /*
  * Set up TWI hardware and set Slave I2C Address.
- * This is called once during the initialization process.
- * TODO: Allow GLOBAL address.
+ * This is called during the initialization process and again if the address is changed.
+ * With TWI_GENERAL_CALL, General Call (0x00) messages are also received. They go into the
+ * same input buffer.
  */
 void
 twiSlaveInit( uint8_t adrs )
 {
-	TWAR = (adrs << 1)|(0);
+	TWAR = (adrs << 1)|(TWI_GENERAL_CALL<<TWGCE);
 	
 	TWCR = (1<<TWEN)|(0<<TWIE)|(0<<TWINT)|(0<<TWEA)|(0<<TWSTA)|(0<<TWSTO)|(0<<TWWC);
 	return;
@@ -139,22 +183,18 @@ twiSlaveEnable( void )
 void
 twiTransmitByte( uint8_t data )
 {
-	uint8_t tmphead;
-
-	// calculate buffer index
-	tmphead = ( txHead + 1 ) & TWI_TX_BUFFER_MASK;
-
-	// check for free space in buffer
-	if ( tmphead == txTail )
-	{
-		return;
-	}
-
-	// store data into buffer
-	txBuf[ tmphead ] = data;
+	// dropped if there is no free space in buffer
+	(void)ringPut( &txRing, txBuf, TWI_TX_BUFFER_MASK, data );
+}
 
-	// update index
-	txHead = tmphead;
+/*
+ * Mark everything in the output buffer as a complete reply. Call after the last twiTransmitByte()
+ * of a reply. With TWI_REPLY_STATUS, the Master is told the reply is ready only after this.
+ */
+void
+twiTransmitReady( void )
+{
+	ringStore( &txReady, txRing.head );
 }
 
 /*
@@ -168,15 +208,22 @@ uint8_t
 twiReceiveByte( void )
 {
 	// check for available data.
-	if ( rxHead == rxTail )
+	if ( ringEmpty( &rxRing ) )
 	{
 		return 0x88;
 	}
 
-	// generate index
-	rxTail = ( rxTail + 1 ) & TWI_RX_BUFFER_MASK;
+	return ringTake( &rxRing, rxBuf, TWI_RX_BUFFER_MASK );
+}
 
-	return rxBuf[ rxTail ];
+/*
+ * Set the byte sent when the Master reads from an empty output buffer.
+ * Default is TWI_UNDERRUN_BYTE.
+ */
+void
+twiSetUnderrunByte( uint8_t data )
+{
+	txUnderrun = data;
 }
 
 /*
@@ -187,7 +234,7 @@ bool
 twiDataInReceiveBuffer( void )
 {
   // return 0 (false) if the receive buffer is empty
-  return rxHead != rxTail;
+  return !ringEmpty( &rxRing );
 }
 
 /*
@@ -198,17 +245,21 @@ bool
 twiDataInTransmitBuffer( void )
 {
   // return 0 (false) if the transmit buffer is empty
-  return txHead != txTail;
+  return !ringEmpty( &txRing );
 }
 
 /*
  * Reset the output buffer to empty. Used to recover from sync errors.
+ * The ISR is held off, so a read in progress goes on with the underrun byte.
  */
 void
 twiClearOutput( void )
 {
-	txTail = 0;
-	txHead = 0;
+	RING_ATOMIC
+	{
+		txReady = ringDrop( &txRing );
+		txSending = 0;
+	}
 }
 
 /*
@@ -219,23 +270,79 @@ twiClearOutput( void )
 void
 twiStuffRxBuf( uint8_t data )
 {
-	uint8_t tmphead;
-
-	// calculate buffer index
-	tmphead = ( rxHead + 1 ) & TWI_RX_BUFFER_MASK;
-
 	// check for free space in buffer
-	if ( tmphead == rxTail )
+	if ( !ringPut( &rxRing, rxBuf, TWI_RX_BUFFER_MASK, data ) )
 	{
+		TWI_COUNT( rxOverflow );
 		return;
 	}
+	TWI_COUNT( rxBytes );
+
+#ifdef TWI_RX_HIGH_WATER
+	if ( ringCount( &rxRing, TWI_RX_BUFFER_MASK ) == TWI_RX_HIGH_WATER )
+	{
+		twiEvents |= TWI_EVENT_RX_HIGH;
+		TWI_HOOK_RX_HIGH();
+	}
+#endif
+}
+
+/*
+ * Bytes in the input buffer.
+ */
+uint8_t
+twiRxCount( void )
+{
+	return ringCount( &rxRing, TWI_RX_BUFFER_MASK );
+}
+
+/*
+ * Bytes in the output buffer, ready or not.
+ */
+uint8_t
+twiTxCount( void )
+{
+	return ringCount( &txRing, TWI_TX_BUFFER_MASK );
+}
+
+/*
+ * Read and clear the TWI_EVENT_ bits. An event the ISR raises while this runs is kept.
+ */
+uint8_t
+twiGetEvents( void )
+{
+	uint8_t events;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		events = twiEvents;
+		twiEvents = 0;
+	}
+	return events;
+}
 
-	// store data into buffer
-	rxBuf[ tmphead ] = data;
+#if TWI_USE_STATS == 1
+/*
+ * Copy the counts. The ISR is held off so they are all from the same moment.
+ */
+void
+twiGetStats( TWI_STATS* stats )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		*stats = twiStats;
+	}
+}
 
-	// update index
-	rxHead = tmphead;
+void
+twiClearStats( void )
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		twiStats = (TWI_STATS){ 0 };
+	}
 }
+#endif
 
 /* *** Interrupt Service Routines *** */
 
@@ -257,6 +364,7 @@ ISR( TWI_vect )
 		case TWI_SRX_GEN_DATA_ACK:			// 0x90 Previously addressed with general call; Data received; ACK'd
 			// Put data into RX buffer
 			twiStuffRxBuf( TWDR );
+			TWI_HOOK_RX( TWDR );
 			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event. Should be more DATA.
   			break;
 			
@@ -266,27 +374,58 @@ ISR( TWI_vect )
 			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event. Should be DATA.
 			break;
 
+#if TWI_REPLY_STATUS == 1
+		case TWI_STX_ADR_ACK:				// 0xA8 Own SLA+R has been received; ACK has been returned. Load READY status.
+//		case TWI_STX_ADR_ACK_M_ARB_LOST:	// 0xB0 Own SLA+R has been received; ACK has been returned
+			TWI_HOOK_READ();
+			// READY is the number of bytes of complete replies that follow. 0 = not ready yet, read again.
+			txSending = ( ringLoad( &txReady ) - txRing.tail ) & TWI_TX_BUFFER_MASK;
+			TWDR = txSending;
+			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event.
+			break;
+
+		case TWI_STX_DATA_ACK:				// 0xB8 Data byte in TWDR has been transmitted; ACK has been received. Load DATA.
+			if ( txSending != 0 )
+			{
+				--txSending;
+				TWDR = ringTake( &txRing, txBuf, TWI_TX_BUFFER_MASK );
+				twiTxTaken();
+			}
+			else
+			{
+				// no more reply data. Too much data was asked for.
+				TWDR = txUnderrun;
+				TWI_COUNT( txUnderrun );
+			}
+			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event.
+			break;
+#else
 		case TWI_STX_ADR_ACK:				// 0xA8 Own SLA+R has been received; ACK has been returned. Load DATA.
 //		case TWI_STX_ADR_ACK_M_ARB_LOST:	// 0xB0 Own SLA+R has been received; ACK has been returned
+			TWI_HOOK_READ();
+			// fall through
 		case TWI_STX_DATA_ACK:				// 0xB8 Data byte in TWDR has been transmitted; ACK has been received. Load DATA.
-			if ( txHead != txTail )
+			if ( !ringEmpty( &txRing ) )
 			{
-				txTail = ( txTail + 1 ) & TWI_TX_BUFFER_MASK;
-				TWDR = txBuf[ txTail ];
+				TWDR = ringTake( &txRing, txBuf, TWI_TX_BUFFER_MASK );
+				twiTxTaken();
 			}
 			else
 			{
 				// the buffer is empty. Send 0x88. Too much data was asked for.
-				TWDR = 0x88;
+				TWDR = txUnderrun;
+				TWI_COUNT( txUnderrun );
 			}
 			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event.
 			break;
+#endif
 
 		case TWI_STX_DATA_NACK:				// 0xC0 Data byte in TWDR has been transmitted; NOT ACK has been received. End of Sending.
 			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event. Should be new message.
 			break;
 
 		case TWI_SRX_STOP_RESTART:			// 0xA0 A STOP condition or repeated START condition has been received while still addressed as Slave
+			TWI_HOOK_STOP();
 			TWCR = (1<<TWEN)|(1<<TWIE)|(1<<TWINT)|(1<<TWEA);		// Prepare for next event.
 			break;
 
@@ -296,6 +435,7 @@ ISR( TWI_vect )
 		case TWI_NO_STATE:					// 0xF8 No relevant state information available; TWINT = 0
 		case TWI_BUS_ERROR:					// 0x00 Bus error due to an illegal START or STOP condition
 			TWCR =   (1<<TWSTO)|(1<<TWINT);   // Recover from TWI_BUS_ERROR
+			TWI_COUNT( busErrors );
 			// TODO: Set an ERROR flag to tell main to restart interface.
 			break;
 
@@ -0,0 +1,180 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Nels D. "Chip" Pearson (aka CmdrZin)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * twiSlave.h
+ *
+ * Created: 8/10/2015	0.01	ndp
+ *  Author: Chip
+ * revision: 1/29/2016	0.02	ndp	 Add twiDataInTransmitBuffer() test to support single read example.
+ * revision: 10/17/2026	0.03	ndp	 Add twiSetUnderrunByte().
+ * revision: 10/17/2026	0.04	ndp	 Add TWI_REPLY_STATUS and twiTransmitReady().
+ * revision: 10/17/2026	0.05	ndp	 Shared by all TWI projects. Options come from twiSlave_cfg.h.
+ * revision: 10/17/2026	0.06	ndp	 FIFO watermarks, twiGetEvents(), twiRxCount() and twiTxCount().
+ * revision: 10/17/2026	0.07	ndp	 Document the READY framing. No streaming past READY.
+ *
+ * Each project has a twiSlave_cfg.h in its own folder that sets the options it needs. Anything
+ * it does not set uses the default here.
+ *
+ *   TWI_RX_BUFFER_SIZE		input FIFO size, 2^n up to 256. Default 32.
+ *   TWI_TX_BUFFER_SIZE		output FIFO size, 2^n up to 256. Default 32.
+ *   TWI_UNDERRUN_BYTE		sent when the Master reads more than is in the output FIFO. Default 0x88.
+ *   TWI_GENERAL_CALL		1 = also receive General Call (0x00) messages. Default 0.
+ *   TWI_REPLY_STATUS		1 = READY status byte first in every read. Default 0.
+ *   TWI_USE_STATS			1 = keep TWI_STATS counts. Default 0.
+ *   TWI_HOOK_RX(data)		called in the ISR for each byte received. Default none.
+ *   TWI_HOOK_READ()		called in the ISR on SLA+R before the first byte is loaded. Default none.
+ *   TWI_HOOK_STOP()		called in the ISR on STOP or repeated START. Default none.
+ *   TWI_RX_HIGH_WATER		input FIFO count that raises TWI_EVENT_RX_HIGH. Default not set.
+ *   TWI_TX_LOW_WATER		output FIFO count that raises TWI_EVENT_TX_LOW. Default not set.
+ *   TWI_HOOK_RX_HIGH()		called in the ISR when the input FIFO fills to TWI_RX_HIGH_WATER.
+ *   TWI_HOOK_TX_LOW()		called in the ISR when the output FIFO drains to TWI_TX_LOW_WATER.
+ *
+ * The hooks run in the ISR with SCL held low, so keep them short.
+ *
+ * Watermarks. An event is raised once each time the count reaches the mark, and stays set
+ * until twiGetEvents() reads it. The main loop can drain the input FIFO on RX_HIGH instead of
+ * waiting for its turn, and a producer can top up the output FIFO on TX_LOW.
+ *
+ * Reads with TWI_REPLY_STATUS. The first byte is READY, the number of ready bytes that
+ * follow. The Slave sends exactly READY bytes and then only the underrun byte, even if more
+ * data is made ready during the read, since the Master could not tell that data from underrun
+ * bytes. Data made ready during a read waits for the next read, which starts with its own
+ * READY count. A Master reading more than the FIFO holds reads again for each part.
+ */ 
+
+
+#ifndef TWISLAVE_H_
+#define TWISLAVE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "twiSlave_cfg.h"
+
+
+/* *** Buffer defines *** */
+// allowed buffer sizes: 2^n up to 256 bytes
+
+#ifndef TWI_RX_BUFFER_SIZE
+#  define TWI_RX_BUFFER_SIZE  ( 32 )
+#endif
+#define TWI_RX_BUFFER_MASK  ( TWI_RX_BUFFER_SIZE - 1 )
+
+#if ( TWI_RX_BUFFER_SIZE & TWI_RX_BUFFER_MASK ) || ( TWI_RX_BUFFER_SIZE > 256 )
+#  error TWI_RX_BUFFER_SIZE is not a power of 2 up to 256
+#endif
+
+#ifndef TWI_TX_BUFFER_SIZE
+#  define TWI_TX_BUFFER_SIZE ( 32 )
+#endif
+#define TWI_TX_BUFFER_MASK ( TWI_TX_BUFFER_SIZE - 1 )
+
+#if ( TWI_TX_BUFFER_SIZE & TWI_TX_BUFFER_MASK ) || ( TWI_TX_BUFFER_SIZE > 256 )
+#  error TWI_TX_BUFFER_SIZE is not a power of 2 up to 256
+#endif
+
+
+#ifndef TWI_UNDERRUN_BYTE
+#  define TWI_UNDERRUN_BYTE	( 0x88 )	// sent when the Master reads more data than is in the output buffer.
+#endif
+
+#ifndef TWI_GENERAL_CALL
+#  define TWI_GENERAL_CALL	0
+#endif
+
+/*
+ * READY status. When 1, the first byte of every read is the number of reply bytes that follow.
+ * It is 0 until twiTransmitReady() is called for the reply, so the Master can read again at once
+ * instead of waiting a fixed time before the read.
+ */
+#ifndef TWI_REPLY_STATUS
+#  define TWI_REPLY_STATUS	0
+#endif
+
+#ifndef TWI_USE_STATS
+#  define TWI_USE_STATS		0
+#endif
+
+#ifndef TWI_HOOK_RX
+#  define TWI_HOOK_RX(data)
+#endif
+#ifndef TWI_HOOK_READ
+#  define TWI_HOOK_READ()
+#endif
+#ifndef TWI_HOOK_STOP
+#  define TWI_HOOK_STOP()
+#endif
+#ifndef TWI_HOOK_RX_HIGH
+#  define TWI_HOOK_RX_HIGH()
+#endif
+#ifndef TWI_HOOK_TX_LOW
+#  define TWI_HOOK_TX_LOW()
+#endif
+
+#if defined(TWI_RX_HIGH_WATER) && ( TWI_RX_HIGH_WATER < 1 || TWI_RX_HIGH_WATER >= TWI_RX_BUFFER_SIZE )
+#  error TWI_RX_HIGH_WATER must be 1 to TWI_RX_BUFFER_SIZE-1
+#endif
+#if defined(TWI_TX_LOW_WATER) && ( TWI_TX_LOW_WATER >= TWI_TX_BUFFER_SIZE - 1 )
+#  error TWI_TX_LOW_WATER must be 0 to TWI_TX_BUFFER_SIZE-2
+#endif
+
+/* twiGetEvents() bits */
+#define TWI_EVENT_RX_HIGH	0x01		// input FIFO filled to TWI_RX_HIGH_WATER.
+#define TWI_EVENT_TX_LOW	0x02		// output FIFO drained to TWI_TX_LOW_WATER.
+
+/* Counts kept with TWI_USE_STATS. They wrap. */
+typedef struct {
+	uint16_t	rxBytes;			// bytes put in the input buffer.
+	uint16_t	rxOverflow;			// bytes lost, input buffer full.
+	uint16_t	txBytes;			// bytes sent from the output buffer.
+	uint16_t	txUnderrun;			// underrun bytes sent.
+	uint16_t	busErrors;			// bus errors and unexpected states.
+} TWI_STATS;
+
+/* *** GLobal Protoptyes *** */
+
+void	twiSlaveInit( uint8_t adrs );		// Set up TWI hardware and set Slave I2C Address.
+void	twiSlaveEnable( void );				// Enable I2C Slave interface.
+
+void	twiTransmitByte( uint8_t data );	// Place data into output buffer.
+uint8_t	twiReceiveByte( void );				// Read data from input buffer.
+bool	twiDataInReceiveBuffer( void );		// Check for available data in input buffer. This function should return TRUE
+											// before calling twiReceiveByte() to get data.
+bool	twiDataInTransmitBuffer( void );	// Check that all prior data has been read.
+void	twiTransmitReady( void );			// Mark the output buffer data as a complete reply.
+void	twiClearOutput( void );				// Reset the output buffer to empty. Used recover from sync errors.
+void	twiSetUnderrunByte( uint8_t data );	// Set the byte sent when the output buffer is empty.
+
+void	twiStuffRxBuf( uint8_t data );	// Allows manual input into input buffer for testing.
+
+uint8_t	twiRxCount( void );					// Bytes in the input buffer.
+uint8_t	twiTxCount( void );					// Bytes in the output buffer.
+uint8_t	twiGetEvents( void );				// Read and clear the TWI_EVENT_ bits.
+
+#if TWI_USE_STATS == 1
+void	twiGetStats( TWI_STATS* stats );	// Copy the counts.
+void	twiClearStats( void );				// Zero the counts.
+#endif
+
+
+#endif /* TWISLAVE_H_ */
\ No newline at end of file
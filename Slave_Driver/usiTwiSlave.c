@@ -34,6 +34,12 @@ Change Activity:
   27 May 2015  Added support for ATtiny24/44/84 and ATtiny24A/44A/84A devices.(ndp)
   23 Jan 2016  Added support functions used by twiSlave.c for interchangeability.(ndp)
   29 Jan 2016  Add TxBuf[] test to support single read example. (ndp)
+  17 Oct 2026  Shared driver. General Call, underrun byte, READY status, stats
+               and ISR hooks set in usiTwiSlave_cfg.h. Drop input bytes when the
+               buffer is full instead of overrunning it. (ndp)
+  17 Oct 2026  RX high and TX low watermark events. (ndp)
+  17 Oct 2026  FIFOs use ring.h. (ndp)
+  17 Oct 2026  A read never sends past its READY count. Drop streaming. (ndp)
 
 ********************************************************************************/
 
@@ -47,7 +53,9 @@ Change Activity:
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 #include "usiTwiSlave.h"
+#include "ring.h"
 
 /********************************************************************************
 
@@ -283,12 +291,25 @@ static volatile overflowState_t overflowState;
 
 
 static uint8_t          rxBuf[ TWI_RX_BUFFER_SIZE ];
-static volatile uint8_t rxHead;
-static volatile uint8_t rxTail;
+static RING             rxRing;     // ISR puts, main takes.
 
 static uint8_t          txBuf[ TWI_TX_BUFFER_SIZE ];
-static volatile uint8_t txHead;
-static volatile uint8_t txTail;
+static RING             txRing;     // main puts, ISR takes.
+
+#if TWI_REPLY_STATUS == 1
+static volatile uint8_t txReady;    // txRing.head at the end of the last complete reply.
+static volatile uint8_t txSending;  // reply bytes left in this read.
+static volatile bool    txStatus;   // READY byte is next.
+#endif
+
+static volatile uint8_t twiEvents;  // TWI_EVENT_ bits.
+
+#if TWI_USE_STATS == 1
+static TWI_STATS twiStats;
+#  define TWI_COUNT(field)  ++twiStats.field
+#else
+#  define TWI_COUNT(field)
+#endif
 
 /********************************************************************************
 
@@ -302,12 +323,30 @@ flushTwiBuffers(
   void
 )
 {
-  rxTail = 0;
-  rxHead = 0;
-  txTail = 0;
-  txHead = 0;
+  ringInit( &rxRing );
+  ringInit( &txRing );
+#if TWI_REPLY_STATUS == 1
+  txReady = 0;
+#endif
+  twiEvents = 0;
 } // end flushTwiBuffers
 
+// called by the ISR after a byte is taken from the output buffer
+static inline void
+txTaken(
+  void
+)
+{
+  TWI_COUNT( txBytes );
+#ifdef TWI_TX_LOW_WATER
+  if ( ringCount( &txRing, TWI_TX_BUFFER_MASK ) == TWI_TX_LOW_WATER )
+  {
+    twiEvents |= TWI_EVENT_TX_LOW;
+    TWI_HOOK_TX_LOW( );
+  }
+#endif
+} // end txTaken
+
 
 
 /********************************************************************************
@@ -377,19 +416,8 @@ usiTwiTransmitByte(
 )
 {
 
-  uint8_t tmphead;
-
-  // calculate buffer index
-  tmphead = ( txHead + 1 ) & TWI_TX_BUFFER_MASK;
-
   // wait for free space in buffer
-  while ( tmphead == txTail );
-
-  // store data in buffer
-  txBuf[ tmphead ] = data;
-
-  // store new index
-  txHead = tmphead;
+  while ( !ringPut( &txRing, txBuf, TWI_TX_BUFFER_MASK, data ) );
 
 } // end usiTwiTransmitByte
 
@@ -404,13 +432,10 @@ usiTwiReceiveByte(
 {
 
   // wait for Rx data
-  while ( rxHead == rxTail );
-
-  // calculate buffer index
-  rxTail = ( rxTail + 1 ) & TWI_RX_BUFFER_MASK;
+  while ( ringEmpty( &rxRing ) );
 
   // return data from the buffer.
-  return rxBuf[ rxTail ];
+  return ringTake( &rxRing, rxBuf, TWI_RX_BUFFER_MASK );
 
 } // end usiTwiReceiveByte
 
@@ -425,7 +450,7 @@ usiTwiDataInReceiveBuffer(
 {
 
   // return 0 (false) if the receive buffer is empty
-  return rxHead != rxTail;
+  return !ringEmpty( &rxRing );
 
 } // end usiTwiDataInReceiveBuffer
 
@@ -437,9 +462,71 @@ bool
 usiTwiDataInTransmitBuffer( void )
 {
   // return 0 (false) if the transmit buffer is empty
-  return txHead != txTail;
+  return !ringEmpty( &txRing );
 }
 
+/*
+ * Mark everything in the output buffer as a complete reply. Call after the last
+ * usiTwiTransmitByte() of a reply. With TWI_REPLY_STATUS, the Master is told the
+ * reply is ready only after this.
+ */
+void
+usiTwiTransmitReady( void )
+{
+#if TWI_REPLY_STATUS == 1
+  ringStore( &txReady, txRing.head );
+#endif
+}
+
+// bytes in the input buffer
+uint8_t
+usiTwiRxCount( void )
+{
+  return ringCount( &rxRing, TWI_RX_BUFFER_MASK );
+}
+
+// bytes in the output buffer, ready or not
+uint8_t
+usiTwiTxCount( void )
+{
+  return ringCount( &txRing, TWI_TX_BUFFER_MASK );
+}
+
+// read and clear the TWI_EVENT_ bits. An event the ISR raises while this runs is kept.
+uint8_t
+usiTwiGetEvents( void )
+{
+  uint8_t events;
+
+  ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+  {
+    events = twiEvents;
+    twiEvents = 0;
+  }
+  return events;
+}
+
+#if TWI_USE_STATS == 1
+// copy the counts. The ISRs are held off so they are all from the same moment.
+void
+usiTwiGetStats( TWI_STATS* stats )
+{
+  ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+  {
+    *stats = twiStats;
+  }
+}
+
+void
+usiTwiClearStats( void )
+{
+  ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+  {
+    twiStats = (TWI_STATS){ 0 };
+  }
+}
+#endif
+
 /********************************************************************************
 
                             USI Start Condition ISR
@@ -529,17 +616,22 @@ Only disabled when waiting for a new Start Condition.
 
 ISR( USI_OVERFLOW_VECTOR )
 {
-
   switch ( overflowState )
   {
 
     // Address mode: check address and send ACK (and next USI_SLAVE_SEND_DATA) if OK,
     // else reset USI
     case USI_SLAVE_CHECK_ADDRESS:
-      if ( ( USIDR == 0 ) || ( ( USIDR >> 1 ) == slaveAddress) )
+      if ( ( TWI_GENERAL_CALL && ( USIDR == 0 ) ) || ( ( USIDR >> 1 ) == slaveAddress) )
       {
           if ( USIDR & 0x01 )
         {
+          TWI_HOOK_READ();
+#if TWI_REPLY_STATUS == 1
+          // READY is the number of bytes of complete replies that follow.
+          txSending = ( ringLoad( &txReady ) - txRing.tail ) & TWI_TX_BUFFER_MASK;
+          txStatus = true;
+#endif
           overflowState = USI_SLAVE_SEND_DATA;
         }
         else
@@ -570,16 +662,35 @@ ISR( USI_OVERFLOW_VECTOR )
     // next USI_SLAVE_REQUEST_REPLY_FROM_SEND_DATA
     case USI_SLAVE_SEND_DATA:
       // Get data from Buffer
-      if ( txHead != txTail )
+#if TWI_REPLY_STATUS == 1
+      if ( txStatus )
+      {
+        txStatus = false;
+        USIDR = txSending;
+      }
+      else if ( txSending != 0 )
       {
-        txTail = ( txTail + 1 ) & TWI_TX_BUFFER_MASK;
-        USIDR = txBuf[ txTail ];
+        --txSending;
+        USIDR = ringTake( &txRing, txBuf, TWI_TX_BUFFER_MASK );
+        txTaken( );
       }
+#else
+      if ( !ringEmpty( &txRing ) )
+      {
+        USIDR = ringTake( &txRing, txBuf, TWI_TX_BUFFER_MASK );
+        txTaken( );
+      }
+#endif
       else
       {
+        TWI_COUNT( txUnderrun );
+#ifdef TWI_UNDERRUN_BYTE
+        USIDR = TWI_UNDERRUN_BYTE;
+#else
         // the buffer is empty
         SET_USI_TO_TWI_START_CONDITION_MODE( );
         return;
+#endif
       } // end if
       overflowState = USI_SLAVE_REQUEST_REPLY_FROM_SEND_DATA;
       SET_USI_TO_SEND_DATA( );
@@ -602,10 +713,23 @@ ISR( USI_OVERFLOW_VECTOR )
     // copy data from USIDR and send ACK
     // next USI_SLAVE_REQUEST_DATA
     case USI_SLAVE_GET_DATA_AND_SEND_ACK:
-      // put data into buffer
-      // Not necessary, but prevents warnings
-      rxHead = ( rxHead + 1 ) & TWI_RX_BUFFER_MASK;
-      rxBuf[ rxHead ] = USIDR;
+      // put data into buffer if there is room
+      if ( ringPut( &rxRing, rxBuf, TWI_RX_BUFFER_MASK, USIDR ) )
+      {
+        TWI_COUNT( rxBytes );
+#ifdef TWI_RX_HIGH_WATER
+        if ( ringCount( &rxRing, TWI_RX_BUFFER_MASK ) == TWI_RX_HIGH_WATER )
+        {
+          twiEvents |= TWI_EVENT_RX_HIGH;
+          TWI_HOOK_RX_HIGH( );
+        }
+#endif
+      }
+      else
+      {
+        TWI_COUNT( rxOverflow );
+      }
+      TWI_HOOK_RX( USIDR );
       // next USI_SLAVE_REQUEST_DATA
       overflowState = USI_SLAVE_REQUEST_DATA;
       SET_USI_TO_SEND_ACK( );
@@ -0,0 +1,197 @@
+/********************************************************************************
+
+Header file for the USI TWI Slave driver.
+
+Created by Donald R. Blake
+donblake at worldnet.att.net
+
+Modified by Nels D. Pearson to match twiSlave.c TWI code.
+chip at gameactive.org
+
+---------------------------------------------------------------------------------
+
+Created from Atmel source files for Application Note AVR312: Using the USI Module
+as an I2C slave.
+
+This program is free software; you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation; either version 2 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+---------------------------------------------------------------------------------
+
+Change Activity:
+
+    Date       Description
+   ------      -------------
+  15 Mar 2007  Created.
+  23 Jan 2016  Added support functions used by twiSlave.c for interchangeability.(ndp)
+  29 Jan 2016  Add TxBuf[] test to support single read example. (ndp)
+  17 Oct 2026  Shared by the USI projects. Options come from usiTwiSlave_cfg.h. (ndp)
+  17 Oct 2026  FIFO watermark events and buffer counts. (ndp)
+
+---------------------------------------------------------------------------------
+
+Options. Each project has a usiTwiSlave_cfg.h in its own folder that sets the
+options it needs. Anything it does not set uses the default here.
+
+  TWI_RX_BUFFER_SIZE   input FIFO size, 2^n up to 256. Default 32.
+  TWI_TX_BUFFER_SIZE   output FIFO size, 2^n up to 256. Default 32.
+  TWI_UNDERRUN_BYTE    sent when the Master reads more than is in the output
+                       FIFO. Default not set: SDA is released and the Master
+                       reads 0xFF.
+  TWI_GENERAL_CALL     1 = also receive General Call (0x00) messages. Default 1.
+  TWI_REPLY_STATUS     1 = READY status byte first in every read. Default 0.
+  TWI_USE_STATS        1 = keep TWI_STATS counts. Default 0.
+  TWI_HOOK_RX(data)    called in the ISR for each byte received. Default none.
+  TWI_HOOK_READ()      called in the ISR on SLA+R. Default none.
+  TWI_RX_HIGH_WATER    input FIFO count that raises TWI_EVENT_RX_HIGH.
+                       Default not set.
+  TWI_TX_LOW_WATER     output FIFO count that raises TWI_EVENT_TX_LOW.
+                       Default not set.
+  TWI_HOOK_RX_HIGH()   called in the ISR when the input FIFO fills to
+                       TWI_RX_HIGH_WATER. Default none.
+  TWI_HOOK_TX_LOW()    called in the ISR when the output FIFO drains to
+                       TWI_TX_LOW_WATER. Default none.
+
+The USI has no STOP interrupt, so there is no STOP hook.
+
+The watermark events work as in twiSlave.h: each stays set until
+usiTwiGetEvents() reads it. With TWI_REPLY_STATUS a read sends its READY
+count of bytes and then only the underrun byte; data made ready during the
+read waits for the next read and its own READY count.
+
+********************************************************************************/
+
+
+
+#ifndef _USI_TWI_SLAVE_H_
+#define _USI_TWI_SLAVE_H_
+
+
+
+/********************************************************************************
+
+                                    includes
+
+********************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "usiTwiSlave_cfg.h"
+
+
+
+/********************************************************************************
+
+                                   prototypes
+
+********************************************************************************/
+
+void    usiTwiSlaveInit( uint8_t );
+void	usiTwiSlaveEnable(void);			// added ndp
+void    usiTwiTransmitByte( uint8_t );
+uint8_t usiTwiReceiveByte( void );
+bool    usiTwiDataInReceiveBuffer( void );
+bool	usiTwiDataInTransmitBuffer( void );
+void	usiTwiTransmitReady( void );		// mark the output buffer data as a complete reply.
+uint8_t usiTwiRxCount( void );          // bytes in the input buffer.
+uint8_t usiTwiTxCount( void );          // bytes in the output buffer.
+uint8_t usiTwiGetEvents( void );        // read and clear the TWI_EVENT_ bits.
+
+
+/********************************************************************************
+
+                           driver buffer definitions
+
+********************************************************************************/
+
+// permitted RX buffer sizes: 1, 2, 4, 8, 16, 32, 64, 128 or 256
+
+#ifndef TWI_RX_BUFFER_SIZE
+#  define TWI_RX_BUFFER_SIZE  ( 32 ) // jjg was 16
+#endif
+#define TWI_RX_BUFFER_MASK  ( TWI_RX_BUFFER_SIZE - 1 )
+
+#if ( TWI_RX_BUFFER_SIZE & TWI_RX_BUFFER_MASK ) || ( TWI_RX_BUFFER_SIZE > 256 )
+#  error TWI RX buffer size is not a power of 2
+#endif
+
+// permitted TX buffer sizes: 1, 2, 4, 8, 16, 32, 64, 128 or 256
+
+#ifndef TWI_TX_BUFFER_SIZE
+#  define TWI_TX_BUFFER_SIZE ( 32 ) // jjg was 16
+#endif
+#define TWI_TX_BUFFER_MASK ( TWI_TX_BUFFER_SIZE - 1 )
+
+#if ( TWI_TX_BUFFER_SIZE & TWI_TX_BUFFER_MASK ) || ( TWI_TX_BUFFER_SIZE > 256 )
+#  error TWI TX buffer size is not a power of 2
+#endif
+
+
+
+
+
+/********************************************************************************
+
+                                driver options
+
+********************************************************************************/
+
+#ifndef TWI_GENERAL_CALL
+#  define TWI_GENERAL_CALL  1
+#endif
+
+#ifndef TWI_REPLY_STATUS
+#  define TWI_REPLY_STATUS  0
+#endif
+
+#ifndef TWI_USE_STATS
+#  define TWI_USE_STATS     0
+#endif
+
+#ifndef TWI_HOOK_RX
+#  define TWI_HOOK_RX(data)
+#endif
+#ifndef TWI_HOOK_READ
+#  define TWI_HOOK_READ()
+#endif
+#ifndef TWI_HOOK_RX_HIGH
+#  define TWI_HOOK_RX_HIGH()
+#endif
+#ifndef TWI_HOOK_TX_LOW
+#  define TWI_HOOK_TX_LOW()
+#endif
+
+#if defined( TWI_RX_HIGH_WATER ) && ( TWI_RX_HIGH_WATER < 1 || TWI_RX_HIGH_WATER >= TWI_RX_BUFFER_SIZE )
+#  error TWI_RX_HIGH_WATER must be 1 to TWI_RX_BUFFER_SIZE-1
+#endif
+#if defined( TWI_TX_LOW_WATER ) && ( TWI_TX_LOW_WATER >= TWI_TX_BUFFER_SIZE - 1 )
+#  error TWI_TX_LOW_WATER must be 0 to TWI_TX_BUFFER_SIZE-2
+#endif
+
+// usiTwiGetEvents() bits
+#define TWI_EVENT_RX_HIGH   0x01  // input FIFO filled to TWI_RX_HIGH_WATER.
+#define TWI_EVENT_TX_LOW    0x02  // output FIFO drained to TWI_TX_LOW_WATER.
+
+// counts kept with TWI_USE_STATS. They wrap.
+typedef struct {
+  uint16_t  rxBytes;      // bytes put in the input buffer.
+  uint16_t  rxOverflow;   // bytes lost, input buffer full.
+  uint16_t  txBytes;      // bytes sent from the output buffer.
+  uint16_t  txUnderrun;   // reads past the end of the output buffer.
+} TWI_STATS;
+
+#if TWI_USE_STATS == 1
+void    usiTwiGetStats( TWI_STATS* stats );
+void    usiTwiClearStats( void );
+#endif
+
+
+
+#endif  // ifndef _USI_TWI_SLAVE_H_